@@ -8,7 +8,10 @@ if(DEFINED CMAKE_CXX_COMPILER_ID)
     endif()
 
     # Remove -DNDEBUG from RelWithDebInfo to enable assert() and LOG_DEBUG/LOG_TRACE.
-    set(CMAKE_CXX_FLAGS_INIT "-fPIC -Wall -std=c++14 -pedantic")
+    # HALMD does not inspect errno after math functions, and -fno-math-errno
+    # allows vectorisation of loops containing std::sqrt, e.g., in the
+    # batched evaluation of pair potentials.
+    set(CMAKE_CXX_FLAGS_INIT "-fPIC -Wall -std=c++14 -pedantic -fno-math-errno")
     set(CMAKE_CXX_FLAGS_RELEASE_INIT "-O3 -DNDEBUG -DBOOST_DISABLE_ASSERTS -fvisibility=hidden")
     set(CMAKE_CXX_FLAGS_RELWITHDEBINFO_INIT "-O2 -g")
 
@@ -24,9 +27,9 @@ if(DEFINED CMAKE_CXX_COMPILER_ID)
     # units. This paradigm conforms to the C++ standards and is intended,
     # therefore the warnings are disabled.
     if(NOT CMAKE_CXX_COMPILER_VERSION VERSION_LESS "3.9.1")
-      set(CMAKE_CXX_FLAGS_INIT "-fPIC -Wall -std=c++14 -pedantic -Wno-undefined-var-template")
+      set(CMAKE_CXX_FLAGS_INIT "-fPIC -Wall -std=c++14 -pedantic -fno-math-errno -Wno-undefined-var-template")
     else()
-      set(CMAKE_CXX_FLAGS_INIT "-fPIC -Wall -std=c++14 -pedantic")
+      set(CMAKE_CXX_FLAGS_INIT "-fPIC -Wall -std=c++14 -pedantic -fno-math-errno")
     endif()
     set(CMAKE_CXX_FLAGS_RELEASE_INIT "-O3 -DNDEBUG -DBOOST_DISABLE_ASSERTS -fvisibility=hidden")
     set(CMAKE_CXX_FLAGS_RELWITHDEBINFO_INIT "-O2 -g")
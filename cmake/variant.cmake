@@ -19,6 +19,19 @@ if(HALMD_VARIANT_HOST_SINGLE_PRECISION)
   add_definitions(-DUSE_HOST_SINGLE_PRECISION)
 endif(HALMD_VARIANT_HOST_SINGLE_PRECISION)
 
+#
+# Pad the vectors of the position, image, velocity, and force arrays of host
+# particles to a power-of-two number of elements, i.e., three-dimensional
+# vectors occupy four elements. This increases the memory footprint of these
+# arrays by a third, but allows aligned SIMD loads and stores in the
+# integrators and force loops.
+#
+set(HALMD_VARIANT_HOST_PADDED_VECTOR FALSE CACHE BOOL
+  "Use padded and aligned vector arrays for particles in host implementation")
+if(HALMD_VARIANT_HOST_PADDED_VECTOR)
+  add_definitions(-DUSE_HOST_PADDED_VECTOR)
+endif(HALMD_VARIANT_HOST_PADDED_VECTOR)
+
 if(HALMD_WITH_GPU OR HALMD_DOC_ONLY)
   set(HALMD_VARIANT_GPU_SINGLE_PRECISION FALSE CACHE BOOL
           "Enable single-precision math in gpu implementation")
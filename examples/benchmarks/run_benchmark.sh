@@ -34,7 +34,13 @@ BENCHMARK_NAME=$1
 COUNT=${2:-5}
 INPUT_FILE=${3:-"${BENCHMARK_NAME}/configuration.h5"}
 SUFFIX=${4:+_$4}
-DEVICE_NAME=${5:-$(nvidia-smi -a | sed -ne '/Product Name/{s/.*: [A-Za-z]* \(.*\)/\1/;s/ //g;p;q}')}
+if [ -z "$5" ] && command -v nvidia-smi >/dev/null
+then
+    DEVICE_NAME=$(nvidia-smi -a | sed -ne '/Product Name/{s/.*: [A-Za-z]* \(.*\)/\1/;s/ //g;p;q}')
+else
+    # fall back to the host CPU for simulations without GPU
+    DEVICE_NAME=${5:-$(sed -ne '/model name/{s/.*: \(.*\)/\1/;s/([^)]*)//g;s/ //g;p;q}' /proc/cpuinfo)}
+fi
 HALMD_OPTIONS=$6
 
 HALMD_VERSION=$(halmd --version | cut -f 5- -d ' ' | sed -e '1s/-patch.* \([a-z0-9]\+\)\]/-g\1/;q')
@@ -0,0 +1,116 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_ALGORITHM_HOST_FFT_HPP
+#define HALMD_ALGORITHM_HOST_FFT_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace halmd {
+
+/**
+ * In-place forward discrete Fourier transform
+ *
+ * @f$ X_k = \sum_{n=0}^{M-1} x_n \exp(-2\pi\textrm{i} k n / M) @f$
+ *
+ * of a contiguous sequence of complex numbers with a length M that is a
+ * power of two. The transform uses the iterative radix-2 Cooley-Tukey
+ * algorithm with a precomputed table of twiddle factors and of the
+ * bit-reversal permutation. An instance may be shared by several threads.
+ */
+template <typename float_type>
+class fft
+{
+public:
+    typedef std::complex<float_type> value_type;
+
+    explicit fft(std::size_t size)
+      : size_(size)
+    {
+        if (size == 0 || (size & (size - 1)) != 0) {
+            throw std::invalid_argument("length of Fourier transform must be a power of two");
+        }
+        twiddle_.reserve(size / 2);
+        for (std::size_t j = 0; j < size / 2; ++j) {
+            double phi = -2 * M_PI * j / size;
+            twiddle_.emplace_back(std::cos(phi), std::sin(phi));
+        }
+        for (std::size_t i = 1, j = 0; i < size; ++i) {
+            // increment bit-reversed index
+            std::size_t bit = size >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                swap_.emplace_back(i, j);
+            }
+        }
+    }
+
+    /** returns length of transform */
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /** transform sequence in place */
+    void operator()(value_type* data) const
+    {
+        for (auto const& p : swap_) {
+            std::swap(data[p.first], data[p.second]);
+        }
+        for (std::size_t len = 2; len <= size_; len <<= 1) {
+            std::size_t const half = len / 2;
+            std::size_t const step = size_ / len;
+            for (std::size_t i = 0; i < size_; i += len) {
+                value_type* a = data + i;
+                value_type* b = a + half;
+                for (std::size_t j = 0; j < half; ++j) {
+                    // complex product without the checks for infinities of std::complex
+                    value_type const& w = twiddle_[j * step];
+                    value_type t(
+                        w.real() * b[j].real() - w.imag() * b[j].imag()
+                      , w.real() * b[j].imag() + w.imag() * b[j].real()
+                    );
+                    b[j] = a[j] - t;
+                    a[j] += t;
+                }
+            }
+        }
+    }
+
+private:
+    /** length of transform */
+    std::size_t size_;
+    /** twiddle factors exp(-2πi j / M) for 0 ≤ j < M / 2 */
+    std::vector<value_type> twiddle_;
+    /** pairs of indices swapped by the bit-reversal permutation */
+    std::vector<std::pair<std::size_t, std::size_t>> swap_;
+};
+
+} // namespace halmd
+
+#endif /* ! HALMD_ALGORITHM_HOST_FFT_HPP */
@@ -23,14 +23,18 @@
 #include <boost/type_traits/has_dereference.hpp>
 #include <luaponte/luaponte.hpp>
 #include <luaponte/out_value_policy.hpp>
+#include <algorithm>
 #include <memory>
 #include <limits>
 #include <stdexcept>
 #include <stdint.h> // uint32_t, uint64_t
 #include <type_traits>
+#include <utility>
 
+#include <halmd/io/logger.hpp>
 #include <halmd/io/utility/hdf5.hpp>
 #include <halmd/io/writers/h5md/append.hpp>
+#include <halmd/io/writers/h5md/storage.hpp>
 #include <halmd/numeric/blas/fixed_vector.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/raw_array.hpp>
@@ -47,10 +51,13 @@ append::append(
     H5::Group const& root
   , vector<string> const& location
   , std::shared_ptr<clock_type const> clock
+  , std::shared_ptr<writer_thread> thread
 )
   : clock_(clock)
   , last_step_(numeric_limits<int64_t>::lowest())
   , last_time_(numeric_limits<time_type>::lowest())
+  , thread_(thread)
+  , buffer_(0)
 {
     if (location.size() < 1) {
         throw invalid_argument("group location");
@@ -62,6 +69,19 @@ append::append(
     group_.unlink("time");
 }
 
+append::~append()
+{
+    if (thread_) {
+        // pending tasks refer to the step and time datasets
+        try {
+            thread_->wait();
+        }
+        catch (std::exception const& e) {
+            LOG_ERROR("writing to H5MD file failed: " << e.what());
+        }
+    }
+}
+
 template <typename T>
 static H5::DataSet create_dataset(
     H5::Group const& group
@@ -102,36 +122,175 @@ static H5::DataSet create_dataset(
     return h5xx::create_chunked_dataset<multi_array<T, N, Alloc> >(group, name, data.shape());
 }
 
+/**
+ * Returns data of slot result, which is either the data itself or a pointer to it.
+ */
 template <typename T>
-static typename std::enable_if<boost::has_dereference<T>::type::value, void>::type
-write_dataset(
-    H5::DataSet& dataset
-  , H5::Group const& group
+static typename std::enable_if<!boost::has_dereference<T>::type::value, T const&>::type
+dereference(T const& value)
+{
+    return value;
+}
+
+template <typename T>
+static typename std::enable_if<boost::has_dereference<T>::type::value, decltype(*std::declval<T const&>())>::type
+dereference(T const& value)
+{
+    return *value;
+}
+
+/**
+ * Copy data into staging buffer, reusing the memory of the buffer.
+ */
+template <typename T>
+static void stage(T& buffer, T const& data)
+{
+    buffer = data;
+}
+
+template <typename T>
+static void stage(raw_array<T>& buffer, raw_array<T> const& data)
+{
+    buffer.resize(data.size());
+    std::copy(data.begin(), data.end(), buffer.begin());
+}
+
+template <typename T, size_t N, typename Alloc>
+static void stage(multi_array<T, N, Alloc>& buffer, multi_array<T, N, Alloc> const& data)
+{
+    buffer.resize(vector<size_t>(data.shape(), data.shape() + N));
+    buffer = data;
+}
+
+/**
+ * Time-series dataset with storage properties and staging buffers
+ *
+ * The dataset is created upon the first write, since its shape is only
+ * known from the data.
+ */
+template <typename T>
+struct time_series
+{
+    time_series(
+        H5::Group const& group
+      , string const& name
+      , std::shared_ptr<storage const> properties
+      , unsigned int nbuffer
+    )
+      : group(group)
+      , name(name)
+      , properties(properties)
+      , buffer(nbuffer)
+    {}
+
+    /** append data to dataset */
+    void write(T const& data)
+    {
+        if (properties && properties->significant_bits > 0) {
+            stage(buffer[0], data);
+            write_staged(0);
+        }
+        else {
+            append_(data);
+        }
+    }
+
+    /** append staging buffer to dataset */
+    void write_staged(unsigned int index)
+    {
+        if (properties) {
+            truncate_precision(buffer[index], *properties);
+        }
+        append_(buffer[index]);
+    }
+
+    H5::Group group;
+    string name;
+    /** storage properties, or nullptr for the defaults of h5xx */
+    std::shared_ptr<storage const> properties;
+    H5::DataSet dataset;
+    vector<T> buffer;
+
+private:
+    void append_(T const& data)
+    {
+        if (!h5xx::is_valid(dataset.getId())) {
+            if (properties) {
+                dataset = create_dataset(group, name, data, *properties);
+            }
+            else {
+                dataset = create_dataset(group, name, data);
+            }
+        }
+        h5xx::write_chunked_dataset(dataset, data);
+    }
+};
+
+template <typename T>
+append::slot_function_type append::write_(
+    H5::Group const& group
   , string const& name
   , std::function<T ()> const& slot
+  , vector<string> const& location
 )
 {
-    auto const& data = *slot();
-    if (!h5xx::is_valid(dataset.getId())) {
-        dataset = create_dataset(group, name, data);
+    typedef typename std::decay<decltype(dereference(slot()))>::type value_type;
+    auto series = std::make_shared<time_series<value_type>>(
+        group, name, storage_(location), thread_ ? thread_->nbuffer() : 1
+    );
+    if (thread_) {
+        // copy data into staging buffer, and queue task for writer thread
+        return [=]() {
+            unsigned int index = buffer_;
+            stage(series->buffer[index], dereference(slot()));
+            tasks_.push_back([=]() {
+                series->write_staged(index);
+            });
+        };
+    }
+    return [=]() {
+        series->write(dereference(slot()));
+    };
+}
+
+std::shared_ptr<storage const> append::storage_(vector<string> const& location) const
+{
+    auto it = storage_map_.find(boost::join(location, "/"));
+    if (it == storage_map_.end() && !location.empty()) {
+        // match final component of location, e.g., "position"
+        it = storage_map_.find(location.back());
     }
-    h5xx::write_chunked_dataset(dataset, data);
+    if (it == storage_map_.end()) {
+        it = storage_map_.find("");
+    }
+    return it != storage_map_.end() ? it->second : nullptr;
 }
 
-template <typename T>
-static typename std::enable_if<!boost::has_dereference<T>::type::value, void>::type
-write_dataset(
-    H5::DataSet& dataset
-  , H5::Group const& group
-  , string const& name
-  , std::function<T ()> const& slot
+void append::set_storage(
+    string const& location
+  , vector<unsigned int> const& chunk
+  , bool shuffle
+  , unsigned int deflate
+  , double tolerance
+  , unsigned int significant_bits
 )
 {
-    T data = slot();
-    if (!h5xx::is_valid(dataset.getId())) {
-        dataset = create_dataset(group, name, data);
+    if (chunk.empty() || chunk[0] == 0) {
+        throw invalid_argument("chunk shape must specify a positive number of samples");
+    }
+    if (deflate > 9) {
+        throw invalid_argument("deflate compression level must be between 0 and 9");
     }
-    h5xx::write_chunked_dataset(dataset, data);
+    if (tolerance < 0) {
+        throw invalid_argument("quantisation tolerance must be non-negative");
+    }
+    auto properties = std::make_shared<storage>();
+    properties->chunk = chunk;
+    properties->shuffle = shuffle;
+    properties->deflate = deflate;
+    properties->tolerance = tolerance;
+    properties->significant_bits = significant_bits;
+    storage_map_[location] = properties;
 }
 
 template <typename T>
@@ -147,7 +306,7 @@ connection append::on_write(
     group = h5xx::open_group(group_, boost::join(location, "/"));
     h5xx::link(step_dataset_, group, "step");
     h5xx::link(time_dataset_, group, "time");
-    return on_write_.connect(bind(&write_dataset<T>, H5::DataSet(), group, "value", slot));
+    return on_write_.connect(write_(group, "value", slot, location));
 }
 
 template <typename T>
@@ -166,11 +325,13 @@ connection append::on_write_averaged(
     h5xx::link(step_dataset_, group, "step");
     h5xx::link(time_dataset_, group, "time");
 
-    H5::DataSet value_dataset, error_dataset, count_dataset;
-    return on_write_.connect( [=]() mutable {
-        write_dataset(value_dataset, group, "value", value_slot);
-        write_dataset(error_dataset, group, "error", error_slot);
-        write_dataset(count_dataset, group, "count", count_slot);
+    slot_function_type value = write_(group, "value", value_slot, location);
+    slot_function_type error = write_(group, "error", error_slot, location);
+    slot_function_type count = write_(group, "count", count_slot, location);
+    return on_write_.connect( [=]() {
+        value();
+        error();
+        count();
     });
 }
 
@@ -187,8 +348,20 @@ connection append::on_append_write(slot_function_type const& slot)
 void append::write()
 {
     on_prepend_write_();
+    if (thread_) {
+        // block while all staging buffers are in use
+        buffer_ = thread_->acquire();
+    }
     write_step_time();
     on_write_();
+    if (thread_) {
+        thread_->submit([tasks = std::move(tasks_)]() {
+            for (auto const& task : tasks) {
+                task();
+            }
+        });
+        tasks_.clear();
+    }
     on_append_write_();
 }
 
@@ -201,8 +374,16 @@ void append::write_step_time()
                                "\nH5MD enforces a strictly increasing order.");
     }
 
-    h5xx::write_chunked_dataset(step_dataset_, step);
-    h5xx::write_chunked_dataset(time_dataset_, time);
+    if (thread_) {
+        tasks_.push_back([=]() {
+            h5xx::write_chunked_dataset(step_dataset_, step);
+            h5xx::write_chunked_dataset(time_dataset_, time);
+        });
+    }
+    else {
+        h5xx::write_chunked_dataset(step_dataset_, step);
+        h5xx::write_chunked_dataset(time_dataset_, time);
+    }
     last_step_ = step;
     last_time_ = time;
 }
@@ -238,7 +419,9 @@ void append::luaopen(lua_State* L)
                 [
                     class_<append, std::shared_ptr<append> >("append")
                         .def(constructor<H5::Group const&, vector<string> const&, std::shared_ptr<clock_type const> >())
+                        .def(constructor<H5::Group const&, vector<string> const&, std::shared_ptr<clock_type const>, std::shared_ptr<writer_thread> >())
                         .property("group", &append::group)
+                        .def("set_storage", &append::set_storage)
                         .property("write", &wrap_write)
                         .def("on_write", &append::on_write<float>, pure_out_value(_2))
                         .def("on_write", &append::on_write<float&>, pure_out_value(_2))
@@ -377,6 +560,8 @@ void append::luaopen(lua_State* L)
                         .def("on_write", &append::on_write_averaged<fixed_vector<double, 2>>, pure_out_value(_2))
                         .def("on_write", &append::on_write_averaged<fixed_vector<double, 3>>, pure_out_value(_2))
                         .def("on_write", &append::on_write_averaged<fixed_vector<double, 6>>, pure_out_value(_2))
+                        // radial_distribution_function
+                        .def("on_write", &append::on_write_averaged<multi_array<double, 2> const&>, pure_out_value(_2))
 
                         .def("on_prepend_write", &append::on_prepend_write)
                         .def("on_append_write", &append::on_append_write)
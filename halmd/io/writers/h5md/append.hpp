@@ -25,8 +25,14 @@
 #include <boost/multi_array.hpp>
 #include <functional>
 #include <lua.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <h5xx/h5xx.hpp>
+#include <halmd/io/writers/h5md/storage.hpp>
+#include <halmd/io/writers/h5md/writer_thread.hpp>
 #include <halmd/mdsim/clock.hpp>
 #include <halmd/utility/signal.hpp>
 
@@ -49,6 +55,16 @@ namespace h5md {
  * the sampler to write to the datasets at a fixed interval. Further
  * signals on_prepend_write and on_append_write are provided to call
  * arbitrary slots before and after writing.
+ *
+ * If the writer is given a background writer thread, the data slots are
+ * still invoked by write(), but their results are copied into staging
+ * buffers and written to the datasets by the writer thread. The slots
+ * connected to on_append_write may thus be called before the data are
+ * written to the file.
+ *
+ * By default, the datasets are created with the chunk layout of h5xx and
+ * without filters. The chunk shape and the filter pipeline may be chosen
+ * per dataset with set_storage().
  */
 class append
 {
@@ -76,7 +92,10 @@ public:
         H5::Group const& root
       , std::vector<std::string> const& location
       , std::shared_ptr<clock_type const> clock
+      , std::shared_ptr<writer_thread> thread = nullptr
     );
+    /** wait for pending writes */
+    ~append();
     /** connect data slot for writing dataset, return created HDF5 group by reference */
     template <typename T>
     connection on_write(
@@ -93,6 +112,22 @@ public:
       , std::function<uint64_t ()> const& count_slot
       , std::vector<std::string> const& location
     );
+    /**
+     * Set storage properties of the datasets at the given location.
+     *
+     * The location is matched against the dataset location passed to
+     * on_write(), joined by "/", or against its last component. An empty
+     * location sets the default for all datasets of the writer. The
+     * properties apply to datasets connected afterwards.
+     */
+    void set_storage(
+        std::string const& location
+      , std::vector<unsigned int> const& chunk
+      , bool shuffle
+      , unsigned int deflate
+      , double tolerance
+      , unsigned int significant_bits
+    );
     /** connect slot called before writing */
     connection on_prepend_write(slot_function_type const& slot);
     /** connect slot called after writing */
@@ -113,6 +148,16 @@ public:
 private:
     /** append shared step and time datasets */
     void write_step_time();
+    /** returns slot that appends the data to the dataset, or stages the data for the writer thread */
+    template <typename T>
+    slot_function_type write_(
+        H5::Group const& group
+      , std::string const& name
+      , std::function<T ()> const& slot
+      , std::vector<std::string> const& location
+    );
+    /** returns storage properties of dataset location, or nullptr for the defaults */
+    std::shared_ptr<storage const> storage_(std::vector<std::string> const& location) const;
 
     /** writer group */
     H5::Group group_;
@@ -132,6 +177,14 @@ private:
     int64_t last_step_;
     /** last simulation time written */
     time_type last_time_;
+    /** background writer thread, or nullptr for synchronous writing */
+    std::shared_ptr<writer_thread> thread_;
+    /** index of staging buffer for the current write */
+    unsigned int buffer_;
+    /** write tasks for the staged datasets of the current write */
+    std::vector<writer_thread::task_type> tasks_;
+    /** storage properties by dataset location */
+    std::map<std::string, std::shared_ptr<storage const>> storage_map_;
 };
 
 } // namespace h5md
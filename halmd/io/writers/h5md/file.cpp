@@ -38,7 +38,7 @@ namespace io {
 namespace writers {
 namespace h5md {
 
-file::file(string const& path, string const& author_name, string const& author_email, bool overwrite)
+file::file(string const& path, string const& author_name, string const& author_email, bool overwrite, bool async)
 {
     if (boost::filesystem::exists(path)) {
         if (overwrite) {
@@ -65,16 +65,46 @@ file::file(string const& path, string const& author_name, string const& author_e
     }
 
     LOG("write to H5MD file: " << absolute_path(file_.getFileName()));
+
+    if (async) {
+        hbool_t threadsafe = false;
+        H5is_library_threadsafe(&threadsafe);
+        if (threadsafe) {
+            thread_ = std::make_shared<writer_thread>();
+            LOG("write time series asynchronously");
+        }
+        else {
+            LOG_WARNING("HDF5 library is not thread-safe, write to H5MD file synchronously");
+        }
+    }
+}
+
+file::~file()
+{
+    if (thread_) {
+        try {
+            thread_->wait();
+        }
+        catch (std::exception const& e) {
+            LOG_ERROR("writing to H5MD file failed: " << e.what());
+        }
+    }
 }
 
 void file::flush()
 {
+    if (thread_) {
+        thread_->wait();
+    }
     LOG("flush H5MD file: " << absolute_path(file_.getFileName()));
     file_.flush(H5F_SCOPE_GLOBAL);
 }
 
 void file::close()
 {
+    if (thread_) {
+        thread_->wait();
+    }
     file_.close();
 }
 
@@ -105,12 +135,14 @@ void file::luaopen(lua_State* L)
             [
                 namespace_("h5md")
                 [
-                    class_<file, std::shared_ptr<file> >("file")
-                        .def(constructor<string const&, string const&, string const&, bool>())
+                    class_<writer_thread, std::shared_ptr<writer_thread> >("writer_thread")
+                  , class_<file, std::shared_ptr<file> >("file")
+                        .def(constructor<string const&, string const&, string const&, bool, bool>())
                         .def("flush", &file::flush)
                         .def("close", &file::close)
                         .property("root", &file::root)
                         .property("path", &file::path)
+                        .property("thread", &file::thread)
                         .scope
                         [
                             def("version", &file::version)
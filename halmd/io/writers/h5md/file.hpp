@@ -25,8 +25,11 @@
 #include <boost/array.hpp>
 #include <h5xx/h5xx.hpp>
 #include <lua.hpp>
+#include <memory>
 #include <string>
 
+#include <halmd/io/writers/h5md/writer_thread.hpp>
+
 namespace halmd {
 namespace io {
 namespace writers {
@@ -37,6 +40,12 @@ namespace h5md {
  *
  * This class provides a common base for all H5MD file writers.
  * It creates the H5MD file and writes the H5MD metadata.
+ *
+ * In asynchronous mode, the file owns a background thread, which is used by
+ * the append writers to write time series without blocking the simulation.
+ * flush() and close() wait for all pending writes to complete. Asynchronous
+ * writing requires a thread-safe build of the HDF5 library, otherwise the
+ * file falls back to synchronous writing.
  */
 class file
 {
@@ -56,7 +65,10 @@ public:
       , std::string const& author_name = ""
       , std::string const& author_email = ""
       , bool overwrite = false
+      , bool async = false
     );
+    /** wait for pending writes */
+    ~file();
 
     /** flush file to disk */
     void flush();
@@ -67,6 +79,14 @@ public:
     /** get file pathname */
     std::string path() const;
 
+    /**
+     * returns background writer thread, or nullptr in synchronous mode
+     */
+    std::shared_ptr<writer_thread> const& thread() const
+    {
+        return thread_;
+    }
+
     /** get H5MD file version */
     static version_type version();
 
@@ -76,6 +96,8 @@ public:
 private:
     /** H5MD file */
     H5::H5File file_;
+    /** background writer thread */
+    std::shared_ptr<writer_thread> thread_;
 };
 
 } // namespace h5md
@@ -0,0 +1,355 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_IO_WRITERS_H5MD_STORAGE_HPP
+#define HALMD_IO_WRITERS_H5MD_STORAGE_HPP
+
+#include <boost/array.hpp>
+#include <boost/multi_array.hpp>
+#include <h5xx/h5xx.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/utility/raw_array.hpp>
+
+namespace halmd {
+namespace io {
+namespace writers {
+namespace h5md {
+
+/**
+ * Storage properties of a time-series dataset
+ *
+ * The chunk shape comprises the number of samples per chunk, followed by
+ * the chunk extents of the sample dimensions. Missing extents default to
+ * the full extent of the sample.
+ *
+ * The filter pipeline consists of the optional lossy filters, followed by
+ * the byte shuffle and the deflate filters. Floating-point data may be
+ * quantised to an absolute tolerance with the HDF5 scale-offset filter, or
+ * rounded to a given number of significant bits of the mantissa, which
+ * leaves the data in the native format, but improves the compression
+ * ratio of the deflate filter. All filters are decoded transparently by
+ * the HDF5 library upon reading.
+ */
+struct storage
+{
+    storage()
+      : chunk({1})
+      , shuffle(false)
+      , deflate(0)
+      , tolerance(0)
+      , significant_bits(0)
+    {}
+
+    /** chunk shape, starting with the number of samples per chunk */
+    std::vector<unsigned int> chunk;
+    /** enable byte shuffle filter */
+    bool shuffle;
+    /** deflate compression level from 1 to 9, or 0 to disable compression */
+    unsigned int deflate;
+    /** absolute tolerance for quantisation of floating-point data, or 0 */
+    double tolerance;
+    /** number of significant mantissa bits of floating-point data, or 0 */
+    unsigned int significant_bits;
+};
+
+namespace detail {
+
+/**
+ * Scalar type and extents of a sample element
+ */
+template <typename T>
+struct element_traits
+{
+    static_assert(std::is_arithmetic<T>::value, "unsupported element type");
+    typedef T scalar_type;
+
+    static void extents(std::vector<hsize_t>&) {}
+};
+
+template <typename T, size_t N>
+struct element_traits<numeric::blas::detail::fixed_vector<T, N> >
+{
+    typedef typename element_traits<T>::scalar_type scalar_type;
+
+    static void extents(std::vector<hsize_t>& dims)
+    {
+        dims.push_back(N);
+        element_traits<T>::extents(dims);
+    }
+};
+
+template <typename T, size_t N>
+struct element_traits<boost::array<T, N> >
+{
+    typedef typename element_traits<T>::scalar_type scalar_type;
+
+    static void extents(std::vector<hsize_t>& dims)
+    {
+        dims.push_back(N);
+        element_traits<T>::extents(dims);
+    }
+};
+
+/**
+ * Sample type and shape of a dataset, excluding the time dimension
+ */
+template <typename T>
+struct sample_traits
+{
+    typedef typename element_traits<T>::scalar_type scalar_type;
+
+    static std::vector<hsize_t> shape(T const&)
+    {
+        std::vector<hsize_t> dims;
+        element_traits<T>::extents(dims);
+        return dims;
+    }
+};
+
+template <typename T, typename Alloc>
+struct sample_traits<std::vector<T, Alloc> >
+{
+    typedef typename element_traits<T>::scalar_type scalar_type;
+
+    static std::vector<hsize_t> shape(std::vector<T, Alloc> const& data)
+    {
+        std::vector<hsize_t> dims(1, data.size());
+        element_traits<T>::extents(dims);
+        return dims;
+    }
+};
+
+template <typename T>
+struct sample_traits<raw_array<T> >
+{
+    typedef typename element_traits<T>::scalar_type scalar_type;
+
+    static std::vector<hsize_t> shape(raw_array<T> const& data)
+    {
+        std::vector<hsize_t> dims(1, data.size());
+        element_traits<T>::extents(dims);
+        return dims;
+    }
+};
+
+template <typename T, size_t N, typename Alloc>
+struct sample_traits<boost::multi_array<T, N, Alloc> >
+{
+    typedef typename element_traits<T>::scalar_type scalar_type;
+
+    static std::vector<hsize_t> shape(boost::multi_array<T, N, Alloc> const& data)
+    {
+        std::vector<hsize_t> dims(data.shape(), data.shape() + N);
+        element_traits<T>::extents(dims);
+        return dims;
+    }
+};
+
+/** returns HDF5 datatype of scalar type */
+inline H5::PredType const& native_type(float)              { return H5::PredType::NATIVE_FLOAT; }
+inline H5::PredType const& native_type(double)             { return H5::PredType::NATIVE_DOUBLE; }
+inline H5::PredType const& native_type(std::int32_t)       { return H5::PredType::NATIVE_INT32; }
+inline H5::PredType const& native_type(std::uint32_t)      { return H5::PredType::NATIVE_UINT32; }
+inline H5::PredType const& native_type(std::int64_t)       { return H5::PredType::NATIVE_INT64; }
+inline H5::PredType const& native_type(std::uint64_t)      { return H5::PredType::NATIVE_UINT64; }
+
+/**
+ * Round floating-point values to the given number of significant mantissa
+ * bits, with ties rounded away from zero. Finite values that would round to
+ * infinity are clamped to the largest finite value of the same sign. Integer
+ * values are not modified.
+ */
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value>::type
+round_mantissa(T*, T*, unsigned int)
+{}
+
+template <typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value>::type
+round_mantissa(T* first, T* last, unsigned int bits)
+{
+    typedef typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type uint_type;
+    unsigned int const digits = std::numeric_limits<T>::digits - 1;
+    if (bits >= digits) {
+        return;
+    }
+    uint_type const discard = digits - bits;
+    uint_type const half = uint_type(1) << (discard - 1);
+    uint_type const mask = ~((uint_type(1) << discard) - 1);
+    for (T* x = first; x != last; ++x) {
+        if (!std::isfinite(*x)) {
+            continue;
+        }
+        uint_type u;
+        std::memcpy(&u, x, sizeof(T));
+        // a carry into the exponent yields the correctly rounded power of two
+        u = (u + half) & mask;
+        T y;
+        std::memcpy(&y, &u, sizeof(T));
+        *x = std::isinf(y) ? std::copysign(std::numeric_limits<T>::max(), *x) : y;
+    }
+}
+
+/** returns pointers to the scalars of a contiguous sample */
+template <typename T>
+inline std::pair<T*, T*> scalars(T& data)
+{
+    return std::make_pair(&data, &data + 1);
+}
+
+template <typename T, size_t N>
+inline std::pair<typename element_traits<T>::scalar_type*, typename element_traits<T>::scalar_type*>
+scalars(numeric::blas::detail::fixed_vector<T, N>& data)
+{
+    typedef typename element_traits<T>::scalar_type scalar_type;
+    scalar_type* first = reinterpret_cast<scalar_type*>(&data[0]);
+    return std::make_pair(first, first + sizeof(data) / sizeof(scalar_type));
+}
+
+template <typename T, size_t N>
+inline std::pair<typename element_traits<T>::scalar_type*, typename element_traits<T>::scalar_type*>
+scalars(boost::array<T, N>& data)
+{
+    typedef typename element_traits<T>::scalar_type scalar_type;
+    scalar_type* first = reinterpret_cast<scalar_type*>(data.data());
+    return std::make_pair(first, first + sizeof(data) / sizeof(scalar_type));
+}
+
+template <typename Container>
+inline std::pair<typename sample_traits<Container>::scalar_type*, typename sample_traits<Container>::scalar_type*>
+container_scalars(Container& data)
+{
+    typedef typename sample_traits<Container>::scalar_type scalar_type;
+    if (data.size() == 0) {
+        return std::make_pair(nullptr, nullptr);
+    }
+    scalar_type* first = reinterpret_cast<scalar_type*>(&*data.begin());
+    return std::make_pair(first, first + data.size() * sizeof(*data.begin()) / sizeof(scalar_type));
+}
+
+template <typename T, typename Alloc>
+inline std::pair<typename element_traits<T>::scalar_type*, typename element_traits<T>::scalar_type*>
+scalars(std::vector<T, Alloc>& data)
+{
+    return container_scalars(data);
+}
+
+template <typename T>
+inline std::pair<typename element_traits<T>::scalar_type*, typename element_traits<T>::scalar_type*>
+scalars(raw_array<T>& data)
+{
+    return container_scalars(data);
+}
+
+template <typename T, size_t N, typename Alloc>
+inline std::pair<typename element_traits<T>::scalar_type*, typename element_traits<T>::scalar_type*>
+scalars(boost::multi_array<T, N, Alloc>& data)
+{
+    typedef typename element_traits<T>::scalar_type scalar_type;
+    scalar_type* first = reinterpret_cast<scalar_type*>(data.data());
+    return std::make_pair(first, first + data.num_elements() * sizeof(T) / sizeof(scalar_type));
+}
+
+} // namespace detail
+
+/**
+ * Create extensible time-series dataset with given storage properties.
+ */
+template <typename T>
+H5::DataSet create_dataset(
+    H5::Group const& group
+  , std::string const& name
+  , T const& data
+  , storage const& properties
+)
+{
+    typedef typename detail::sample_traits<T>::scalar_type scalar_type;
+
+    std::vector<hsize_t> shape = detail::sample_traits<T>::shape(data);
+    unsigned int const rank = shape.size() + 1;
+    std::vector<hsize_t> dims(rank), max_dims(rank), chunk(rank);
+    dims[0] = 0;
+    max_dims[0] = H5S_UNLIMITED;
+    chunk[0] = std::max(properties.chunk.empty() ? 1u : properties.chunk[0], 1u);
+    for (unsigned int i = 1; i < rank; ++i) {
+        dims[i] = max_dims[i] = shape[i - 1];
+        chunk[i] = shape[i - 1];
+        if (i < properties.chunk.size() && properties.chunk[i] > 0) {
+            chunk[i] = std::min<hsize_t>(properties.chunk[i], chunk[i]);
+        }
+        // chunk extents must be positive
+        chunk[i] = std::max<hsize_t>(chunk[i], 1);
+    }
+    H5::DataSpace dataspace(rank, dims.data(), max_dims.data());
+
+    H5::DSetCreatPropList plist;
+    plist.setChunk(rank, chunk.data());
+    if (properties.tolerance > 0 && std::is_floating_point<scalar_type>::value) {
+        if (!H5Zfilter_avail(H5Z_FILTER_SCALEOFFSET)) {
+            throw std::runtime_error("HDF5 scale-offset filter is not available");
+        }
+        // rounding to D decimal digits yields an absolute error of 10^(-D) / 2
+        int digits = std::ceil(-std::log10(2 * properties.tolerance));
+        if (H5Pset_scaleoffset(plist.getId(), H5Z_SO_FLOAT_DSCALE, digits) < 0) {
+            throw H5::PropListIException("DSetCreatPropList::setScaleoffset", "H5Pset_scaleoffset failed");
+        }
+    }
+    if (properties.shuffle) {
+        plist.setShuffle();
+    }
+    if (properties.deflate > 0) {
+        if (!H5Zfilter_avail(H5Z_FILTER_DEFLATE)) {
+            throw std::runtime_error("HDF5 deflate filter is not available");
+        }
+        plist.setDeflate(std::min(properties.deflate, 9u));
+    }
+    return group.createDataSet(name, detail::native_type(scalar_type()), dataspace, plist);
+}
+
+/**
+ * Round floating-point data to the number of significant bits of the storage
+ * properties.
+ */
+template <typename T>
+void truncate_precision(T& data, storage const& properties)
+{
+    if (properties.significant_bits > 0) {
+        auto range = detail::scalars(data);
+        detail::round_mantissa(range.first, range.second, properties.significant_bits);
+    }
+}
+
+} // namespace h5md
+} // namespace writers
+} // namespace io
+} // namespace halmd
+
+#endif /* ! HALMD_IO_WRITERS_H5MD_STORAGE_HPP */
@@ -0,0 +1,122 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/io/writers/h5md/writer_thread.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+namespace halmd {
+namespace io {
+namespace writers {
+namespace h5md {
+
+writer_thread::writer_thread(unsigned int nbuffer)
+  : nbuffer_(nbuffer)
+  , nsubmit_(0)
+  , shutdown_(false)
+{
+    if (nbuffer_ < 1) {
+        throw std::invalid_argument("writer thread requires at least one staging buffer");
+    }
+    thread_ = std::thread(&writer_thread::work_, this);
+}
+
+writer_thread::~writer_thread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+unsigned int writer_thread::acquire()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&]() { return queue_.size() < nbuffer_ || exception_; });
+    rethrow_();
+    return nsubmit_ % nbuffer_;
+}
+
+void writer_thread::submit(task_type task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= nbuffer_) {
+            throw std::logic_error("task submitted to writer thread without free staging buffer");
+        }
+        queue_.push_back(std::move(task));
+        ++nsubmit_;
+    }
+    wake_.notify_one();
+}
+
+void writer_thread::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&]() { return queue_.empty(); });
+    rethrow_();
+}
+
+void writer_thread::rethrow_()
+{
+    if (exception_) {
+        std::exception_ptr exception = exception_;
+        exception_ = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void writer_thread::work_()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&]() { return shutdown_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            // shutdown after all pending tasks have completed
+            return;
+        }
+        // keep task in queue while executing, to account for its buffer
+        task_type& task = queue_.front();
+        lock.unlock();
+        std::exception_ptr exception;
+        try {
+            task();
+        }
+        catch (...) {
+            exception = std::current_exception();
+        }
+        lock.lock();
+        queue_.pop_front();
+        if (exception) {
+            // discard the remaining tasks, which may depend on the failed one
+            queue_.clear();
+            exception_ = exception;
+        }
+        done_.notify_all();
+    }
+}
+
+} // namespace h5md
+} // namespace writers
+} // namespace io
+} // namespace halmd
@@ -0,0 +1,119 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_IO_WRITERS_H5MD_WRITER_THREAD_HPP
+#define HALMD_IO_WRITERS_H5MD_WRITER_THREAD_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace halmd {
+namespace io {
+namespace writers {
+namespace h5md {
+
+/**
+ * Background thread for writing to an H5MD file
+ *
+ * The thread executes write tasks in the order of submission. A writer
+ * copies its data into one of nbuffer() staging buffers before submitting a
+ * task that writes from this buffer, so that the simulation may proceed
+ * while the data are written.
+ *
+ * The number of outstanding tasks is bounded by the number of staging
+ * buffers: acquire() blocks until the task that last used the returned
+ * buffer has completed. As tasks complete in order, a buffer index is
+ * thus safe to overwrite once acquire() returns.
+ *
+ * An exception thrown by a task is rethrown by the next call of acquire()
+ * or wait() in the submitting thread. All subsequent tasks are discarded.
+ */
+class writer_thread
+{
+public:
+    typedef std::function<void ()> task_type;
+
+    /** start thread with given number of staging buffers */
+    explicit writer_thread(unsigned int nbuffer = 2);
+    /** complete pending tasks and join thread */
+    ~writer_thread();
+
+    writer_thread(writer_thread const&) = delete;
+    writer_thread& operator=(writer_thread const&) = delete;
+
+    /**
+     * Wait for a free staging buffer and return its index.
+     *
+     * The next task submitted must write from this buffer.
+     */
+    unsigned int acquire();
+
+    /**
+     * Enqueue task that writes from the buffer returned by acquire().
+     */
+    void submit(task_type task);
+
+    /**
+     * Wait for completion of all submitted tasks.
+     */
+    void wait();
+
+    /** returns number of staging buffers */
+    unsigned int nbuffer() const
+    {
+        return nbuffer_;
+    }
+
+private:
+    /** main loop of the thread */
+    void work_();
+    /** rethrow and clear exception of a failed task, if any */
+    void rethrow_();
+
+    /** number of staging buffers */
+    unsigned int nbuffer_;
+    /** guards the following members */
+    std::mutex mutex_;
+    /** notifies the thread of a new task or of shutdown */
+    std::condition_variable wake_;
+    /** notifies the submitting thread of a completed task */
+    std::condition_variable done_;
+    /** queue of submitted tasks, the front task is being executed */
+    std::deque<task_type> queue_;
+    /** number of submitted tasks */
+    unsigned long nsubmit_;
+    /** flag that the thread shall exit */
+    bool shutdown_;
+    /** exception thrown by a task */
+    std::exception_ptr exception_;
+    /** writer thread, started last */
+    std::thread thread_;
+};
+
+} // namespace h5md
+} // namespace writers
+} // namespace io
+} // namespace halmd
+
+#endif /* ! HALMD_IO_WRITERS_H5MD_WRITER_THREAD_HPP */
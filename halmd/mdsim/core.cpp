@@ -62,6 +62,51 @@ void core::mdstep()
     }
 }
 
+/**
+ * Perform multiple MD integration steps
+ */
+void core::mdstep(std::size_t nstep, std::function<void ()> const& advance)
+{
+    // reset counter of remaining steps also if a slot throws
+    struct reset_remaining_steps
+    {
+        std::size_t& value;
+        ~reset_remaining_steps() { value = 0; }
+    } reset{remaining_steps_};
+
+    if (!compiled_) {
+        for (std::size_t i = 0; i < nstep; ++i) {
+            advance();
+            remaining_steps_ = nstep - i - 1;
+            mdstep();
+        }
+        return;
+    }
+
+    scoped_timer_type timer(runtime_.batch);
+
+    std::vector<slot_function_type> const slots = compile_();
+    for (std::size_t i = 0; i < nstep; ++i) {
+        advance();
+        remaining_steps_ = nstep - i - 1;
+        for (slot_function_type const& slot : slots) {
+            slot();
+        }
+    }
+}
+
+std::vector<core::slot_function_type> core::compile_() const
+{
+    std::vector<slot_function_type> slots;
+    for (signal_type const* stage : {
+        &on_prepend_integrate_, &on_integrate_, &on_append_integrate_
+      , &on_prepend_finalize_, &on_finalize_, &on_append_finalize_
+    }) {
+        slots.insert(slots.end(), stage->begin(), stage->end());
+    }
+    return slots;
+}
+
 void core::luaopen(lua_State* L)
 {
     using namespace luaponte;
@@ -71,7 +116,9 @@ void core::luaopen(lua_State* L)
         [
             class_<core, std::shared_ptr<core> >("core")
                 .def(constructor<>())
-                .def("mdstep", &core::mdstep)
+                .def("mdstep", static_cast<void (core::*)()>(&core::mdstep))
+                .property("compiled", &core::compiled, &core::set_compiled)
+                .property("remaining_steps", &core::remaining_steps)
                 .def("on_prepend_integrate", &core::on_prepend_integrate)
                 .def("on_integrate", &core::on_integrate)
                 .def("on_append_integrate", &core::on_append_integrate)
@@ -88,6 +135,7 @@ void core::luaopen(lua_State* L)
                         .def_readonly("on_prepend_finalize", &runtime::on_prepend_finalize)
                         .def_readonly("on_finalize", &runtime::on_finalize)
                         .def_readonly("on_append_finalize", &runtime::on_append_finalize)
+                        .def_readonly("batch", &runtime::batch)
                 ]
                 .def_readonly("runtime", &core::runtime_)
         ]
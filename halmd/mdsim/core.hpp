@@ -24,6 +24,10 @@
 #include <halmd/utility/profiler.hpp>
 #include <halmd/utility/signal.hpp>
 
+#include <cstddef>
+#include <functional>
+#include <vector>
+
 /** HAL’s MD package */
 namespace halmd {
 /** Molecular Dynamics simulation modules */
@@ -35,8 +39,47 @@ public:
     typedef halmd::signal<void ()> signal_type;
     typedef signal_type::slot_function_type slot_function_type;
 
+    core() : compiled_(false), remaining_steps_(0) {}
+
     void mdstep();
 
+    /**
+     * Perform given number of MD integration steps, each preceded by a call
+     * of `advance`.
+     *
+     * In compiled mode, the slots connected to the six stages are collected
+     * into a single call list before the first step, and the steps are
+     * performed without emitting the signals and without per-stage
+     * profiling; the runtime of the whole batch is accumulated instead.
+     * Slots connected or disconnected during the batch take effect with the
+     * next call. Otherwise, mdstep() is invoked for each step.
+     */
+    void mdstep(std::size_t nstep, std::function<void ()> const& advance);
+
+    /**
+     * Returns number of steps of the current batch that follow the current
+     * step without interruption, or zero outside of a batch.
+     *
+     * An integrator may defer work of the final stage to the next step if
+     * this number is non-zero, since no observable is sampled in between.
+     */
+    std::size_t remaining_steps() const
+    {
+        return remaining_steps_;
+    }
+
+    /** returns true if multiple steps are performed in compiled mode */
+    bool compiled() const
+    {
+        return compiled_;
+    }
+
+    /** enable or disable compiled mode */
+    void set_compiled(bool compiled)
+    {
+        compiled_ = compiled;
+    }
+
     connection on_prepend_integrate(slot_function_type const& slot)
     {
         return on_prepend_integrate_.connect(slot);
@@ -83,14 +126,22 @@ private:
         accumulator_type on_prepend_finalize;
         accumulator_type on_finalize;
         accumulator_type on_append_finalize;
+        accumulator_type batch;
    };
 
+    /** collect slots of all stages in order of invocation */
+    std::vector<slot_function_type> compile_() const;
+
     signal_type on_prepend_integrate_;
     signal_type on_integrate_;
     signal_type on_append_integrate_;
     signal_type on_prepend_finalize_;
     signal_type on_finalize_;
     signal_type on_append_finalize_;
+    /** flag for compiled mode of multiple steps */
+    bool compiled_;
+    /** number of steps of the current batch following the current step */
+    std::size_t remaining_steps_;
     runtime runtime_;
 };
 
@@ -52,6 +52,30 @@ float_type cuboid<dimension, float_type>::volume() const
     return std::accumulate(edge_length_.begin(), edge_length_.end(), float_type(1), std::multiplies<float_type>());
 }
 
+template <int dimension, typename float_type>
+bool cuboid<dimension, float_type>::contains(vector_type const& lower, vector_type const& upper) const
+{
+    vector_type const upper_corner = lowest_corner_ + edge_length_;
+    for (int i = 0; i < dimension; ++i) {
+        if (lower[i] < lowest_corner_[i] || upper[i] > upper_corner[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int dimension, typename float_type>
+bool cuboid<dimension, float_type>::overlaps(vector_type const& lower, vector_type const& upper) const
+{
+    vector_type const upper_corner = lowest_corner_ + edge_length_;
+    for (int i = 0; i < dimension; ++i) {
+        if (upper[i] < lowest_corner_[i] || lower[i] > upper_corner[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 template <int dimension, typename float_type>
 void cuboid<dimension, float_type>::luaopen(lua_State* L)
 {
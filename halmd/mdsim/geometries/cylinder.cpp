@@ -24,6 +24,7 @@
 #include <halmd/utility/demangle.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 
@@ -63,6 +64,37 @@ float_type cylinder<dimension, float_type>::volume() const
     return float_type(M_PI) * radius2_ * sqrt(4 * length2_4_);
 }
 
+template <int dimension, typename float_type>
+bool cylinder<dimension, float_type>::contains(vector_type const& lower, vector_type const& upper) const
+{
+    // the cylinder is convex, thus the box is inside if all of its corners are
+    for (unsigned int corner = 0; corner < (1u << dimension); ++corner) {
+        vector_type r;
+        for (int i = 0; i < dimension; ++i) {
+            r[i] = (corner & (1u << i)) ? upper[i] : lower[i];
+        }
+        if (!(*this)(r)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int dimension, typename float_type>
+bool cylinder<dimension, float_type>::overlaps(vector_type const& lower, vector_type const& upper) const
+{
+    // compare the distance of the box centre to the cylinder with the
+    // radius of the circumscribed sphere of the box
+    vector_type const half = (upper - lower) / 2;
+    vector_type const dr = lower + half - centre_;
+    float_type dr2 = inner_prod(dr, dr);
+    float_type par = inner_prod(axis_, dr);
+    float_type perp = sqrt(std::max(dr2 - par * par, float_type(0)));
+    float_type d_perp = std::max(perp - sqrt(radius2_), float_type(0));
+    float_type d_par = std::max(std::abs(par) - sqrt(length2_4_), float_type(0));
+    return d_perp * d_perp + d_par * d_par <= inner_prod(half, half);
+}
+
 template <int dimension, typename float_type>
 void cylinder<dimension, float_type>::luaopen(lua_State* L)
 {
@@ -60,6 +60,19 @@ public:
      */
     float_type volume() const;
 
+    /**
+     * returns true if the box spanned by the given lower and upper corners
+     * lies entirely within the geometry
+     */
+    bool contains(vector_type const& lower, vector_type const& upper) const;
+
+    /**
+     * returns true if the box spanned by the given lower and upper corners
+     * intersects the geometry, the test may be conservative and return true
+     * for a box close to the geometry
+     */
+    bool overlaps(vector_type const& lower, vector_type const& upper) const;
+
     /**
      * Bind class to Lua
      */
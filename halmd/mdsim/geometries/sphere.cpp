@@ -25,6 +25,7 @@
 #include <halmd/utility/demangle.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <string>
@@ -54,6 +55,30 @@ float_type sphere<dimension, float_type>::volume() const
     return 4 * float_type(M_PI) / 3 * std::pow(radius_, 3);
 }
 
+template <int dimension, typename float_type>
+bool sphere<dimension, float_type>::contains(vector_type const& lower, vector_type const& upper) const
+{
+    // the corner farthest from the centre must be inside
+    float_type dr2 = 0;
+    for (int i = 0; i < dimension; ++i) {
+        float_type dr = std::max(std::abs(lower[i] - centre_[i]), std::abs(upper[i] - centre_[i]));
+        dr2 += dr * dr;
+    }
+    return dr2 <= radius2_;
+}
+
+template <int dimension, typename float_type>
+bool sphere<dimension, float_type>::overlaps(vector_type const& lower, vector_type const& upper) const
+{
+    // the point of the box closest to the centre must be inside
+    float_type dr2 = 0;
+    for (int i = 0; i < dimension; ++i) {
+        float_type dr = std::max(std::max(lower[i] - centre_[i], centre_[i] - upper[i]), float_type(0));
+        dr2 += dr * dr;
+    }
+    return dr2 <= radius2_;
+}
+
 template <int dimension, typename float_type>
 void sphere<dimension, float_type>::luaopen(lua_State* L)
 {
@@ -321,6 +321,15 @@ public:
      */
     void aux_enable();
 
+    /**
+     * Disable computation of auxiliary variables upon the next trigger of
+     * on_force_(), unless they are read.
+     */
+    void aux_disable()
+    {
+        aux_enabled_ = false;
+    }
+
     /**
      * Returns true if computation of auxiliary variables is enabled.
      */
@@ -44,10 +44,12 @@ binning<dimension, float_type>::binning(
   , std::shared_ptr<box_type const> box
   , matrix_type const& r_cut
   , float_type skin
+  , std::shared_ptr<thread_pool_type> thread_pool
   , std::shared_ptr<logger> logger
 )
   // dependency injection
   : particle_(particle)
+  , thread_pool_(thread_pool)
   , logger_(logger)
   // allocate parameters
   , r_skin_(skin)
@@ -99,20 +101,56 @@ void binning<dimension, float_type>::update()
 
     scoped_timer_type timer(runtime_.update);
 
-    // empty cell lists without memory reallocation
-    std::for_each(
-        cell->data()
-      , cell->data() + cell->num_elements()
-      , [](cell_list& cell) {
-            cell.clear();
+    std::size_t const ncell = cell->num_elements();
+    unsigned int const nthread = thread_pool_->size();
+    index_.resize(nparticle);
+    cell_index_.resize(nparticle);
+    count_.resize(nthread * ncell);
+
+    // count particles per cell for each block of particles
+    thread_pool_->parallel_for(0, nparticle, [&](unsigned int thread, size_type first, size_type last) {
+        unsigned int* count = &count_[thread * ncell];
+        std::fill(count, count + ncell, 0);
+        for (size_type i = first; i < last; ++i) {
+            vector_type const& r = position[i];
+            cell_size_type index = element_mod(static_cast<cell_size_type>(element_div(r, cell_length_) + static_cast<vector_type>(ncell_)), ncell_);
+            // linear index in row-major storage order of cell array
+            std::size_t c = index[0];
+            for (int j = 1; j < dimension; ++j) {
+                c = c * ncell_[j] + index[j];
+            }
+            cell_index_[i] = c;
+            ++count[c];
         }
-    );
-    // add particles to cells
-    for (size_type i = 0; i < nparticle; ++i) {
-        vector_type const& r = position[i];
-        cell_size_type index = element_mod(static_cast<cell_size_type>(element_div(r, cell_length_) + static_cast<vector_type>(ncell_)), ncell_);
-        (*cell)(index).push_back(i);
+    });
+
+    // convert counts to offsets by an exclusive prefix sum over cells and,
+    // within each cell, over blocks of particles
+    unsigned int offset = 0;
+    for (std::size_t c = 0; c < ncell; ++c) {
+        for (unsigned int thread = 0; thread < nthread; ++thread) {
+            unsigned int& count = count_[thread * ncell + c];
+            unsigned int n = count;
+            count = offset;
+            offset += n;
+        }
+    }
+
+    // assign ranges of sorted particle indices to cells
+    unsigned int const* index = index_.data();
+    cell_list* cell_data = cell->data();
+    for (std::size_t c = 0; c < ncell; ++c) {
+        unsigned int last = (c + 1 < ncell) ? count_[c + 1] : nparticle;
+        cell_data[c] = cell_list(index + count_[c], index + last);
     }
+
+    // scatter particle indices to cells
+    thread_pool_->parallel_for(0, nparticle, [&](unsigned int thread, size_type first, size_type last) {
+        unsigned int* offset = &count_[thread * ncell];
+        for (size_type i = first; i < last; ++i) {
+            index_[offset[cell_index_[i]]++] = i;
+        }
+    });
 }
 
 template <int dimension, typename float_type>
@@ -136,6 +174,7 @@ void binning<dimension, float_type>::luaopen(lua_State* L)
                   , std::shared_ptr<box_type const>
                   , matrix_type const&
                   , float_type
+                  , std::shared_ptr<thread_pool_type>
                   , std::shared_ptr<logger>
               >)
         ]
@@ -27,9 +27,11 @@
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/utility/cache.hpp>
 #include <halmd/utility/profiler.hpp>
+#include <halmd/utility/thread_pool.hpp>
 
 #include <boost/multi_array.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <lua.hpp>
 
 #include <algorithm>
@@ -40,6 +42,16 @@ namespace halmd {
 namespace mdsim {
 namespace host {
 
+/**
+ * Cell lists of host particles
+ *
+ * The particles are sorted by cell index using a counting sort, which yields
+ * a contiguous array of particle indices, and each cell refers to a range of
+ * this array. Within a cell, particles are ordered by ascending index. The
+ * particles are counted and scattered in parallel, with each thread processing
+ * a fixed block of particles, so the cell lists do not depend on the number of
+ * threads.
+ */
 template <int dimension, typename float_type>
 class binning
 {
@@ -49,10 +61,11 @@ public:
     typedef boost::numeric::ublas::matrix<float_type> matrix_type;
     typedef mdsim::box<dimension> box_type;
 
-    typedef std::vector<unsigned int> cell_list;
+    typedef boost::iterator_range<unsigned int const*> cell_list;
     typedef boost::multi_array<cell_list, dimension> array_type;
     typedef fixed_vector<size_t, dimension> cell_size_type;
     typedef fixed_vector<ssize_t, dimension> cell_diff_type;
+    typedef utility::thread_pool thread_pool_type;
 
     static void luaopen(lua_State* L);
 
@@ -61,6 +74,7 @@ public:
       , std::shared_ptr<box_type const> box
       , matrix_type const& r_cut
       , float_type skin
+      , std::shared_ptr<thread_pool_type> thread_pool = std::make_shared<thread_pool_type>()
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
@@ -85,6 +99,12 @@ public:
     //! get cell lists
     cache<array_type> const& cell();
 
+    //! get cell lists of the last update, which may be outdated
+    cache<array_type> const& last_cell() const
+    {
+        return cell_;
+    }
+
 private:
     typedef typename particle_type::size_type size_type;
     typedef typename particle_type::position_array_type position_array_type;
@@ -93,12 +113,20 @@ private:
 
     //! system state
     std::shared_ptr<particle_type const> particle_;
+    /** host threads */
+    std::shared_ptr<thread_pool_type> thread_pool_;
     /** module logger */
     std::shared_ptr<logger> logger_;
     /** neighbour list skin in MD units */
     float_type r_skin_;
     /** cell lists */
     cache<array_type> cell_;
+    /** particle indices sorted by cell */
+    std::vector<unsigned int> index_;
+    /** linear cell index of each particle */
+    std::vector<unsigned int> cell_index_;
+    /** per-thread particle counts, and offsets after prefix sum, of each cell */
+    std::vector<unsigned int> count_;
     /** cache observer for cell list update */
     cache<> cell_cache_;
     /** number of cells per dimension */
@@ -24,6 +24,7 @@
 #ifndef HALMD_MDSIM_HOST_FORCES_PAIR_TRUNC_HPP
 #define HALMD_MDSIM_HOST_FORCES_PAIR_TRUNC_HPP
 
+#include <halmd/config.hpp>
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
 #include <halmd/mdsim/force_kernel.hpp>
@@ -31,10 +32,15 @@
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/profiler.hpp>
+#include <halmd/utility/raw_array.hpp>
 #include <halmd/utility/signal.hpp>
+#include <halmd/utility/thread_pool.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 namespace halmd {
 namespace mdsim {
@@ -43,6 +49,21 @@ namespace forces {
 
 /**
  * template class for modules implementing short ranged potential forces
+ *
+ * The particles of the first instance are distributed over the threads of
+ * the host thread pool in contiguous blocks. If Newton's third law applies,
+ * the reaction forces on neighbour particles of a block may fall into the
+ * block of another thread. Therefore, thread 0 accumulates into the particle
+ * arrays directly, while all other threads accumulate into private buffers,
+ * which are added to the particle arrays in a subsequent reduction with a
+ * fixed order of summation. For a given number of threads, the result is
+ * thus independent of the thread scheduling.
+ *
+ * A private buffer spans only the window of particle indices touched by the
+ * block of the thread, i.e., the block and its neighbours, which is
+ * determined upon each update of the neighbour lists. For particles ordered
+ * along a space-filling curve, the windows are barely larger than the blocks,
+ * and zeroing and reduction of the buffers scale with N / P instead of N.
  */
 template <int dimension, typename float_type, typename potential_type>
 class pair_trunc
@@ -51,6 +72,7 @@ public:
     typedef particle<dimension, float_type> particle_type;
     typedef box<dimension> box_type;
     typedef neighbour neighbour_type;
+    typedef utility::thread_pool thread_pool_type;
     typedef halmd::signal<void ()> signal_type;
     typedef signal_type::slot_function_type slot_function_type;
 
@@ -61,6 +83,7 @@ public:
       , std::shared_ptr<box_type const> box
       , std::shared_ptr<neighbour_type> neighbour
       , float_type aux_weight = 1
+      , std::shared_ptr<thread_pool_type> thread_pool = std::make_shared<thread_pool_type>()
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
@@ -100,16 +123,53 @@ private:
     typedef typename particle_type::species_type species_type;
     typedef typename particle_type::size_type size_type;
     typedef typename particle_type::en_pot_type en_pot_type;
+    typedef typename particle_type::force_type force_type;
     typedef typename particle_type::force_array_type force_array_type;
+    typedef typename force_array_type::value_type force_value_type;
     typedef typename particle_type::en_pot_array_type en_pot_array_type;
     typedef typename particle_type::stress_pot_array_type stress_pot_array_type;
     typedef typename particle_type::stress_pot_type stress_pot_type;
     typedef typename neighbour_type::array_type neighbour_array_type;
+    typedef typename potential_type::batch_type batch_type;
 
     /** compute forces */
     void compute_();
     /** compute forces with auxiliary variables */
     void compute_aux_();
+    /**
+     * accumulate forces, and optionally auxiliary variables, of particles in [first, last)
+     *
+     * The pairs within the cutoff are collected in batches, for which the
+     * potential is evaluated with SIMD instructions. The function is compiled
+     * for several instruction sets, which are selected at runtime.
+     */
+    template <bool aux>
+    HALMD_TARGET_CLONES void compute_particles_(
+        size_type first
+      , size_type last
+      , neighbour_array_type const& lists
+      , position_array_type const& position1
+      , position_array_type const& position2
+      , species_array_type const& species1
+      , species_array_type const& species2
+      , force_value_type* force
+      , en_pot_type* en_pot
+      , stress_pot_type* stress_pot
+      , float_type weight
+      , size_type offset
+    );
+    /**
+     * allocate private buffers of threads 1, …, N - 1
+     *
+     * @returns true if the index windows of the buffers are out of date
+     */
+    bool resize_buffers_(bool aux);
+    /** determine index window of particles in [first, last) and their neighbours */
+    void update_window_(unsigned int thread, size_type first, size_type last, neighbour_array_type const& lists);
+    /** allocate and zero private buffers of given thread within its index window */
+    void zero_buffer_(unsigned int thread, bool aux);
+    /** add private buffers of all threads to the particle arrays */
+    void reduce_buffers_(bool aux);
 
     /** pair potential */
     std::shared_ptr<potential_type const> potential_;
@@ -123,6 +183,8 @@ private:
     std::shared_ptr<neighbour_type> neighbour_;
     /** weight for auxiliary variables */
     float_type aux_weight_;
+    /** host thread pool */
+    std::shared_ptr<thread_pool_type> thread_pool_;
     /** module logger */
     std::shared_ptr<logger> logger_;
 
@@ -131,6 +193,17 @@ private:
     /** cache observer of auxiliary variables */
     std::tuple<cache<>, cache<>, cache<>, cache<>> aux_cache_;
 
+    /** private force buffers of threads 1, …, N - 1 */
+    std::vector<force_array_type> force_buffer_;
+    /** private buffers for potential energy of threads 1, …, N - 1 */
+    std::vector<raw_array<en_pot_type>> en_pot_buffer_;
+    /** private buffers for potential part of stress tensor of threads 1, …, N - 1 */
+    std::vector<raw_array<stress_pot_type>> stress_pot_buffer_;
+    /** index windows [first, last) of the private buffers per thread */
+    std::vector<std::pair<size_type, size_type>> window_;
+    /** cache observer of neighbour lists for the index windows */
+    cache<> window_cache_;
+
     /** store signal connections */
     signal_type on_prepend_apply_;
     signal_type on_append_apply_;
@@ -156,6 +229,7 @@ pair_trunc<dimension, float_type, potential_type>::pair_trunc(
   , std::shared_ptr<box_type const> box
   , std::shared_ptr<neighbour_type> neighbour
   , float_type aux_weight
+  , std::shared_ptr<thread_pool_type> thread_pool
   , std::shared_ptr<logger> logger
 )
   : potential_(potential)
@@ -164,6 +238,7 @@ pair_trunc<dimension, float_type, potential_type>::pair_trunc(
   , box_(box)
   , neighbour_(neighbour)
   , aux_weight_(aux_weight)
+  , thread_pool_(thread_pool)
   , logger_(logger)
 {
 }
@@ -231,39 +306,40 @@ inline void pair_trunc<dimension, float_type, potential_type>::compute_()
 
     scoped_timer_type timer(runtime_.compute);
 
+    // whether Newton's third law applies
+    bool const reactio = (particle1_ == particle2_);
+    // whether threads other than the first one need private buffers
+    bool const buffered = reactio && thread_pool_->size() > 1;
+    bool const update_window = buffered && resize_buffers_(false);
+
     // reset the force and auxiliary variables to zero if necessary
     if (particle1_->force_zero()) {
-        std::fill(force->begin(), force->end(), 0);
+        thread_pool_->parallel_for(0, force->size(), [&](unsigned int, size_type first, size_type last) {
+            std::fill(force->begin() + first, force->begin() + last, 0);
+        });
     }
 
-    // whether Newton's third law applies
-    bool const reactio = (particle1_ == particle2_);
-
-    for (size_type i = 0; i < nparticle1; ++i) {
-        // calculate pairwise force with neighbour particles
-        for (size_type j : lists[i]) {
-            // particle distance vector
-            position_type r = position1[i] - position2[j];
-            box_->reduce_periodic(r);
-            // particle types
-            species_type a = species1[i];
-            species_type b = species2[j];
-            // squared particle distance
-            float_type rr = inner_prod(r, r);
-
-            // truncate potential at cutoff distance
-            if (!potential_->within_range(rr, a, b))
-                continue;
-
-            float_type fval, pot;
-            std::tie(fval, pot) = (*potential_)(rr, a, b);
-
-            // add force contribution to both particles
-            (*force)[i] += r * fval;
-            if (reactio) {
-                (*force)[j] -= r * fval;
+    thread_pool_->parallel_for(0, nparticle1, [&](unsigned int thread, size_type first, size_type last) {
+        force_value_type* f = force->begin();
+        size_type offset = 0;
+        if (buffered && thread > 0) {
+            if (update_window) {
+                update_window_(thread, first, last, lists);
             }
+            zero_buffer_(thread, false);
+            f = force_buffer_[thread - 1].begin();
+            offset = window_[thread].first;
+        }
+        compute_particles_<false>(
+            first, last, lists, position1, position2, species1, species2, f, nullptr, nullptr, 0, offset
+        );
+    });
+
+    if (buffered) {
+        if (update_window) {
+            window_cache_ = neighbour_->lists();
         }
+        reduce_buffers_(false);
     }
 }
 
@@ -285,61 +361,233 @@ inline void pair_trunc<dimension, float_type, potential_type>::compute_aux_()
 
     scoped_timer_type timer(runtime_.compute_aux);
 
+    // whether Newton's third law applies
+    bool const reactio = (particle1_ == particle2_);
+    // whether threads other than the first one need private buffers
+    bool const buffered = reactio && thread_pool_->size() > 1;
+    bool const update_window = buffered && resize_buffers_(true);
+
     // reset the force and auxiliary variables to zero if necessary
     if (particle1_->force_zero()) {
-        std::fill(force->begin(), force->end(), 0);
-        std::fill(en_pot->begin(), en_pot->end(), 0);
-        std::fill(stress_pot->begin(), stress_pot->end(), 0);
+        thread_pool_->parallel_for(0, force->size(), [&](unsigned int, size_type first, size_type last) {
+            std::fill(force->begin() + first, force->begin() + last, 0);
+            std::fill(en_pot->begin() + first, en_pot->begin() + last, 0);
+            std::fill(stress_pot->begin() + first, stress_pot->begin() + last, 0);
+        });
     }
 
-    // whether Newton's third law applies
-    bool const reactio = (particle1_ == particle2_);
-
     float_type weight = aux_weight_;
     if (reactio) {
         weight /= 2;
     }
 
-    for (size_type i = 0; i < nparticle1; ++i) {
-        // calculate pairwise force with neighbour particles
-        for (size_type j : lists[i]) {
-            // particle distance vector
-            position_type r = position1[i] - position2[j];
-            box_->reduce_periodic(r);
-            // particle types
-            species_type a = species1[i];
-            species_type b = species2[j];
-            // squared particle distance
-            float_type rr = inner_prod(r, r);
-
-            // truncate potential at cutoff distance
-            if (rr >= potential_->rr_cut(a, b))
-                continue;
-
-            float_type fval, pot;
-            std::tie(fval, pot) = (*potential_)(rr, a, b);
-
-            // add force contribution to both particles
-            (*force)[i] += r * fval;
-            if (reactio) {
-                (*force)[j] -= r * fval;
+    thread_pool_->parallel_for(0, nparticle1, [&](unsigned int thread, size_type first, size_type last) {
+        force_value_type* f = force->begin();
+        en_pot_type* en = en_pot->begin();
+        stress_pot_type* stress = stress_pot->begin();
+        size_type offset = 0;
+        if (buffered && thread > 0) {
+            if (update_window) {
+                update_window_(thread, first, last, lists);
             }
+            zero_buffer_(thread, true);
+            f = force_buffer_[thread - 1].begin();
+            en = en_pot_buffer_[thread - 1].begin();
+            stress = stress_pot_buffer_[thread - 1].begin();
+            offset = window_[thread].first;
+        }
+        compute_particles_<true>(
+            first, last, lists, position1, position2, species1, species2, f, en, stress, weight, offset
+        );
+    });
+
+    if (buffered) {
+        if (update_window) {
+            window_cache_ = neighbour_->lists();
+        }
+        reduce_buffers_(true);
+    }
+}
 
-            // contribution to potential energy
-            en_pot_type en = weight * pot;
-            // potential part of stress tensor
-            stress_pot_type stress = weight * fval * make_stress_tensor(r);
+template <int dimension, typename float_type, typename potential_type>
+template <bool aux>
+inline void pair_trunc<dimension, float_type, potential_type>::compute_particles_(
+    size_type first
+  , size_type last
+  , neighbour_array_type const& lists
+  , position_array_type const& position1
+  , position_array_type const& position2
+  , species_array_type const& species1
+  , species_array_type const& species2
+  , force_value_type* force
+  , en_pot_type* en_pot
+  , stress_pot_type* stress_pot
+  , float_type weight
+  , size_type offset
+)
+{
+    // whether Newton's third law applies
+    bool const reactio = (particle1_ == particle2_);
+
+    batch_type pairs;
+    // indices and distance vectors of the second particles of the batch
+    unsigned int index[batch_type::capacity];
+    position_type dr[batch_type::capacity];
+
+    for (size_type i = first; i < last; ++i) {
+        auto const list = lists[i];
+        auto j_it = list.begin();
+        pairs.a = species1[i];
+
+        while (j_it != list.end()) {
+            // collect pairs within the cutoff distance into batch
+            pairs.size = 0;
+            for (; j_it != list.end() && pairs.size < batch_type::capacity; ++j_it) {
+                unsigned int j = *j_it;
+                // particle distance vector
+                position_type r = position1[i] - position2[j];
+                box_->reduce_periodic(r);
+                // particle type
+                species_type b = species2[j];
+                // squared particle distance
+                float_type rr = inner_prod(r, r);
+
+                // truncate potential at cutoff distance
+                if (!potential_->within_range(rr, pairs.a, b))
+                    continue;
+
+                unsigned int k = pairs.size++;
+                index[k] = j;
+                dr[k] = r;
+                pairs.b[k] = b;
+                pairs.rr[k] = rr;
+            }
+
+            // evaluate potential for all pairs of the batch
+            (*potential_)(pairs);
+
+            for (unsigned int k = 0; k < pairs.size; ++k) {
+                unsigned int j = index[k];
+                position_type const& r = dr[k];
+                float_type fval = pairs.fval[k];
+
+                // add force contribution to both particles,
+                // where the arrays start at particle index offset
+                force[i - offset] += r * fval;
+                if (reactio) {
+                    force[j - offset] -= r * fval;
+                }
+
+                if (aux) {
+                    // contribution to potential energy
+                    en_pot_type en = weight * pairs.en_pot[k];
+                    // potential part of stress tensor
+                    stress_pot_type stress = weight * fval * make_stress_tensor(r);
+
+                    // store contributions for first particle
+                    en_pot[i - offset]      += en;
+                    stress_pot[i - offset]  += stress;
+
+                    // store contributions for second particle
+                    if (reactio) {
+                        en_pot[j - offset]      += en;
+                        stress_pot[j - offset]  += stress;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <int dimension, typename float_type, typename potential_type>
+inline bool pair_trunc<dimension, float_type, potential_type>::resize_buffers_(bool aux)
+{
+    unsigned int nthread = thread_pool_->size();
+    force_buffer_.resize(nthread - 1);
+    if (aux) {
+        en_pot_buffer_.resize(nthread - 1);
+        stress_pot_buffer_.resize(nthread - 1);
+    }
+    // the blocks of the threads change with the number of threads
+    bool update = window_.size() != nthread || window_cache_ != neighbour_->lists();
+    window_.resize(nthread);
+    return update;
+}
+
+template <int dimension, typename float_type, typename potential_type>
+inline void pair_trunc<dimension, float_type, potential_type>::update_window_(
+    unsigned int thread
+  , size_type first
+  , size_type last
+  , neighbour_array_type const& lists
+)
+{
+    size_type lower = first;
+    size_type upper = last;
+    for (size_type i = first; i < last; ++i) {
+        for (unsigned int j : lists[i]) {
+            lower = std::min(lower, size_type(j));
+            upper = std::max(upper, size_type(j + 1));
+        }
+    }
+    window_[thread] = std::make_pair(lower, upper);
+}
 
-            // store contributions for first particle
-            (*en_pot)[i]      += en;
-            (*stress_pot)[i]  += stress;
+template <int dimension, typename float_type, typename potential_type>
+inline void pair_trunc<dimension, float_type, potential_type>::zero_buffer_(unsigned int thread, bool aux)
+{
+    // the buffers are allocated and zeroed by the owning thread to place
+    // the memory pages close to the thread on NUMA systems
+    size_type size = window_[thread].second - window_[thread].first;
+    force_array_type& force = force_buffer_[thread - 1];
+    force.resize(size);
+    std::fill(force.begin(), force.end(), 0);
+    if (aux) {
+        raw_array<en_pot_type>& en_pot = en_pot_buffer_[thread - 1];
+        raw_array<stress_pot_type>& stress_pot = stress_pot_buffer_[thread - 1];
+        en_pot.resize(size);
+        stress_pot.resize(size);
+        std::fill(en_pot.begin(), en_pot.end(), 0);
+        std::fill(stress_pot.begin(), stress_pot.end(), 0);
+    }
+}
 
-            // store contributions for second particle
-            if (reactio) {
-                (*en_pot)[j]      += en;
-                (*stress_pot)[j]  += stress;
+template <int dimension, typename float_type, typename potential_type>
+inline void pair_trunc<dimension, float_type, potential_type>::reduce_buffers_(bool aux)
+{
+    auto force = make_cache_mutable(particle1_->mutable_force());
+    unsigned int nbuffer = thread_pool_->size() - 1;
+
+    thread_pool_->parallel_for(0, particle1_->nparticle(), [&](unsigned int, size_type first, size_type last) {
+        // sum up contributions in the order of the threads
+        for (unsigned int k = 0; k < nbuffer; ++k) {
+            size_type offset = window_[k + 1].first;
+            size_type begin = std::max(first, offset);
+            size_type end = std::min(last, window_[k + 1].second);
+            force_array_type const& buffer = force_buffer_[k];
+            for (size_type i = begin; i < end; ++i) {
+                (*force)[i] += buffer[i - offset];
             }
         }
+    });
+
+    if (aux) {
+        auto en_pot     = make_cache_mutable(particle1_->mutable_potential_energy());
+        auto stress_pot = make_cache_mutable(particle1_->mutable_stress_pot());
+
+        thread_pool_->parallel_for(0, particle1_->nparticle(), [&](unsigned int, size_type first, size_type last) {
+            for (unsigned int k = 0; k < nbuffer; ++k) {
+                size_type offset = window_[k + 1].first;
+                size_type begin = std::max(first, offset);
+                size_type end = std::min(last, window_[k + 1].second);
+                raw_array<en_pot_type> const& en_pot_buffer = en_pot_buffer_[k];
+                raw_array<stress_pot_type> const& stress_pot_buffer = stress_pot_buffer_[k];
+                for (size_type i = begin; i < end; ++i) {
+                    (*en_pot)[i] += en_pot_buffer[i - offset];
+                    (*stress_pot)[i] += stress_pot_buffer[i - offset];
+                }
+            }
+        });
     }
 }
 
@@ -373,6 +621,7 @@ void pair_trunc<dimension, float_type, potential_type>::luaopen(lua_State* L)
                   , std::shared_ptr<box_type const>
                   , std::shared_ptr<neighbour_type>
                   , float_type
+                  , std::shared_ptr<thread_pool_type>
                   , std::shared_ptr<logger>
                 >)
             ]
@@ -0,0 +1,343 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <halmd/mdsim/host/integrators/respa.hpp>
+#include <halmd/utility/lua/lua.hpp>
+
+namespace halmd {
+namespace mdsim {
+namespace host {
+namespace integrators {
+
+template <int dimension, typename float_type>
+respa<dimension, float_type>::respa(
+    std::shared_ptr<particle_type> particle
+  , std::shared_ptr<box_type const> box
+  , double timestep
+  , std::vector<unsigned int> const& substep
+  , std::shared_ptr<logger> logger
+)
+  // dependency injection
+  : particle_(particle)
+  , box_(box)
+  , level_(substep.size() + 1)
+  , logger_(logger)
+{
+    level_[0].stride = 1;
+    for (unsigned int l = 1; l < level_.size(); ++l) {
+        if (substep[l - 1] < 1) {
+            throw std::invalid_argument("number of substeps of r-RESPA integrator must be positive");
+        }
+        level_[l].stride = level_[l - 1].stride * substep[l - 1];
+    }
+    for (level_type& level : level_) {
+        level.due = false;
+    }
+    LOG("number of force levels: " << level_.size());
+    set_timestep(timestep);
+}
+
+template <int dimension, typename float_type>
+void respa<dimension, float_type>::set_timestep(double timestep)
+{
+    timestep_ = timestep;
+    timestep_fast_ = timestep / level_.back().stride;
+    for (unsigned int l = 0; l < level_.size(); ++l) {
+        LOG("integration time-step of level " << l << ": " << this->timestep(l));
+    }
+}
+
+template <int dimension, typename float_type>
+double respa<dimension, float_type>::timestep(unsigned int level) const
+{
+    if (level >= level_.size()) {
+        throw std::invalid_argument("invalid force level of r-RESPA integrator");
+    }
+    return timestep_ * level_[level].stride / level_.back().stride;
+}
+
+template <int dimension, typename float_type>
+connection respa<dimension, float_type>::on_force(unsigned int level, slot_function_type const& slot)
+{
+    if (level < 1 || level >= level_.size()) {
+        throw std::invalid_argument("invalid force level of r-RESPA integrator");
+    }
+    return level_[level].on_force.connect(slot);
+}
+
+/**
+ * Kicks and drifts of the fastest level, which span the step of the slowest level
+ */
+template <int dimension, typename float_type>
+void respa<dimension, float_type>::integrate()
+{
+    unsigned int nstep = level_.back().stride;
+
+    LOG_DEBUG("update positions and velocities: " << nstep << " steps of fastest level")
+    scoped_timer_type timer(runtime_.integrate);
+
+    // defer a requested computation of the auxiliary variables to the force
+    // at the end of the step, which is computed by finalize(); otherwise the
+    // force of the first substep would compute them, along with all slower
+    // levels, see apply()
+    bool aux = particle_->aux_enabled();
+    if (aux) {
+        particle_->aux_disable();
+    }
+
+    for (unsigned int step = 0; step < nstep; ++step) {
+        kick_(step, true);
+    }
+
+    if (aux) {
+        particle_->aux_enable();
+    }
+}
+
+/**
+ * Final half-kick of all levels
+ */
+template <int dimension, typename float_type>
+void respa<dimension, float_type>::finalize()
+{
+    LOG_DEBUG("update velocities: final half-step of all levels")
+    scoped_timer_type timer(runtime_.finalize);
+
+    kick_(level_.back().stride, false);
+}
+
+template <int dimension, typename float_type>
+void respa<dimension, float_type>::kick_(unsigned int step, bool drift)
+{
+    unsigned int nstep = level_.back().stride;
+
+    // request the forces of the slower levels that act at this step,
+    // unless they are up-to-date
+    cache<position_array_type> const& position_cache = particle_->position();
+    cache<species_array_type> const& species_cache = particle_->species();
+    auto current_state = std::tie(position_cache, species_cache);
+
+    bool dirty = false;
+    for (unsigned int l = 1; l < level_.size(); ++l) {
+        level_type& level = level_[l];
+        if (step % level.stride == 0 && level.force_cache != current_state) {
+            level.due = true;
+            dirty = true;
+        }
+    }
+    if (dirty) {
+        particle_->mark_force_dirty();
+    }
+
+    force_array_type const& force = read_cache(particle_->force());
+    mass_array_type const& mass = read_cache(particle_->mass());
+    size_type nparticle = particle_->nparticle();
+
+    // a step of each level ends and the next one starts here, except for the
+    // first and the final kick of the slowest step
+    float_type weight = (step > 0 && step < nstep) ? 1 : float_type(0.5);
+
+    // forces and time increments of the slower levels that act at this step
+    std::vector<std::pair<force_type const*, float_type>> slow;
+    for (unsigned int l = 1; l < level_.size(); ++l) {
+        level_type const& level = level_[l];
+        if (step % level.stride == 0) {
+            if (level.due) {
+                throw std::logic_error("r-RESPA integrator is not connected to particle force");
+            }
+            slow.emplace_back(level.force.data(), weight * level.stride * timestep_fast_);
+        }
+    }
+    float_type fast = weight * timestep_fast_;
+
+    // invalidate the particle caches after accessing the force!
+    auto velocity = make_cache_mutable(particle_->velocity());
+
+    if (!drift) {
+        for (size_type i = 0; i < nparticle; ++i) {
+            vector_type f = force[i] * fast;
+            for (auto const& level : slow) {
+                f += level.first[i] * level.second;
+            }
+            (*velocity)[i] += f / mass[i];
+        }
+        return;
+    }
+
+    auto position = make_cache_mutable(particle_->position());
+    auto image = make_cache_mutable(particle_->image());
+
+    for (size_type i = 0; i < nparticle; ++i) {
+        vector_type& v = (*velocity)[i];
+        vector_type& r = (*position)[i];
+        vector_type f = force[i] * fast;
+        for (auto const& level : slow) {
+            f += level.first[i] * level.second;
+        }
+        v += f / mass[i];
+        r += v * timestep_fast_;
+        (*image)[i] += box_->reduce_periodic(r);
+    }
+}
+
+/**
+ * Compute forces of slower levels
+ *
+ * The force modules of a level accumulate into the particle force, which is
+ * saved before and restored afterwards. The auxiliary variables of all
+ * levels accumulate, so the slower levels are recomputed along with the
+ * fastest level if auxiliary variables are requested.
+ */
+template <int dimension, typename float_type>
+void respa<dimension, float_type>::apply()
+{
+    bool aux = particle_->aux_enabled();
+    size_type nparticle = particle_->nparticle();
+
+    cache<position_array_type> const& position_cache = particle_->position();
+    cache<species_array_type> const& species_cache = particle_->species();
+    auto current_state = std::tie(position_cache, species_cache);
+
+    for (unsigned int l = 1; l < level_.size(); ++l) {
+        level_type& level = level_[l];
+        if (!level.due && !aux) {
+            continue;
+        }
+
+        LOG_DEBUG("compute forces of level " << l)
+        scoped_timer_type timer(runtime_.apply);
+
+        // the first force module resets the auxiliary variables if needed
+        bool zero = particle_->force_zero();
+        {
+            auto force = make_cache_mutable(particle_->mutable_force());
+            if (!zero) {
+                force_save_.assign(force->begin(), force->begin() + nparticle);
+            }
+            std::fill(force->begin(), force->end(), 0);
+        }
+
+        level.on_force();
+
+        {
+            auto force = make_cache_mutable(particle_->mutable_force());
+            level.force.assign(force->begin(), force->begin() + nparticle);
+            if (zero) {
+                std::fill(force->begin(), force->end(), 0);
+            }
+            else {
+                std::copy(force_save_.begin(), force_save_.end(), force->begin());
+            }
+        }
+
+        level.force_cache = current_state;
+        level.due = false;
+    }
+}
+
+template <typename integrator_type>
+static std::function<void ()>
+wrap_integrate(std::shared_ptr<integrator_type> self)
+{
+    return [=]() {
+        self->integrate();
+    };
+}
+
+template <typename integrator_type>
+static std::function<void ()>
+wrap_finalize(std::shared_ptr<integrator_type> self)
+{
+    return [=]() {
+        self->finalize();
+    };
+}
+
+template <int dimension, typename float_type>
+void respa<dimension, float_type>::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("mdsim")
+        [
+            namespace_("integrators")
+            [
+                class_<respa>()
+                    .property("integrate", &wrap_integrate<respa>)
+                    .property("finalize", &wrap_finalize<respa>)
+                    .def("apply", &respa::apply)
+                    .def("on_force", &respa::on_force)
+                    .def("set_timestep", &respa::set_timestep)
+                    .property("timestep", static_cast<double (respa::*)() const>(&respa::timestep))
+                    .def("level_timestep", static_cast<double (respa::*)(unsigned int) const>(&respa::timestep))
+                    .property("levels", &respa::levels)
+                    .scope
+                    [
+                        class_<runtime>("runtime")
+                            .def_readonly("integrate", &runtime::integrate)
+                            .def_readonly("finalize", &runtime::finalize)
+                            .def_readonly("apply", &runtime::apply)
+                    ]
+                    .def_readonly("runtime", &respa::runtime_)
+
+              , def("respa", &std::make_shared<respa
+                  , std::shared_ptr<particle_type>
+                  , std::shared_ptr<box_type const>
+                  , double
+                  , std::vector<unsigned int> const&
+                  , std::shared_ptr<logger>
+                >)
+            ]
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_mdsim_host_integrators_respa(lua_State* L)
+{
+#ifndef USE_HOST_SINGLE_PRECISION
+    respa<3, double>::luaopen(L);
+    respa<2, double>::luaopen(L);
+#else
+    respa<3, float>::luaopen(L);
+    respa<2, float>::luaopen(L);
+#endif
+    return 0;
+}
+
+// explicit instantiation
+#ifndef USE_HOST_SINGLE_PRECISION
+template class respa<3, double>;
+template class respa<2, double>;
+#else
+template class respa<3, float>;
+template class respa<2, float>;
+#endif
+
+} // namespace integrators
+} // namespace host
+} // namespace mdsim
+} // namespace halmd
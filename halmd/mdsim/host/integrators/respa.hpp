@@ -0,0 +1,178 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_MDSIM_HOST_INTEGRATORS_RESPA_HPP
+#define HALMD_MDSIM_HOST_INTEGRATORS_RESPA_HPP
+
+#include <lua.hpp>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/utility/cache.hpp>
+#include <halmd/utility/profiler.hpp>
+#include <halmd/utility/signal.hpp>
+
+namespace halmd {
+namespace mdsim {
+namespace host {
+namespace integrators {
+
+/**
+ * Multiple-time-step velocity-Verlet integrator (r-RESPA)
+ *
+ * The forces are grouped into levels, which are integrated with different
+ * sub-timesteps. Level 0 holds the fastest varying forces, which are the
+ * forces connected to the particle instance as usual. The forces of each
+ * slower level l ≥ 1 are connected to the integrator with on_force(l), and
+ * they are computed only every substep[l-1] steps of the next faster level.
+ * The integration time-step refers to the slowest level.
+ *
+ * The implementation follows
+ * M. Tuckerman, B. J. Berne, and G. J. Martyna, J. Chem. Phys. 97, 1990 (1992).
+ */
+template <int dimension, typename float_type>
+class respa
+{
+public:
+    typedef host::particle<dimension, float_type> particle_type;
+    typedef typename particle_type::vector_type vector_type;
+    typedef mdsim::box<dimension> box_type;
+    typedef halmd::signal<void ()> signal_type;
+    typedef signal_type::slot_function_type slot_function_type;
+
+    static void luaopen(lua_State* L);
+
+    /**
+     * @param timestep integration time-step of the slowest level
+     * @param substep number of steps of the next faster level per step of
+     *   each slower level, in the order of increasing level
+     */
+    respa(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<box_type const> box
+      , double timestep
+      , std::vector<unsigned int> const& substep
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
+    );
+    void integrate();
+    void finalize();
+    void set_timestep(double timestep);
+
+    /**
+     * Compute forces of the slower levels that are due, and store them
+     * separately from the particle force.
+     *
+     * This function must be connected to particle::on_force().
+     */
+    void apply();
+
+    /**
+     * Connect force computation of given slower level.
+     *
+     * The slot must add the force to the particle force, e.g., by calling
+     * apply() of a force module that is not connected to the particle.
+     */
+    connection on_force(unsigned int level, slot_function_type const& slot);
+
+    //! returns integration time-step of the slowest level
+    double timestep() const
+    {
+        return timestep_;
+    }
+
+    //! returns integration time-step of given level
+    double timestep(unsigned int level) const;
+
+    //! returns number of levels
+    unsigned int levels() const
+    {
+        return level_.size();
+    }
+
+private:
+    typedef typename particle_type::position_array_type position_array_type;
+    typedef typename particle_type::image_array_type image_array_type;
+    typedef typename particle_type::velocity_array_type velocity_array_type;
+    typedef typename particle_type::force_array_type force_array_type;
+    typedef typename particle_type::mass_array_type mass_array_type;
+    typedef typename particle_type::species_array_type species_array_type;
+    typedef typename particle_type::size_type size_type;
+    typedef typename force_array_type::value_type force_type;
+
+    typedef utility::profiler::accumulator_type accumulator_type;
+    typedef utility::profiler::scoped_timer_type scoped_timer_type;
+
+    struct runtime
+    {
+        accumulator_type integrate;
+        accumulator_type finalize;
+        accumulator_type apply;
+    };
+
+    struct level_type
+    {
+        /** number of steps of the fastest level per step of this level */
+        unsigned int stride;
+        /** force computation of this level, unused for level 0 */
+        signal_type on_force;
+        /** force of this level, unused for level 0 */
+        std::vector<force_type> force;
+        /** cache observer of the positions and species the force refers to */
+        std::tuple<cache<>, cache<>> force_cache;
+        /** true if the force needs to be computed by the next call of apply() */
+        bool due;
+    };
+
+    /**
+     * Update velocities at the given step of the fastest level, by a half
+     * kick for the levels that start or end a step at this point, and a
+     * full kick for the levels that do both. Optionally, drift the
+     * positions by a step of the fastest level in the same sweep.
+     */
+    void kick_(unsigned int step, bool drift);
+
+    /** system state */
+    std::shared_ptr<particle_type> particle_;
+    /** simulation domain */
+    std::shared_ptr<box_type const> box_;
+    /** integration time-step of the slowest level */
+    double timestep_;
+    /** integration time-step of the fastest level */
+    float_type timestep_fast_;
+    /** force levels in the order of increasing time-step */
+    std::vector<level_type> level_;
+    /** particle force saved during the computation of a slower level */
+    std::vector<force_type> force_save_;
+    /** module logger */
+    std::shared_ptr<logger> logger_;
+    /** profiling runtime accumulators */
+    runtime runtime_;
+};
+
+} // namespace integrators
+} // namespace host
+} // namespace mdsim
+} // namespace halmd
+
+#endif /* ! HALMD_MDSIM_HOST_INTEGRATORS_RESPA_HPP */
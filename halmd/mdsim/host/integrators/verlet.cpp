@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <memory>
 
 #include <halmd/mdsim/host/integrators/verlet.hpp>
@@ -40,6 +41,7 @@ verlet<dimension, float_type>::verlet(
   // dependency injection
   : particle_(particle)
   , box_(box)
+  , deferred_(false)
   , logger_(logger)
 {
     set_timestep(timestep);
@@ -54,6 +56,9 @@ void verlet<dimension, float_type>::set_timestep(double timestep)
 
 /**
  * First leapfrog half-step of velocity-Verlet algorithm
+ *
+ * A deferred second half-step of the previous step is applied in the same
+ * sweep, both half-steps use the force at the current positions.
  */
 template <int dimension, typename float_type>
 void verlet<dimension, float_type>::integrate()
@@ -70,10 +75,13 @@ void verlet<dimension, float_type>::integrate()
     auto image = make_cache_mutable(particle_->image());
     auto velocity = make_cache_mutable(particle_->velocity());
 
+    float_type kick = deferred_ ? timestep_ : timestep_half_;
+    deferred_ = false;
+
     for (size_type i = 0; i < nparticle; ++i) {
         vector_type& v = (*velocity)[i];
         vector_type& r = (*position)[i];
-        v += force[i] * timestep_half_ / mass[i];
+        v += force[i] * kick / mass[i];
         r += v * timestep_;
         (*image)[i] += box_->reduce_periodic(r);
     }
@@ -100,6 +108,43 @@ void verlet<dimension, float_type>::finalize()
     }
 }
 
+/**
+ * Defer second leapfrog half-step to the next call of integrate()
+ *
+ * The particle velocities lag behind by half a step until then, and must
+ * not be read or modified by other modules in the meantime.
+ */
+template <int dimension, typename float_type>
+void verlet<dimension, float_type>::defer_finalize()
+{
+    LOG_DEBUG("defer second leapfrog half-step")
+    deferred_ = true;
+}
+
+/**
+ * Perform second leapfrog half-step, or defer it if the current batch of
+ * integration steps of the core continues without interruption
+ */
+template <int dimension, typename float_type>
+void verlet<dimension, float_type>::fused_finalize(mdsim::core const& core)
+{
+    if (core.remaining_steps() > 0) {
+        defer_finalize();
+    }
+    else {
+        finalize();
+    }
+}
+
+template <typename integrator_type>
+static std::function<void ()>
+wrap_fused_finalize(std::shared_ptr<integrator_type> self, std::shared_ptr<mdsim::core const> core)
+{
+    return [=]() {
+        self->fused_finalize(*core);
+    };
+}
+
 template <int dimension, typename float_type>
 void verlet<dimension, float_type>::luaopen(lua_State* L)
 {
@@ -113,6 +158,8 @@ void verlet<dimension, float_type>::luaopen(lua_State* L)
                 class_<verlet>()
                     .def("integrate", &verlet::integrate)
                     .def("finalize", &verlet::finalize)
+                    .def("defer_finalize", &verlet::defer_finalize)
+                    .def("fused_finalize", &wrap_fused_finalize<verlet>)
                     .def("set_timestep", &verlet::set_timestep)
                     .property("timestep", &verlet::timestep)
                     .scope
@@ -26,6 +26,7 @@
 
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/core.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/utility/profiler.hpp>
 
@@ -52,6 +53,8 @@ public:
     );
     void integrate();
     void finalize();
+    void defer_finalize();
+    void fused_finalize(mdsim::core const& core);
     void set_timestep(double timestep);
 
     //! returns integration time-step
@@ -85,6 +88,8 @@ private:
     float_type timestep_;
     /** half time-step */
     float_type timestep_half_;
+    /** true if the second half-step is deferred to the next call of integrate() */
+    bool deferred_;
     /** module logger */
     std::shared_ptr<logger> logger_;
     /** profiling runtime accumulators */
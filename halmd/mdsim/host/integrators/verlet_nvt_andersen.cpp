@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <boost/bind/bind.hpp>
 #include <cmath>
+#include <cstdint>
 #include <memory>
 
 #include <halmd/mdsim/host/integrators/verlet_nvt_andersen.hpp>
@@ -36,6 +37,7 @@ verlet_nvt_andersen<dimension, float_type>::verlet_nvt_andersen(
     std::shared_ptr<particle_type> particle
   , std::shared_ptr<box_type const> box
   , std::shared_ptr<random_type> random
+  , std::shared_ptr<clock_type const> clock
   , float_type timestep
   , float_type temperature
   , float_type coll_rate
@@ -44,6 +46,7 @@ verlet_nvt_andersen<dimension, float_type>::verlet_nvt_andersen(
   : particle_(particle)
   , box_(box)
   , random_(random)
+  , clock_(clock)
   , coll_rate_(coll_rate)
   , logger_(logger)
 {
@@ -97,6 +100,7 @@ void verlet_nvt_andersen<dimension, float_type>::finalize()
 {
     force_array_type const& force = read_cache(particle_->force());
     mass_array_type const& mass = read_cache(particle_->mass());
+    id_array_type const& id = read_cache(particle_->id());
     size_type nparticle = particle_->nparticle();
 
     LOG_DEBUG("update velocities: second leapfrog half-step")
@@ -105,32 +109,29 @@ void verlet_nvt_andersen<dimension, float_type>::finalize()
     // invalidate the particle caches after accessing the force!
     auto velocity = make_cache_mutable(particle_->velocity());
 
-    // cache random numbers
-    float_type rng_cache = 0;
-    bool rng_cache_valid = false;
+    // each particle draws from a separate stream of random numbers, keyed
+    // by the simulation step and its identifier, which makes the loop
+    // iterations independent
+    std::uint64_t sequence = random_type::sequence(clock_->step(), random_type::stream_id::verlet_nvt_andersen);
 
     // loop over all particles
     for (size_type i = 0; i < nparticle; ++i) {
         vector_type& v = (*velocity)[i];
+        random_type::random_generator rng = random_->stream(sequence, id[i]);
         // is deterministic step?
-        if (random_->uniform<float_type>() > coll_prob_) {
+        if (random::host::uniform<float_type>(rng) > coll_prob_) {
             v += force[i] * timestep_half_ / mass[i];
         }
         // stochastic coupling with heat bath
         else {
             // assign two velocity components at a time
-            for (unsigned int i = 0; i < dimension - 1; i += 2) {
-                std::tie(v[i], v[i + 1]) = random_->normal(sqrt_temperature_);
+            for (unsigned int j = 0; j < dimension - 1; j += 2) {
+                std::tie(v[j], v[j + 1]) = random::host::normal(rng, sqrt_temperature_);
             }
             // handle last component separately for odd dimensions
             if (dimension % 2 == 1) {
-                if (rng_cache_valid) {
-                    v[dimension - 1] = rng_cache;
-                }
-                else {
-                    std::tie(v[dimension - 1], rng_cache) = random_->normal(sqrt_temperature_);
-                }
-                rng_cache_valid = !rng_cache_valid;
+                float_type r;
+                std::tie(v[dimension - 1], r) = random::host::normal(rng, sqrt_temperature_);
             }
         }
     }
@@ -166,6 +167,7 @@ void verlet_nvt_andersen<dimension, float_type>::luaopen(lua_State* L)
                   , std::shared_ptr<particle_type>
                   , std::shared_ptr<box_type const>
                   , std::shared_ptr<random_type>
+                  , std::shared_ptr<clock_type const>
                   , float_type
                   , float_type
                   , float_type
@@ -26,6 +26,7 @@
 
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/random/host/random.hpp>
 #include <halmd/utility/profiler.hpp>
@@ -42,6 +43,7 @@ public:
     typedef host::particle<dimension, float_type> particle_type;
     typedef mdsim::box<dimension> box_type;
     typedef random::host::random random_type;
+    typedef mdsim::clock clock_type;
 
 private:
     typedef typename particle_type::vector_type vector_type;
@@ -54,6 +56,7 @@ public:
         std::shared_ptr<particle_type> particle
       , std::shared_ptr<box_type const> box
       , std::shared_ptr<random_type> random
+      , std::shared_ptr<clock_type const> clock
       , float_type timestep
       , float_type temperature
       , float_type coll_rate
@@ -115,6 +118,7 @@ private:
     typedef typename particle_type::velocity_array_type velocity_array_type;
     typedef typename particle_type::force_array_type force_array_type;
     typedef typename particle_type::mass_array_type mass_array_type;
+    typedef typename particle_type::id_array_type id_array_type;
     typedef typename particle_type::size_type size_type;
 
     /** system state */
@@ -123,6 +127,8 @@ private:
     std::shared_ptr<box_type const> box_;
     /** random number generator */
     std::shared_ptr<random_type> random_;
+    /** simulation clock */
+    std::shared_ptr<clock_type const> clock_;
     /** integration time-step */
     float_type timestep_;
     /** half time-step */
@@ -55,6 +55,7 @@ verlet_nvt_hoover<dimension, float_type>::verlet_nvt_hoover(
   // member initialisation
   , en_nhc_(0)
   , resonance_frequency_(resonance_frequency)
+  , deferred_(false)
 {
     set_timestep(timestep);
 
@@ -103,6 +104,10 @@ set_mass(chain_type const& mass)
 
 /**
  * First leapfrog half-step of velocity-Verlet algorithm
+ *
+ * A deferred second half-step of the previous step is applied in the same
+ * sweep. The kinetic energy is accumulated along, so that the two
+ * consecutive propagations of the chain merge into a single rescaling.
  */
 template <int dimension, typename float_type>
 void verlet_nvt_hoover<dimension, float_type>::integrate()
@@ -119,12 +124,37 @@ void verlet_nvt_hoover<dimension, float_type>::integrate()
     auto image = make_cache_mutable(particle_->image());
     auto velocity = make_cache_mutable(particle_->velocity());
 
-    propagate_chain();
+    if (!deferred_) {
+        propagate_chain();
+
+        for (size_type i = 0; i < nparticle; ++i) {
+            vector_type& v = (*velocity)[i];
+            vector_type& r = (*position)[i];
+            v += force[i] * timestep_half_ / mass[i];
+            r += v * timestep_;
+            (*image)[i] += box_->reduce_periodic(r);
+        }
+        return;
+    }
 
+    // second half-step of previous step
+    float_type en_kin_2 = 0;
     for (size_type i = 0; i < nparticle; ++i) {
         vector_type& v = (*velocity)[i];
-        vector_type& r = (*position)[i];
         v += force[i] * timestep_half_ / mass[i];
+        // assuming unit mass for all particle types
+        en_kin_2 += inner_prod(v, v);
+    }
+    float_type s = propagate_chain(en_kin_2);
+    compute_en_nhc();
+    deferred_ = false;
+
+    // first half-step of current step, the velocities are rescaled only once
+    s *= propagate_chain(en_kin_2 * s * s);
+    for (size_type i = 0; i < nparticle; ++i) {
+        vector_type& v = (*velocity)[i];
+        vector_type& r = (*position)[i];
+        v = v * s + force[i] * timestep_half_ / mass[i];
         r += v * timestep_;
         (*image)[i] += box_->reduce_periodic(r);
     }
@@ -152,8 +182,45 @@ void verlet_nvt_hoover<dimension, float_type>::finalize()
     }
 
     propagate_chain();
+    compute_en_nhc();
+}
 
-    // compute energy contribution of chain variables
+/**
+ * Defer second leapfrog half-step to the next call of integrate()
+ *
+ * The particle velocities and the chain variables lag behind by half a step
+ * until then, and must not be read or modified by other modules in the
+ * meantime.
+ */
+template <int dimension, typename float_type>
+void verlet_nvt_hoover<dimension, float_type>::defer_finalize()
+{
+    LOG_DEBUG("defer second leapfrog half-step")
+    deferred_ = true;
+}
+
+/**
+ * Perform second half-step, or defer it if the current batch of integration
+ * steps of the core continues without interruption
+ */
+template <int dimension, typename float_type>
+void verlet_nvt_hoover<dimension, float_type>::fused_finalize(mdsim::core const& core)
+{
+    if (core.remaining_steps() > 0) {
+        defer_finalize();
+    }
+    else {
+        finalize();
+    }
+}
+
+/**
+ * compute energy contribution of chain variables
+ */
+template <int dimension, typename float_type>
+void verlet_nvt_hoover<dimension, float_type>::compute_en_nhc()
+{
+    size_type nparticle = particle_->nparticle();
     en_nhc_ = temperature_ * (dimension * nparticle * xi[0] + xi[1]);
     for (unsigned int i = 0; i < 2; ++i ) {
         en_nhc_ += mass_xi_[i] * v_xi[i] * v_xi[i] / 2;
@@ -178,6 +245,21 @@ void verlet_nvt_hoover<dimension, float_type>::propagate_chain()
         en_kin_2 += inner_prod(v, v);
     }
 
+    // rescale velocities
+    float_type s = propagate_chain(en_kin_2);
+    for (vector_type& v : *velocity) {
+        v *= s;
+    }
+}
+
+/**
+ * propagate Nosé-Hoover chain for given kinetic energy (multiplied by 2)
+ *
+ * Returns the scaling factor of the particle velocities.
+ */
+template <int dimension, typename float_type>
+float_type verlet_nvt_hoover<dimension, float_type>::propagate_chain(float_type en_kin_2)
+{
     // head of the chain
     v_xi[1] += (mass_xi_[0] * v_xi[0] * v_xi[0] - temperature_) / mass_xi_[1] * timestep_4_;
     float_type t = exp(-v_xi[1] * timestep_8_);
@@ -190,11 +272,8 @@ void verlet_nvt_hoover<dimension, float_type>::propagate_chain()
         xi[i] += v_xi[i] * timestep_half_;
     }
 
-    // rescale velocities and kinetic energy
+    // rescale kinetic energy
     float_type s = exp(-v_xi[0] * timestep_half_);
-    for (vector_type& v : *velocity) {
-        v *= s;
-    }
     en_kin_2 *= s * s;
 
     // tail of the chain, mirrors the head
@@ -202,6 +281,8 @@ void verlet_nvt_hoover<dimension, float_type>::propagate_chain()
     v_xi[0] += (en_kin_2 - en_kin_target_2_) / mass_xi_[0] * timestep_4_;
     v_xi[0] *= t;
     v_xi[1] += (mass_xi_[0] * v_xi[0] * v_xi[0] - temperature_) / mass_xi_[1] * timestep_4_;
+
+    return s;
 }
 
 template <typename integrator_type>
@@ -222,6 +303,24 @@ wrap_finalize(std::shared_ptr<integrator_type> self)
     };
 }
 
+template <typename integrator_type>
+static std::function<void ()>
+wrap_defer_finalize(std::shared_ptr<integrator_type> self)
+{
+    return [=]() {
+        self->defer_finalize();
+    };
+}
+
+template <typename integrator_type>
+static std::function<void ()>
+wrap_fused_finalize(std::shared_ptr<integrator_type> self, std::shared_ptr<mdsim::core const> core)
+{
+    return [=]() {
+        self->fused_finalize(*core);
+    };
+}
+
 template <typename integrator_type>
 static std::function<typename integrator_type::chain_type& ()>
 wrap_position(std::shared_ptr<integrator_type> self)
@@ -262,6 +361,8 @@ void verlet_nvt_hoover<dimension, float_type>::luaopen(lua_State* L)
                 class_<verlet_nvt_hoover>()
                     .property("integrate", &wrap_integrate<verlet_nvt_hoover>)
                     .property("finalize", &wrap_finalize<verlet_nvt_hoover>)
+                    .property("defer_finalize", &wrap_defer_finalize<verlet_nvt_hoover>)
+                    .def("fused_finalize", &wrap_fused_finalize<verlet_nvt_hoover>)
                     .property("timestep", &verlet_nvt_hoover::timestep)
                     .property("temperature", &verlet_nvt_hoover::temperature)
                     .property("position", &wrap_position<verlet_nvt_hoover>)
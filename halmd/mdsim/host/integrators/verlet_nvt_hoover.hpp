@@ -26,6 +26,7 @@
 
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/core.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/utility/profiler.hpp>
 
@@ -63,6 +64,8 @@ public:
 
     void integrate();
     void finalize();
+    void defer_finalize();
+    void fused_finalize(mdsim::core const& core);
     void set_timestep(double timestep);
     void set_temperature(double temperature);
     void set_mass(chain_type const& mass);
@@ -126,6 +129,10 @@ private:
 
     // propagate chain of Nosé-Hoover variables
     void propagate_chain();
+    // propagate chain for given kinetic energy, returns velocity scaling factor
+    float_type propagate_chain(float_type en_kin_2);
+    // compute energy of chain variables
+    void compute_en_nhc();
 
     /** system state */
     std::shared_ptr<particle_type> particle_;
@@ -151,6 +158,8 @@ private:
     float_type resonance_frequency_;
     /** coupling parameters: `mass' of the heat bath variables */
     chain_type mass_xi_;
+    /** true if the second half-step is deferred to the next call of integrate() */
+    bool deferred_;
 
     /** profiling runtime accumulators */
     runtime runtime_;
@@ -21,12 +21,11 @@
 #ifndef HALMD_MDSIM_HOST_NEIGHBOUR_HPP
 #define HALMD_MDSIM_HOST_NEIGHBOUR_HPP
 
+#include <halmd/mdsim/host/neighbour_array.hpp>
 #include <halmd/utility/cache.hpp>
 
 #include <lua.hpp>
 
-#include <vector>
-
 namespace halmd {
 namespace mdsim {
 namespace host {
@@ -36,12 +35,14 @@ namespace host {
  *
  * This class provides implementation-independent access to host
  * neighbour lists for force modules with truncated potentials.
+ *
+ * The lists of all particles are stored contiguously, see neighbour_array.
  */
 class neighbour
 {
 public:
-    typedef std::vector<std::vector<unsigned int>> array_type;
-    typedef typename array_type::value_type neighbour_list;
+    typedef neighbour_array array_type;
+    typedef array_type::const_reference neighbour_list;
 
     virtual ~neighbour() {}
     /** Lua bindings */
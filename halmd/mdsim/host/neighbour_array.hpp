@@ -0,0 +1,183 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_MDSIM_HOST_NEIGHBOUR_ARRAY_HPP
+#define HALMD_MDSIM_HOST_NEIGHBOUR_ARRAY_HPP
+
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace halmd {
+namespace mdsim {
+namespace host {
+
+/**
+ * Neighbour lists of all particles in compressed sparse row format
+ *
+ * The neighbour indices of all particles are stored in contiguous arrays, and
+ * the list of each particle is given by a range [first, last) of one of these
+ * arrays. The lists need not be stored in the order of the particle indices,
+ * which allows filling them, e.g., in the order of cells.
+ *
+ * A list is filled by a call to open(), followed by calls to push_back(), and
+ * completed by close(). clear() empties all lists, but retains the allocated
+ * memory for the next update.
+ *
+ * For a concurrent update, the storage is split into several partitions, each
+ * of which holds one contiguous array of neighbour indices. Each thread fills
+ * the lists of a disjoint set of particles into its own partition, with at
+ * most one open list per partition.
+ */
+class neighbour_array
+{
+public:
+    typedef unsigned int value_type;
+    typedef std::size_t size_type;
+    typedef value_type const* const_iterator;
+    /** neighbour list of a single particle */
+    typedef boost::iterator_range<const_iterator> const_reference;
+
+    neighbour_array()
+      : index_(1)
+      , open_(1, 0)
+    {}
+
+    /**
+     * Allocate empty neighbour lists for given number of particles.
+     */
+    explicit neighbour_array(size_type nparticle, unsigned int npartition = 1)
+      : index_(npartition)
+      , first_(nparticle, 0)
+      , last_(nparticle, 0)
+      , partition_(nparticle, 0)
+      , open_(npartition, 0)
+    {}
+
+    /** returns number of neighbour lists */
+    size_type size() const
+    {
+        return first_.size();
+    }
+
+    /** returns number of partitions */
+    unsigned int npartition() const
+    {
+        return index_.size();
+    }
+
+    /** returns total number of neighbours over all lists */
+    size_type nneighbour() const
+    {
+        size_type n = 0;
+        for (auto const& index : index_) {
+            n += index.size();
+        }
+        return n;
+    }
+
+    /** returns neighbour list of particle */
+    const_reference operator[](size_type i) const
+    {
+        value_type const* index = index_[partition_[i]].data();
+        return const_reference(index + first_[i], index + last_[i]);
+    }
+
+    /**
+     * Empty all neighbour lists, retaining allocated memory.
+     */
+    void clear()
+    {
+        for (auto& index : index_) {
+            index.clear();
+        }
+        std::fill(first_.begin(), first_.end(), 0);
+        std::fill(last_.begin(), last_.end(), 0);
+        std::fill(partition_.begin(), partition_.end(), 0);
+    }
+
+    /**
+     * Change number of neighbour lists and empty all lists.
+     */
+    void resize(size_type nparticle)
+    {
+        first_.resize(nparticle);
+        last_.resize(nparticle);
+        partition_.resize(nparticle);
+        clear();
+    }
+
+    /**
+     * Change number of partitions and empty all lists.
+     */
+    void partition(unsigned int npartition)
+    {
+        index_.resize(npartition);
+        open_.resize(npartition);
+        clear();
+    }
+
+    /**
+     * Start neighbour list of particle in given partition, discarding its
+     * previous contents.
+     */
+    void open(size_type i, unsigned int partition = 0)
+    {
+        open_[partition] = i;
+        partition_[i] = partition;
+        first_[i] = index_[partition].size();
+    }
+
+    /**
+     * Append neighbour to the open list of given partition.
+     */
+    void push_back(value_type j, unsigned int partition = 0)
+    {
+        index_[partition].push_back(j);
+    }
+
+    /**
+     * Complete the open list of given partition.
+     */
+    void close(unsigned int partition = 0)
+    {
+        last_[open_[partition]] = index_[partition].size();
+    }
+
+private:
+    /** neighbour indices of all particles for each partition */
+    std::vector<std::vector<value_type>> index_;
+    /** offsets of first neighbour of each particle */
+    std::vector<size_type> first_;
+    /** offsets past last neighbour of each particle */
+    std::vector<size_type> last_;
+    /** partition holding the neighbour list of each particle */
+    std::vector<unsigned int> partition_;
+    /** particle with open neighbour list for each partition */
+    std::vector<size_type> open_;
+};
+
+} // namespace host
+} // namespace mdsim
+} // namespace halmd
+
+#endif /* ! HALMD_MDSIM_HOST_NEIGHBOUR_ARRAY_HPP */
@@ -23,6 +23,8 @@
 #include <halmd/mdsim/host/neighbours/from_binning.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
+#include <algorithm>
+
 namespace halmd {
 namespace mdsim {
 namespace host {
@@ -45,6 +47,7 @@ from_binning<dimension, float_type>::from_binning(
   , std::shared_ptr<box_type const> box
   , matrix_type const& r_cut
   , double skin
+  , std::shared_ptr<thread_pool_type> thread_pool
   , std::shared_ptr<logger> logger
 )
   // dependency injection
@@ -55,27 +58,98 @@ from_binning<dimension, float_type>::from_binning(
   , displacement1_(displacement.first)
   , displacement2_(displacement.second)
   , box_(box)
+  , thread_pool_(thread_pool)
   , logger_(logger)
   // allocate parameters
-  , neighbour_(particle1_->nparticle())
-  , r_skin_(skin)
+  , neighbour_(particle1_->nparticle(), thread_pool_->size())
+  , r_cut_(r_cut)
   , rr_cut_skin_(particle1_->nspecies(), particle2_->nspecies())
+  , update_runtime_(0)
+  , step_(0)
+{
+    set_skin(skin);
+    LOG("neighbour list skin: " << r_skin_);
+}
+
+/**
+ * Set neighbour list skin and squared cutoff distances including the skin
+ */
+template <int dimension, typename float_type>
+void from_binning<dimension, float_type>::set_skin(float_type skin)
 {
-    matrix_type r_cut_skin(r_cut.size1(), r_cut.size2());
-    typename matrix_type::value_type r_cut_max = 0;
-    for (size_t i = 0; i < r_cut.size1(); ++i) {
-        for (size_t j = 0; j < r_cut.size2(); ++j) {
-            r_cut_skin(i, j) = r_cut(i, j) + r_skin_;
-            rr_cut_skin_(i, j) = std::pow(r_cut_skin(i, j), 2);
-            r_cut_max = std::max(r_cut_skin(i, j), r_cut_max);
+    r_skin_ = skin;
+    for (size_t i = 0; i < r_cut_.size1(); ++i) {
+        for (size_t j = 0; j < r_cut_.size2(); ++j) {
+            rr_cut_skin_(i, j) = std::pow(r_cut_(i, j) + r_skin_, 2);
         }
     }
+}
 
-    LOG("neighbour list skin: " << r_skin_);
+/**
+ * Enable automatic tuning of the neighbour list skin
+ *
+ * The upper bound of the skin is limited by the edge lengths of the cells of
+ * the binning modules, which are not changed by the tuning. The cost of an
+ * update interval is divided by the number of simulation steps in between,
+ * which is independent of how often the lists are queried per step.
+ */
+template <int dimension, typename float_type>
+void from_binning<dimension, float_type>::tune_skin(
+    float_type skin_min
+  , float_type skin_max
+  , unsigned int window
+  , std::shared_ptr<clock_type const> clock
+)
+{
+    float_type r_cut_max = *std::max_element(r_cut_.data().begin(), r_cut_.data().end());
+    float_type cell_length = std::min(
+        *std::min_element(binning1_->cell_length().begin(), binning1_->cell_length().end())
+      , *std::min_element(binning2_->cell_length().begin(), binning2_->cell_length().end())
+    );
+    if (skin_max > cell_length - r_cut_max) {
+        skin_max = cell_length - r_cut_max;
+        LOG_WARNING("upper bound of neighbour list skin limited by edge length of cells");
+    }
+    tuner_.reset(new skin_tuner(r_skin_, skin_min, skin_max, window));
+    clock_ = clock;
+    step_ = clock_->step();
+    update_runtime_ = 0;
+    for (auto& force : force_runtime_) {
+        force.count = count(*force.runtime);
+        force.sum = sum(*force.runtime);
+    }
+    LOG("tune neighbour list skin within [" << skin_min << ", " << skin_max << "]"
+        << " over " << window << " updates per trial"
+    );
 }
 
 template <int dimension, typename float_type>
-cache<std::vector<typename from_binning<dimension, float_type>::neighbour_list>> const&
+void from_binning<dimension, float_type>::add_force_runtime(std::shared_ptr<accumulator_type const> runtime)
+{
+    force_runtime_.push_back({runtime, count(*runtime), sum(*runtime)});
+}
+
+/**
+ * Returns runtime of force computations since the last call.
+ *
+ * The accumulators may have been reset by the profiler in the meantime.
+ */
+template <int dimension, typename float_type>
+double from_binning<dimension, float_type>::force_runtime()
+{
+    double runtime = 0;
+    for (auto& force : force_runtime_) {
+        std::size_t n = count(*force.runtime);
+        double s = sum(*force.runtime);
+        runtime += (n >= force.count) ? s - force.sum : s;
+        force.count = n;
+        force.sum = s;
+    }
+    return runtime;
+}
+
+template <int dimension, typename float_type>
+cache<typename from_binning<dimension, float_type>::array_type> const&
 from_binning<dimension, float_type>::lists()
 {
     cache<reverse_id_array_type> const& reverse_id_cache1 = particle1_->reverse_id();
@@ -85,12 +159,30 @@ from_binning<dimension, float_type>::lists()
 
     if (neighbour_cache_ != current_cache || displacement1_->compute() > r_skin_ / 2
         || displacement2_->compute() > r_skin_ / 2) {
+        typename clock_type::step_type step = clock_ ? clock_->step() : 0;
+        if (tuner_ && tuner_->active() && step > step_) {
+            // pass cost of the past update interval to the tuner, which
+            // returns the skin for the next interval
+            float_type skin = tuner_->sample(update_runtime_ + force_runtime(), step - step_);
+            if (!tuner_->active()) {
+                LOG("selected neighbour list skin: " << tuner_->best_skin()
+                    << " (" << 1e6 * tuner_->best_cost() << " µs per step)"
+                );
+            }
+            else if (skin != r_skin_) {
+                LOG_DEBUG("trial neighbour list skin: " << skin);
+            }
+            set_skin(skin);
+        }
+        step_ = step;
+        timer_type timer;
         on_prepend_update_();
         update();
         displacement1_->zero();
         displacement2_->zero();
         neighbour_cache_ = current_cache;
         on_append_update_();
+        update_runtime_ = timer.elapsed();
     }
     return neighbour_;
 }
@@ -113,6 +205,10 @@ bool from_binning<dimension, float_type>::is_binning_compatible(
 
 /**
  * Update neighbour lists
+ *
+ * The cells are split into contiguous blocks, one per thread, and each thread
+ * fills the neighbour lists of the particles in its cells into a separate
+ * partition of the neighbour array.
  */
 template <int dimension, typename float_type>
 void from_binning<dimension, float_type>::update()
@@ -122,41 +218,68 @@ void from_binning<dimension, float_type>::update()
     // the order of calls is setup at the Lua level, and it allows us to
     // pass binning as a const dependency.
 
+    // fetch input arrays in the calling thread, which may trigger updates
+    cell_array_type const& cell1 = read_cache(binning1_->cell());
+    cell_array_type const& cell2 = read_cache(binning2_->cell());
+    position_array_type const& position1 = read_cache(particle1_->position());
+    position_array_type const& position2 = read_cache(particle2_->position());
+    species_array_type const& species1 = read_cache(particle1_->species());
+    species_array_type const& species2 = read_cache(particle2_->species());
+
+    auto neighbour = make_cache_mutable(neighbour_);
+
     LOG_DEBUG("update neighbour lists");
 
     scoped_timer_type timer(runtime_.update);
 
+    // empty neighbour lists, retaining the allocated memory
+    unsigned int const nthread = thread_pool_->size();
+    if (neighbour->npartition() != nthread) {
+        neighbour->partition(nthread);
+    }
+    else {
+        neighbour->clear();
+    }
+
     cell_size_type const& ncell = binning1_->ncell();
-    cell_size_type i;
-    for (i[0] = 0; i[0] < ncell[0]; ++i[0]) {
-        for (i[1] = 0; i[1] < ncell[1]; ++i[1]) {
-            if (dimension == 3) {
-                for (i[2] = 0; i[2] < ncell[2]; ++i[2]) {
-                    update_cell_neighbours(i);
-                }
-            }
-            else {
-                update_cell_neighbours(i);
+    thread_pool_->parallel_for(0, cell1.num_elements(), [&](unsigned int thread, size_t first, size_t last) {
+        for (size_t c = first; c < last; ++c) {
+            // convert linear index in row-major storage order to cell index
+            cell_size_type i;
+            size_t k = c;
+            for (int j = dimension - 1; j >= 0; --j) {
+                i[j] = k % ncell[j];
+                k /= ncell[j];
             }
+            update_cell_neighbours(
+                i, thread, *neighbour
+              , cell1, cell2, position1, position2, species1, species2
+            );
         }
-    }
+    });
 }
 
 /**
  * Update neighbour lists for a single cell
  */
 template <int dimension, typename float_type>
-void from_binning<dimension, float_type>::update_cell_neighbours(cell_size_type const& i)
+void from_binning<dimension, float_type>::update_cell_neighbours(
+    cell_size_type const& i
+  , unsigned int partition
+  , array_type& neighbour
+  , cell_array_type const& cell1
+  , cell_array_type const& cell2
+  , position_array_type const& position1
+  , position_array_type const& position2
+  , species_array_type const& species1
+  , species_array_type const& species2
+)
 {
-    cell_array_type const& cell1 = read_cache(binning1_->cell());
-    cell_array_type const& cell2 = read_cache(binning2_->cell());
-
-    auto neighbour = make_cache_mutable(neighbour_);
     cell_size_type const& ncell = binning1_->ncell();
 
     for (size_t p : cell1(i)) {
-        // empty neighbour list of particle
-        (*neighbour)[p].clear();
+        // start neighbour list of particle
+        neighbour.open(p, partition);
 
         cell_diff_type j;
         for (j[0] = -1; j[0] <= 1; ++j[0]) {
@@ -169,7 +292,10 @@ void from_binning<dimension, float_type>::update_cell_neighbours(cell_size_type
                         }
                         // update neighbour list of particle
                         cell_size_type k = element_mod(static_cast<cell_size_type>(static_cast<cell_diff_type>(i + ncell) + j), ncell);
-                        compute_cell_neighbours<false>(p, cell2(k));
+                        compute_cell_neighbours<false>(
+                            p, cell2(k), partition, neighbour
+                          , position1, position2, species1, species2
+                        );
                     }
                 }
                 else {
@@ -179,13 +305,20 @@ void from_binning<dimension, float_type>::update_cell_neighbours(cell_size_type
                     }
                     // update neighbour list of particle
                     cell_size_type k = element_mod(static_cast<cell_size_type>(static_cast<cell_diff_type>(i + ncell) + j), ncell);
-                    compute_cell_neighbours<false>(p, cell2(k));
+                    compute_cell_neighbours<false>(
+                        p, cell2(k), partition, neighbour
+                      , position1, position2, species1, species2
+                    );
                 }
             }
         }
 self:
         // visit this cell
-        compute_cell_neighbours<true>(p, cell2(i));
+        compute_cell_neighbours<true>(
+            p, cell2(i), partition, neighbour
+          , position1, position2, species1, species2
+        );
+        neighbour.close(partition);
     }
 }
 
@@ -194,15 +327,17 @@ self:
  */
 template <int dimension, typename float_type>
 template <bool same_cell>
-void from_binning<dimension, float_type>::compute_cell_neighbours(size_t i, cell_list const& c)
+void from_binning<dimension, float_type>::compute_cell_neighbours(
+    size_t i
+  , cell_list const& c
+  , unsigned int partition
+  , array_type& neighbour
+  , position_array_type const& position1
+  , position_array_type const& position2
+  , species_array_type const& species1
+  , species_array_type const& species2
+)
 {
-    auto neighbour = make_cache_mutable(neighbour_);
-
-    position_array_type const& position1 = read_cache(particle1_->position());
-    position_array_type const& position2 = read_cache(particle2_->position());
-    species_array_type const& species1 = read_cache(particle1_->species());
-    species_array_type const& species2 = read_cache(particle2_->species());
-
     for (size_type j : c) {
         // skip identical particle and particle pair permutations if same cell
         if (same_cell && particle1_ == particle2_ && j <= i) {
@@ -224,7 +359,7 @@ void from_binning<dimension, float_type>::compute_cell_neighbours(size_t i, cell
         }
 
         // add particle to neighbour list
-        (*neighbour)[i].push_back(j);
+        neighbour.push_back(j, partition);
     }
 }
 
@@ -240,6 +375,9 @@ void from_binning<dimension, float_type>::luaopen(lua_State* L)
             [
                 class_<from_binning, _Base>()
                     .property("r_skin", &from_binning::r_skin)
+                    .property("skin_tuning", &from_binning::skin_tuning)
+                    .def("tune_skin", &from_binning::tune_skin)
+                    .def("add_force_runtime", &from_binning::add_force_runtime)
                     .def("on_prepend_update", &from_binning::on_prepend_update)
                     .def("on_append_update", &from_binning::on_append_update)
                     .scope
@@ -256,6 +394,7 @@ void from_binning<dimension, float_type>::luaopen(lua_State* L)
                   , std::shared_ptr<box_type const>
                   , matrix_type const&
                   , double
+                  , std::shared_ptr<thread_pool_type>
                   , std::shared_ptr<logger>
                   >)
               , def("is_binning_compatible", &from_binning::is_binning_compatible)
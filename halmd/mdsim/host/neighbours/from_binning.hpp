@@ -25,11 +25,14 @@
 
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
 #include <halmd/mdsim/host/binning.hpp>
 #include <halmd/mdsim/host/max_displacement.hpp>
 #include <halmd/mdsim/host/neighbour.hpp>
+#include <halmd/mdsim/host/neighbours/skin_tuner.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/utility/profiler.hpp>
+#include <halmd/utility/thread_pool.hpp>
 
 #include <boost/numeric/ublas/matrix.hpp>
 #include <lua.hpp>
@@ -54,9 +57,12 @@ public:
     typedef typename particle_type::vector_type vector_type;
     typedef boost::numeric::ublas::matrix<float_type> matrix_type;
     typedef mdsim::box<dimension> box_type;
+    typedef mdsim::clock clock_type;
     typedef host::binning<dimension, float_type> binning_type;
     typedef typename _Base::neighbour_list neighbour_list;
     typedef max_displacement<dimension, float_type> displacement_type;
+    typedef utility::thread_pool thread_pool_type;
+    typedef utility::profiler::accumulator_type accumulator_type;
 
     typedef _Base::array_type array_type;
 
@@ -70,6 +76,7 @@ public:
       , std::shared_ptr<box_type const> box
       , matrix_type const& r_cut
       , double skin
+      , std::shared_ptr<thread_pool_type> thread_pool = std::make_shared<thread_pool_type>()
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
@@ -89,9 +96,37 @@ public:
         return r_skin_;
     }
 
+    //! returns true while the neighbour list skin is tuned
+    bool skin_tuning() const
+    {
+        return tuner_ && tuner_->active();
+    }
+
     //! returns neighbour lists
     virtual cache<array_type> const& lists();
 
+    /**
+     * Enable automatic tuning of the neighbour list skin.
+     *
+     * @param skin_min lower bound of skin
+     * @param skin_max upper bound of skin
+     * @param window number of neighbour list updates per trial
+     * @param clock simulation clock, which yields the number of steps
+     *        between neighbour list updates
+     */
+    void tune_skin(
+        float_type skin_min
+      , float_type skin_max
+      , unsigned int window
+      , std::shared_ptr<clock_type const> clock
+    );
+
+    /**
+     * Add runtime accumulator of a force computation that uses the
+     * neighbour lists to the cost function of the skin tuning.
+     */
+    void add_force_runtime(std::shared_ptr<accumulator_type const> runtime);
+
     //! returns true if the binning modules are compatible with the neighbour list module
     static bool is_binning_compatible(
         std::shared_ptr<binning_type const> binning1
@@ -105,8 +140,8 @@ private:
     typedef typename particle_type::species_type species_type;
     typedef typename particle_type::size_type size_type;
 
-    typedef utility::profiler::accumulator_type accumulator_type;
     typedef utility::profiler::scoped_timer_type scoped_timer_type;
+    typedef utility::profiler::timer_type timer_type;
 
     struct runtime
     {
@@ -125,12 +160,34 @@ private:
     std::shared_ptr<displacement_type> displacement1_;
     std::shared_ptr<displacement_type> displacement2_;
     std::shared_ptr<box_type const> box_;
+    std::shared_ptr<thread_pool_type> thread_pool_;
     std::shared_ptr<logger> logger_;
 
     void update();
-    void update_cell_neighbours(cell_size_type const& i);
+    void set_skin(float_type skin);
+    double force_runtime();
+    void update_cell_neighbours(
+        cell_size_type const& i
+      , unsigned int partition
+      , array_type& neighbour
+      , cell_array_type const& cell1
+      , cell_array_type const& cell2
+      , position_array_type const& position1
+      , position_array_type const& position2
+      , species_array_type const& species1
+      , species_array_type const& species2
+    );
     template <bool same_cell>
-    void compute_cell_neighbours(size_t i, cell_list const& c);
+    void compute_cell_neighbours(
+        size_t i
+      , cell_list const& c
+      , unsigned int partition
+      , array_type& neighbour
+      , position_array_type const& position1
+      , position_array_type const& position2
+      , species_array_type const& species1
+      , species_array_type const& species2
+    );
 
     /** neighbour lists */
     cache<array_type> neighbour_;
@@ -138,8 +195,27 @@ private:
     std::tuple<cache<>, cache<>> neighbour_cache_;
     /** neighbour list skin in MD units */
     float_type r_skin_;
+    /** cutoff distances */
+    matrix_type r_cut_;
     /** (cutoff distances + neighbour list skin)² */
     matrix_type rr_cut_skin_;
+    /** skin tuner, or null if tuning is disabled */
+    std::unique_ptr<skin_tuner> tuner_;
+    /** runtime accumulator of a force computation, with count and sum at last update */
+    struct force_runtime_type
+    {
+        std::shared_ptr<accumulator_type const> runtime;
+        std::size_t count;
+        double sum;
+    };
+    /** runtime accumulators of force computations */
+    std::vector<force_runtime_type> force_runtime_;
+    /** runtime of last neighbour list update including sorting and binning */
+    double update_runtime_;
+    /** simulation clock for skin tuning */
+    std::shared_ptr<clock_type const> clock_;
+    /** simulation step of last neighbour list update */
+    clock_type::step_type step_;
     /** signal emitted before neighbour list update */
     signal<void ()> on_prepend_update_;
     /** signal emitted after neighbour list update */
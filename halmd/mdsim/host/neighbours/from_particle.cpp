@@ -70,7 +70,7 @@ from_particle<dimension, float_type>::from_particle(
 }
 
 template <int dimension, typename float_type>
-cache<std::vector<typename from_particle<dimension, float_type>::neighbour_list>> const&
+cache<typename from_particle<dimension, float_type>::array_type> const&
 from_particle<dimension, float_type>::lists()
 {
     cache<reverse_id_array_type> const& reverse_id_cache1 = particle1_->reverse_id();
@@ -112,13 +112,16 @@ void from_particle<dimension, float_type>::update()
     // whether Newton's third law applies
     bool const reactio = (particle1_ == particle2_);
 
+    // empty neighbour lists, retaining the allocated memory
+    neighbour->clear();
+
     for (size_type i = 0; i < nparticle1; ++i) {
         // load first particle
         vector_type r1 = position1[i];
         species_type type1 = species1[i];
 
-        // clear particle's neighbour list
-        (*neighbour)[i].clear();
+        // start particle's neighbour list
+        neighbour->open(i);
 
         for (size_type j = reactio ? (i + 1) : 0; j < nparticle2; ++j) {
             // load second particle
@@ -137,8 +140,9 @@ void from_particle<dimension, float_type>::update()
             }
 
             // add particle to neighbour list
-            (*neighbour)[i].push_back(j);
+            neighbour->push_back(j);
         }
+        neighbour->close();
     }
 }
 
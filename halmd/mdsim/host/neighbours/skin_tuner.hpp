@@ -0,0 +1,219 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_MDSIM_HOST_NEIGHBOURS_SKIN_TUNER_HPP
+#define HALMD_MDSIM_HOST_NEIGHBOURS_SKIN_TUNER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace halmd {
+namespace mdsim {
+namespace host {
+namespace neighbours {
+
+/**
+ * Search for the neighbour list skin with minimal cost per step
+ *
+ * A larger skin reduces the frequency of neighbour list updates, but
+ * increases the cost of each update and of the force computation due to the
+ * larger number of neighbours. The tuner is fed with the measured cost of
+ * each update interval, i.e., the runtime of an update and of the force
+ * computations until the next update, along with the number of steps. Over a
+ * window of several update intervals, the cost per step is averaged, and the
+ * skin is then varied by a multiplicative factor. The search proceeds in the
+ * direction of decreasing cost; if neither direction yields a lower cost, the
+ * factor is reduced. The search ends when the factor drops below a threshold
+ * or after a maximum number of trials, and the skin with the lowest cost is
+ * selected.
+ */
+class skin_tuner
+{
+public:
+    /**
+     * @param skin initial skin
+     * @param skin_min lower bound of skin
+     * @param skin_max upper bound of skin
+     * @param window number of update intervals per trial
+     * @param max_trial maximum number of trials
+     */
+    skin_tuner(
+        double skin
+      , double skin_min
+      , double skin_max
+      , unsigned int window
+      , unsigned int max_trial = 20
+    )
+      : skin_(skin)
+      , skin_min_(skin_min)
+      , skin_max_(skin_max)
+      , window_(window)
+      , max_trial_(max_trial)
+      , factor_(1.25)
+      , direction_(1)
+      , nfail_(0)
+      , ntrial_(0)
+      , best_skin_(skin)
+      , best_cost_(-1)
+      , cost_(0)
+      , nstep_(0)
+      , ninterval_(0)
+      , active_(true)
+    {
+        if (!(skin_min > 0 && skin_min <= skin && skin <= skin_max)) {
+            throw std::invalid_argument("neighbour list skin is not within tuning bounds");
+        }
+        if (window == 0) {
+            throw std::invalid_argument("tuning window must comprise at least one update interval");
+        }
+    }
+
+    /**
+     * Record cost of an update interval.
+     *
+     * @param cost runtime of neighbour list update and force computations
+     * @param nstep number of simulation steps in the interval
+     * @returns skin for the next update interval
+     */
+    double sample(double cost, unsigned int nstep)
+    {
+        if (!active_) {
+            return skin_;
+        }
+        cost_ += cost;
+        nstep_ += nstep;
+        if (++ninterval_ < window_ || nstep_ == 0) {
+            return skin_;
+        }
+        double cost_per_step = cost_ / nstep_;
+        cost_ = 0;
+        nstep_ = 0;
+        ninterval_ = 0;
+
+        if (best_cost_ < 0 || cost_per_step < best_cost_) {
+            // proceed in the direction of the improvement
+            best_skin_ = skin_;
+            best_cost_ = cost_per_step;
+            nfail_ = 0;
+        }
+        else {
+            fail_();
+        }
+        propose_();
+        return skin_;
+    }
+
+    /** returns current skin */
+    double skin() const
+    {
+        return skin_;
+    }
+
+    /** returns skin with lowest cost per step measured so far */
+    double best_skin() const
+    {
+        return best_skin_;
+    }
+
+    /** returns lowest cost per step measured so far */
+    double best_cost() const
+    {
+        return best_cost_;
+    }
+
+    /** returns true while the search is in progress */
+    bool active() const
+    {
+        return active_;
+    }
+
+private:
+    /** reverse the direction of search, or shrink the factor after failures in both directions */
+    void fail_()
+    {
+        direction_ = -direction_;
+        if (++nfail_ == 2) {
+            factor_ = std::sqrt(factor_);
+            nfail_ = 0;
+        }
+    }
+
+    /** choose skin of next trial, or finish search */
+    void propose_()
+    {
+        while (active_) {
+            if (factor_ < min_factor || ++ntrial_ > max_trial_) {
+                skin_ = best_skin_;
+                active_ = false;
+                break;
+            }
+            double skin = best_skin_ * (direction_ > 0 ? factor_ : 1 / factor_);
+            skin = std::min(std::max(skin, skin_min_), skin_max_);
+            if (skin != best_skin_) {
+                skin_ = skin;
+                break;
+            }
+            // skip trial at bound of interval
+            fail_();
+        }
+    }
+
+    /** threshold of factor that ends the search */
+    static constexpr double min_factor = 1.02;
+
+    /** current skin */
+    double skin_;
+    /** lower bound of skin */
+    double skin_min_;
+    /** upper bound of skin */
+    double skin_max_;
+    /** number of update intervals per trial */
+    unsigned int window_;
+    /** maximum number of trials */
+    unsigned int max_trial_;
+    /** factor of skin variation */
+    double factor_;
+    /** direction of search, +1 or -1 */
+    int direction_;
+    /** number of unsuccessful trials with current factor */
+    unsigned int nfail_;
+    /** number of trials */
+    unsigned int ntrial_;
+    /** skin with lowest cost */
+    double best_skin_;
+    /** lowest cost per step, negative if not yet measured */
+    double best_cost_;
+    /** accumulated cost within current window */
+    double cost_;
+    /** accumulated steps within current window */
+    unsigned int nstep_;
+    /** number of update intervals within current window */
+    unsigned int ninterval_;
+    /** true while the search is in progress */
+    bool active_;
+};
+
+} // namespace neighbours
+} // namespace host
+} // namespace mdsim
+} // namespace halmd
+
+#endif /* ! HALMD_MDSIM_HOST_NEIGHBOURS_SKIN_TUNER_HPP */
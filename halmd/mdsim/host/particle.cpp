@@ -23,7 +23,6 @@
 
 #include <halmd/config.hpp>
 
-#include <halmd/algorithm/host/permute.hpp>
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/velocity.hpp>
@@ -41,8 +40,10 @@
 
 #include <algorithm>
 #include <exception>
+#include <functional>
 #include <iterator>
 #include <numeric>
+#include <stdexcept>
 
 namespace halmd {
 namespace mdsim {
@@ -61,14 +62,14 @@ particle<dimension, float_type>::particle(size_type nparticle, unsigned int nspe
   , aux_enabled_(true) // enable auxiliary variables by default to allow sampling of initial state
 {
     // register and allocate named particle arrays
-    auto position = make_cache_mutable(register_data<position_type>("position")->mutable_data());
-    auto image = make_cache_mutable(register_data<image_type>("image")->mutable_data());
-    auto velocity = make_cache_mutable(register_data<velocity_type>("velocity")->mutable_data());
+    auto position = make_cache_mutable(register_data<typename position_array_type::value_type>("position")->mutable_data());
+    auto image = make_cache_mutable(register_data<typename image_array_type::value_type>("image")->mutable_data());
+    auto velocity = make_cache_mutable(register_data<typename velocity_array_type::value_type>("velocity")->mutable_data());
     auto id = make_cache_mutable(register_data<id_type>("id")->mutable_data());
     auto reverse_id = make_cache_mutable(register_data<reverse_id_type>("reverse_id")->mutable_data());
     auto species = make_cache_mutable(register_data<species_type>("species")->mutable_data());
     auto mass = make_cache_mutable(register_data<mass_type>("mass")->mutable_data());
-    auto force = make_cache_mutable(register_data<force_type>("force", [this]() { this->update_force_(); })->mutable_data());
+    auto force = make_cache_mutable(register_data<typename force_array_type::value_type>("force", [this]() { this->update_force_(); })->mutable_data());
     auto en_pot = make_cache_mutable(register_data<en_pot_type>("potential_energy", [this]() { this->update_force_(true); })->mutable_data());
     auto stress_pot = make_cache_mutable(
             register_data<stress_pot_type>("potential_stress_tensor", [this]() { this->update_force_(true); })->mutable_data());
@@ -108,28 +109,59 @@ void particle<dimension, float_type>::aux_enable()
 template <int dimension, typename float_type>
 void particle<dimension, float_type>::rearrange(std::vector<unsigned int> const& index)
 {
-    scoped_timer_type timer(runtime_.rearrange);
+    rearrange_(index, [](std::size_t first, std::size_t last, std::function<void (std::size_t, std::size_t)> const& f) {
+        f(first, last);
+    });
+}
 
-    auto position = make_cache_mutable(mutable_data<position_type>("position"));
-    auto image = make_cache_mutable(mutable_data<image_type>("image"));
-    auto velocity = make_cache_mutable(mutable_data<velocity_type>("velocity"));
-    auto id = make_cache_mutable(mutable_data<id_type>("id"));
-    auto reverse_id = make_cache_mutable(mutable_data<reverse_id_type>("reverse_id"));
-    auto species = make_cache_mutable(mutable_data<species_type>("species"));
-    auto mass = make_cache_mutable(mutable_data<mass_type>("mass"));
+template <int dimension, typename float_type>
+void particle<dimension, float_type>::rearrange(std::vector<unsigned int> const& index, utility::thread_pool& pool)
+{
+    rearrange_(index, [&](std::size_t first, std::size_t last, std::function<void (std::size_t, std::size_t)> const& f) {
+        pool.parallel_for(first, last, [&](unsigned int, std::size_t begin, std::size_t end) {
+            f(begin, end);
+        });
+    });
+}
+
+template <int dimension, typename float_type>
+template <typename parallel_for_type>
+void particle<dimension, float_type>::rearrange_(std::vector<unsigned int> const& index, parallel_for_type const& parallel_for)
+{
+    scoped_timer_type timer(runtime_.rearrange);
 
-    permute(position->begin(), position->begin() + nparticle_, index.begin());
-    permute(image->begin(), image->begin() + nparticle_, index.begin());
-    permute(velocity->begin(), velocity->begin() + nparticle_, index.begin());
-    permute(id->begin(), id->begin() + nparticle_, index.begin());
-    permute(species->begin(), species->begin() + nparticle_, index.begin());
-    permute(mass->begin(), mass->begin() + nparticle_, index.begin());
-    // no permutation of forces
+    if (index.size() != nparticle_) {
+        throw std::invalid_argument("index sequence does not match number of particles");
+    }
 
-    // update reverse IDs
-    for (unsigned int i = 0; i < nparticle_; ++i) {
-        (*reverse_id)[(*id)[i]] = i;
+    // no permutation of derived arrays, e.g., forces, and of reverse IDs
+    std::vector<particle_array*> array;
+    for (auto const& pair : data_) {
+        if (!pair.second->derived() && pair.first != "reverse_id") {
+            array.push_back(pair.second.get());
+        }
     }
+    for (particle_array* a : array) {
+        a->begin_gather();
+    }
+    // gather subrange of all arrays in a single pass
+    parallel_for(0, nparticle_, [&](std::size_t first, std::size_t last) {
+        for (particle_array* a : array) {
+            a->gather(index, first, last);
+        }
+    });
+    for (particle_array* a : array) {
+        a->end_gather();
+    }
+
+    // update reverse IDs, which are unique
+    auto const& id = read_cache(data<id_type>("id"));
+    auto reverse_id = make_cache_mutable(mutable_data<reverse_id_type>("reverse_id"));
+    parallel_for(0, nparticle_, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            (*reverse_id)[id[i]] = i;
+        }
+    });
 }
 
 template <int dimension, typename float_type>
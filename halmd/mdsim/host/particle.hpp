@@ -27,10 +27,12 @@
 #include <halmd/mdsim/host/particle_array.hpp>
 #include <halmd/mdsim/type_traits.hpp>
 #include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/numeric/blas/padded_vector.hpp>
 #include <halmd/utility/cache.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/profiler.hpp>
 #include <halmd/utility/raw_array.hpp>
+#include <halmd/utility/thread_pool.hpp>
 
 #include <lua.hpp>
 
@@ -50,6 +52,13 @@ public:
     typedef signal_type::slot_function_type slot_function_type;
 
     typedef fixed_vector<float_type, dimension> vector_type;
+#ifdef USE_HOST_PADDED_VECTOR
+    /** element type of vector arrays, padded to a power-of-two size */
+    typedef padded_vector<float_type, dimension> array_vector_type;
+#else
+    /** element type of vector arrays */
+    typedef vector_type array_vector_type;
+#endif
 
     typedef unsigned int size_type;
     typedef vector_type position_type;
@@ -63,19 +72,32 @@ public:
     typedef float_type en_pot_type;
     typedef typename type_traits<dimension, float_type>::stress_tensor_type stress_pot_type;
 
-    typedef raw_array<position_type> position_array_type;
-    typedef raw_array<image_type> image_array_type;
-    typedef raw_array<velocity_type> velocity_array_type;
+    typedef raw_array<array_vector_type> position_array_type;
+    typedef raw_array<array_vector_type> image_array_type;
+    typedef raw_array<array_vector_type> velocity_array_type;
     typedef raw_array<id_type> id_array_type;
     typedef raw_array<reverse_id_type> reverse_id_array_type;
     typedef raw_array<species_type> species_array_type;
     typedef raw_array<mass_type> mass_array_type;
-    typedef raw_array<force_type> force_array_type;
+    typedef raw_array<array_vector_type> force_array_type;
     typedef raw_array<en_pot_type> en_pot_array_type;
     typedef raw_array<stress_pot_type> stress_pot_array_type;
 
+    /**
+     * Rearrange particles in memory according to an integer index sequence.
+     *
+     * All registered particle arrays are permuted, except for derived
+     * arrays such as the forces and for the reverse IDs, which are updated.
+     */
     void rearrange(std::vector<unsigned int> const& index);
 
+    /**
+     * Rearrange particles in memory using the threads of the given pool.
+     *
+     * Each thread gathers its subrange of all particle arrays at once.
+     */
+    void rearrange(std::vector<unsigned int> const& index, utility::thread_pool& pool);
+
     /**
      * Allocate particle arrays in host memory.
      *
@@ -191,7 +213,7 @@ public:
      */
     cache<position_array_type> const& position() const
     {
-        return data<position_type>("position");
+        return data<typename position_array_type::value_type>("position");
     }
 
     /**
@@ -199,7 +221,7 @@ public:
      */
     cache<position_array_type>& position()
     {
-        return mutable_data<position_type>("position");
+        return mutable_data<typename position_array_type::value_type>("position");
     }
 
     /**
@@ -207,7 +229,7 @@ public:
      */
     cache<image_array_type> const& image() const
     {
-        return data<image_type>("image");
+        return data<typename image_array_type::value_type>("image");
     }
 
     /**
@@ -215,7 +237,7 @@ public:
      */
     cache<image_array_type>& image()
     {
-        return mutable_data<image_type>("image");
+        return mutable_data<typename image_array_type::value_type>("image");
     }
 
     /**
@@ -223,7 +245,7 @@ public:
      */
     cache<velocity_array_type> const& velocity() const
     {
-        return data<velocity_type>("velocity");
+        return data<typename velocity_array_type::value_type>("velocity");
     }
 
     /**
@@ -231,7 +253,7 @@ public:
      */
     cache<velocity_array_type>& velocity()
     {
-        return mutable_data<velocity_type>("velocity");
+        return mutable_data<typename velocity_array_type::value_type>("velocity");
     }
 
     /**
@@ -302,7 +324,7 @@ public:
      */
     cache<force_array_type> const& force()
     {
-        return data<force_type>("force");
+        return data<typename force_array_type::value_type>("force");
     }
 
     /**
@@ -310,7 +332,7 @@ public:
      */
     cache<force_array_type>& mutable_force()
     {
-        return mutable_data<force_type>("force");
+        return mutable_data<typename force_array_type::value_type>("force");
     }
 
     /**
@@ -352,6 +374,15 @@ public:
      */
     void aux_enable();
 
+    /**
+     * Disable computation of auxiliary variables upon the next trigger of
+     * on_force_(), unless they are read.
+     */
+    void aux_disable()
+    {
+        aux_enabled_ = false;
+    }
+
     /**
      * Returns true if computation of auxiliary variables is enabled.
      */
@@ -464,6 +495,13 @@ private:
      */
     void update_force_(bool with_aux=false);
 
+    /**
+     * Permute particle arrays, where parallel_for(first, last, f) invokes
+     * f(begin, end) for disjoint subranges covering [first, last).
+     */
+    template <typename parallel_for_type>
+    void rearrange_(std::vector<unsigned int> const& index, parallel_for_type const& parallel_for);
+
     typedef utility::profiler::accumulator_type accumulator_type;
     typedef utility::profiler::scoped_timer_type scoped_timer_type;
 
@@ -487,7 +525,7 @@ template <typename particle_type, typename iterator_type>
 inline iterator_type
 get_position(particle_type const& particle, iterator_type const& first)
 {
-    return particle.template get_data<typename particle_type::position_type>("position", first);
+    return particle.template get_data<typename particle_type::position_array_type::value_type>("position", first);
 }
 
 /**
@@ -497,7 +535,7 @@ template <typename particle_type, typename iterator_type>
 inline iterator_type
 set_position(particle_type& particle, iterator_type const& first)
 {
-    return particle.template set_data<typename particle_type::position_type>("position", first);
+    return particle.template set_data<typename particle_type::position_array_type::value_type>("position", first);
 }
 
 /**
@@ -507,7 +545,7 @@ template <typename particle_type, typename iterator_type>
 inline iterator_type
 get_image(particle_type const& particle, iterator_type const& first)
 {
-    return particle.template get_data<typename particle_type::image_type>("image", first);
+    return particle.template get_data<typename particle_type::image_array_type::value_type>("image", first);
 }
 
 /**
@@ -517,7 +555,7 @@ template <typename particle_type, typename iterator_type>
 inline iterator_type
 set_image(particle_type& particle, iterator_type const& first)
 {
-    return particle.template set_data<typename particle_type::image_type>("image", first);
+    return particle.template set_data<typename particle_type::image_array_type::value_type>("image", first);
 }
 
 /**
@@ -527,7 +565,7 @@ template <typename particle_type, typename iterator_type>
 inline iterator_type
 get_velocity(particle_type const& particle, iterator_type const& first)
 {
-    return particle.template get_data<typename particle_type::velocity_type>("velocity", first);
+    return particle.template get_data<typename particle_type::velocity_array_type::value_type>("velocity", first);
 }
 
 /**
@@ -537,7 +575,7 @@ template <typename particle_type, typename iterator_type>
 inline iterator_type
 set_velocity(particle_type& particle, iterator_type const& first)
 {
-    return particle.template set_data<typename particle_type::velocity_type>("velocity", first);
+    return particle.template set_data<typename particle_type::velocity_array_type::value_type>("velocity", first);
 }
 
 /**
@@ -627,7 +665,7 @@ template <typename particle_type, typename iterator_type>
 inline iterator_type
 get_force(particle_type& particle, iterator_type const& first)
 {
-    return particle.template get_data<typename particle_type::force_type>("force", first);
+    return particle.template get_data<typename particle_type::force_array_type::value_type>("force", first);
 }
 
 /**
@@ -21,9 +21,13 @@
 #ifndef HALMD_MDSIM_HOST_PARTICLE_ARRAY_HPP
 #define HALMD_MDSIM_HOST_PARTICLE_ARRAY_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <typeinfo>
+#include <vector>
 #include <halmd/utility/cache.hpp>
 #include <halmd/utility/lua/lua.hpp>
+#include <halmd/utility/raw_array.hpp>
 #include <halmd/utility/signal.hpp>
 
 namespace halmd {
@@ -97,6 +101,40 @@ public:
      * @return lua table containing a copy of the data
      */
     virtual luaponte::object get_lua(lua_State* L) const = 0;
+
+    /**
+     * query whether the data are derived by an update function
+     *
+     * Derived data, e.g., the forces, are recomputed on demand and thus
+     * need not be permuted upon rearrangement of the particles.
+     */
+    virtual bool derived() const = 0;
+
+    /**
+     * prepare scratch buffer for permutation of the data
+     *
+     * Must be called before gather(), it is not thread-safe.
+     */
+    virtual void begin_gather() = 0;
+
+    /**
+     * gather permuted data into scratch buffer
+     *
+     * @param index integer index sequence of the permutation
+     * @param first first particle of the range to be gathered
+     * @param last end of the range to be gathered
+     *
+     * Assigns element index[i] of the data to element i of the scratch buffer
+     * for i ∈ [first, last). Disjoint ranges may be gathered concurrently.
+     */
+    virtual void gather(std::vector<unsigned int> const& index, std::size_t first, std::size_t last) = 0;
+
+    /**
+     * replace data by the scratch buffer after all ranges have been gathered
+     *
+     * The previous data are kept as scratch buffer for the next permutation.
+     */
+    virtual void end_gather() = 0;
 };
 
 template<typename T>
@@ -114,6 +152,7 @@ public:
     , unsigned int size
     , std::function<void()> update_function = std::function<void()>())
       : nparticle_(nparticle), data_(size), update_function_(update_function)
+      , derived_(static_cast<bool>(update_function))
     {
         if (!update_function_) {
             update_function_ = [](){};
@@ -210,6 +249,48 @@ public:
         }
         return table;
     }
+
+    /**
+     * query whether the data are derived by an update function
+     */
+    virtual bool derived() const
+    {
+        return derived_;
+    }
+
+    /**
+     * prepare scratch buffer for permutation of the data
+     *
+     * The scratch buffer is allocated upon first use. Elements beyond the
+     * number of particles are copied as they are not subject to permutation.
+     */
+    virtual void begin_gather()
+    {
+        auto const& input = read_cache(data_);
+        scratch_.resize(input.size());
+        std::copy(input.begin() + nparticle_, input.end(), scratch_.begin() + nparticle_);
+    }
+
+    /**
+     * gather permuted data into scratch buffer
+     */
+    virtual void gather(std::vector<unsigned int> const& index, std::size_t first, std::size_t last)
+    {
+        auto const& input = read_cache(data_);
+        for (std::size_t i = first; i < last; ++i) {
+            scratch_[i] = input[index[i]];
+        }
+    }
+
+    /**
+     * replace data by the scratch buffer
+     */
+    virtual void end_gather()
+    {
+        auto output = make_cache_mutable(data_);
+        output->swap(scratch_);
+    }
+
 private:
     /** number of particles */
     unsigned int nparticle_;
@@ -217,6 +298,10 @@ private:
     cache<raw_array<T>> data_;
     /** optional update function */
     std::function<void()> update_function_;
+    /** flag that the data are derived by the update function */
+    bool derived_;
+    /** scratch buffer for permutation, reused between rearrangements */
+    raw_array<T> scratch_;
 };
 
 template<typename T>
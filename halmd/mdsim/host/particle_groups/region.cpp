@@ -28,6 +28,10 @@
 #include <halmd/utility/lua/lua.hpp>
 
 #include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
 
 namespace halmd {
 namespace mdsim {
@@ -39,15 +43,120 @@ region<dimension, float_type, geometry_type>::region(
     std::shared_ptr<particle_type const> particle
   , std::shared_ptr<geometry_type const> geometry
   , geometry_selection geometry_sel
+  , std::shared_ptr<binning_type const> binning
+  , std::shared_ptr<displacement_type> displacement
   , std::shared_ptr<logger> logger
 )
   : particle_(particle)
   , geometry_(geometry)
   , geometry_selection_(geometry_sel)
+  , binning_(binning)
+  , displacement_(displacement)
   , logger_(logger)
+  , cells_complete_(false)
+  , from_cells_(false)
   , mask_(particle->nparticle())
 {
+    if (!binning_ != !displacement_) {
+        throw std::invalid_argument("region selection by cells requires both binning and displacement modules");
+    }
     geometry_->log(logger_);
+    if (binning_) {
+        classify_cells_();
+    }
+}
+
+/**
+ * Classify the cells of the binning module by their location relative to
+ * the selected region.
+ *
+ * A cell with index k along a given axis holds the positions in the interval
+ * [k a, (k + 1) a) modulo the box length L, where a denotes the edge length
+ * of the cells. The interval is widened by half of the skin, which bounds the
+ * displacement of the particles until the cell lists are rebuilt, and by a
+ * small fraction of the cell length to account for rounding in the
+ * computation of the cell index. As the positions are folded to [-L/2, L/2],
+ * a cell may comprise several pieces.
+ */
+template <int dimension, typename float_type, typename geometry_type>
+void region<dimension, float_type, geometry_type>::classify_cells_()
+{
+    typedef typename binning_type::cell_size_type cell_size_type;
+    typedef std::pair<float_type, float_type> interval_type;
+
+    cell_size_type const ncell = binning_->ncell();
+    vector_type const cell_length = binning_->cell_length();
+
+    // pieces of cells along each axis
+    std::vector<std::vector<interval_type>> piece[dimension];
+    for (int j = 0; j < dimension; ++j) {
+        float_type const a = cell_length[j];
+        float_type const L = a * ncell[j];
+        float_type const delta = a * float_type(1e-3);
+        float_type const margin = binning_->r_skin() / 2 + delta;
+        piece[j].resize(ncell[j]);
+        for (size_type k = 0; k < ncell[j]; ++k) {
+            for (int m = -1; m <= 1; ++m) {
+                float_type lower = std::max(k * a + m * L - margin, -L / 2 - delta);
+                float_type upper = std::min((k + 1) * a + m * L + margin, L / 2 + delta);
+                if (lower <= upper) {
+                    piece[j][k].push_back(interval_type(lower, upper));
+                }
+            }
+        }
+    }
+
+    std::size_t const size = std::accumulate(ncell.begin(), ncell.end(), std::size_t(1), std::multiplies<std::size_t>());
+    cell_location_.resize(size);
+    std::size_t count[3] = {0, 0, 0};
+
+    for (std::size_t c = 0; c < size; ++c) {
+        // multi-dimensional cell index in row-major storage order
+        cell_size_type index;
+        std::size_t offset = c;
+        for (int j = dimension - 1; j >= 0; --j) {
+            index[j] = offset % ncell[j];
+            offset /= ncell[j];
+        }
+
+        // test all combinations of pieces
+        bool all_inside = true;
+        bool all_outside = true;
+        cell_size_type choice(0);
+        for (;;) {
+            vector_type lower, upper;
+            for (int j = 0; j < dimension; ++j) {
+                interval_type const& p = piece[j][index[j]][choice[j]];
+                lower[j] = p.first;
+                upper[j] = p.second;
+            }
+            if (!geometry_->contains(lower, upper)) {
+                all_inside = false;
+            }
+            if (geometry_->overlaps(lower, upper)) {
+                all_outside = false;
+            }
+            // advance to the next combination
+            int j = 0;
+            while (j < dimension && ++choice[j] == piece[j][index[j]].size()) {
+                choice[j++] = 0;
+            }
+            if (j == dimension) {
+                break;
+            }
+        }
+
+        cell_location location = all_inside ? inside : (all_outside ? outside : boundary);
+        if (geometry_selection_ == excluded && location != boundary) {
+            location = (location == inside) ? outside : inside;
+        }
+        cell_location_[c] = location;
+        ++count[location];
+    }
+
+    LOG("select particles by cells (inside / boundary / outside): "
+        << count[inside] << " / " << count[boundary] << " / " << count[outside]
+    );
 }
 
 /**
@@ -80,13 +189,137 @@ void region<dimension, float_type, geometry_type>::update_()
             }
         }
         mask_cache_ = position_cache;
+        from_cells_ = false;
+    }
+}
+
+/**
+ * The cell lists are valid if no particle has moved farther than half of the
+ * skin since their last update, and if the particles have not been reordered
+ * in the meantime.
+ */
+template <int dimension, typename float_type, typename geometry_type>
+bool region<dimension, float_type, geometry_type>::cells_valid_()
+{
+    if (displacement_->compute() > binning_->r_skin() / 2) {
+        return false;
+    }
+    auto const& cell_cache = binning_->last_cell();
+    if (cell_cache != cell_cache_) {
+        assign_cells_();
+        cell_cache_ = cell_cache;
+        reverse_id_cache_ = particle_->reverse_id();
     }
+    return cells_complete_ && reverse_id_cache_ == particle_->reverse_id();
 }
+
+/**
+ * Collect the particles of inside and boundary cells from the cell lists,
+ * which are read without binning the particles.
+ */
+template <int dimension, typename float_type, typename geometry_type>
+void region<dimension, float_type, geometry_type>::assign_cells_()
+{
+    auto const& cell = read_cache(binning_->last_cell());
+
+    LOG_DEBUG("assign particles of inside and boundary cells");
+    scoped_timer_type timer(runtime_.update_mask);
+
+    inside_.clear();
+    boundary_.clear();
+    std::size_t count = 0;
+    auto const* cell_list = cell.data();
+    for (std::size_t c = 0; c < cell_location_.size(); ++c) {
+        count += cell_list[c].size();
+        if (cell_location_[c] == inside) {
+            inside_.insert(inside_.end(), cell_list[c].begin(), cell_list[c].end());
+        }
+        else if (cell_location_[c] == boundary) {
+            boundary_.insert(boundary_.end(), cell_list[c].begin(), cell_list[c].end());
+        }
+    }
+    // order by particle index instead of the order of the cells
+    std::sort(inside_.begin(), inside_.end());
+    std::sort(boundary_.begin(), boundary_.end());
+
+    // the cell lists are empty if the particles have never been binned
+    cells_complete_ = (count == particle_->nparticle());
+    from_cells_ = false;
+}
+
+/**
+ * update the mask and the selection from the cell lists, testing only
+ * particles in boundary cells
+ *
+ * Mask and selection are modified only if the selected particles of the
+ * boundary cells have changed, in which case the selection is merged from
+ * those and the particles of inside cells.
+ */
+template <int dimension, typename float_type, typename geometry_type>
+void region<dimension, float_type, geometry_type>::update_from_cells_()
+{
+    auto const& position_cache = particle_->position();
+
+    if (position_cache != mask_cache_) {
+        auto const& position = read_cache(position_cache);
+
+        LOG_DEBUG("update selection for region from cell lists");
+        scoped_timer_type timer(runtime_.update_selection);
+
+        hit_prev_.swap(hit_);
+        hit_.clear();
+        for (size_type i : boundary_) {
+            bool in_geometry = (*geometry_)(position[i]);
+            if (geometry_selection_ == excluded) {
+                in_geometry = !in_geometry;
+            }
+            if (in_geometry) {
+                hit_.push_back(i);
+            }
+        }
+
+        if (!from_cells_ || hit_ != hit_prev_) {
+            auto mask = make_cache_mutable(mask_);
+            if (!from_cells_) {
+                std::fill(mask->begin(), mask->end(), 0);
+                for (size_type i : inside_) {
+                    (*mask)[i] = 1;
+                }
+            }
+            else {
+                for (size_type i : hit_prev_) {
+                    (*mask)[i] = 0;
+                }
+            }
+            for (size_type i : hit_) {
+                (*mask)[i] = 1;
+            }
+
+            auto selection = make_cache_mutable(selection_);
+            selection->resize(inside_.size() + hit_.size());
+            std::merge(inside_.begin(), inside_.end(), hit_.begin(), hit_.end(), selection->begin());
+            from_cells_ = true;
+        }
+        mask_cache_ = position_cache;
+    }
+}
+
+/**
+ * The cell lists are used whenever they are valid for the current positions.
+ * They are read as of their last update by the neighbour lists, since binning
+ * the particles is more expensive than testing all particles against the
+ * geometry, which is done otherwise.
+ */
 template <int dimension, typename float_type, typename geometry_type>
 cache<typename region<dimension, float_type, geometry_type>::array_type> const&
 region<dimension, float_type, geometry_type>::selection()
 {
-    update_();
+    if (binning_ && cells_valid_()) {
+        update_from_cells_();
+    }
+    else {
+        update_();
+    }
     return selection_;
 }
 
@@ -94,7 +327,7 @@ template <int dimension, typename float_type, typename geometry_type>
 cache<typename region<dimension, float_type, geometry_type>::array_type> const&
 region<dimension, float_type, geometry_type>::mask()
 {
-    update_();
+    selection();
     return mask_;
 }
 
@@ -154,6 +387,17 @@ static void wrap_to_particle(
     particle_group_to_particle(*particle_src, *self, *particle_dst);
 }
 
+template <typename region_type, typename particle_type, typename geometry_type>
+static std::shared_ptr<region_type> wrap_region(
+    std::shared_ptr<particle_type const> particle
+  , std::shared_ptr<geometry_type const> geometry
+  , typename region_type::geometry_selection geometry_sel
+  , std::shared_ptr<logger> logger
+)
+{
+    return std::make_shared<region_type>(particle, geometry, geometry_sel, nullptr, nullptr, logger);
+}
+
 template <int dimension, typename float_type, typename geometry_type>
 void region<dimension, float_type, geometry_type>::luaopen(lua_State* L)
 {
@@ -175,10 +419,13 @@ void region<dimension, float_type, geometry_type>::luaopen(lua_State* L)
                     .def_readonly("runtime", &region::runtime_)
                     .def("to_particle", &wrap_to_particle<region<dimension, float_type, geometry_type>, particle_type>)
 
+              , def("region", &wrap_region<region, particle_type, geometry_type>)
               , def("region", &std::make_shared<region<dimension, float_type, geometry_type>
                   , std::shared_ptr<particle_type const>
                   , std::shared_ptr<geometry_type const>
                   , geometry_selection
+                  , std::shared_ptr<binning_type const>
+                  , std::shared_ptr<displacement_type>
                   , std::shared_ptr<logger>
                 >)
             ]
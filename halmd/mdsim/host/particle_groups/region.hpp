@@ -22,11 +22,14 @@
 #define HALMD_MDSIM_HOST_PARTICLE_GROUPS_REGION_HPP
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/binning.hpp>
+#include <halmd/mdsim/host/max_displacement.hpp>
 #include <halmd/mdsim/host/particle_group.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 
 #include <lua.hpp>
 #include <memory>
+#include <vector>
 
 namespace halmd {
 namespace mdsim {
@@ -35,6 +38,22 @@ namespace particle_groups {
 
 /**
  * Select particles of a given particle instance by simulation box region
+ *
+ * If a binning module is given, its cells are classified once with respect
+ * to the geometry as lying entirely inside, entirely outside, or at the
+ * boundary of the region, where each cell is widened by half of the skin.
+ * The binning module and the maximum displacement module must be those of
+ * the neighbour lists, which rebuild the cell lists before any particle has
+ * moved farther than half of the skin. Thus the particles of an inside
+ * (outside) cell remain inside (outside) the region until the next rebuild,
+ * and the cell lists are read only after a rebuild, without binning the
+ * particles. Upon a position update, only the particles of boundary cells are
+ * tested against the geometry, and the selection is merged from the
+ * particles of inside cells and the selected particles of boundary cells
+ * only if the latter have changed. If the cell lists are not valid for the
+ * current positions, e.g., if the particles have been reordered, the group
+ * falls back to testing all particles. In both cases, the selection is
+ * ordered by particle indices.
  */
 template <int dimension, typename float_type, typename geometry_type>
 class region
@@ -45,6 +64,8 @@ public:
     typedef typename particle_group::size_type size_type;
     typedef host::particle<dimension, float_type> particle_type;
     typedef typename particle_type::vector_type vector_type;
+    typedef host::binning<dimension, float_type> binning_type;
+    typedef host::max_displacement<dimension, float_type> displacement_type;
 
     enum geometry_selection {
         excluded = 1
@@ -58,6 +79,8 @@ public:
         std::shared_ptr<particle_type const> particle
       , std::shared_ptr<geometry_type const> geometry
       , geometry_selection geometry_sel
+      , std::shared_ptr<binning_type const> binning = nullptr
+      , std::shared_ptr<displacement_type> displacement = nullptr
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
@@ -97,13 +120,49 @@ private:
     typedef typename particle_type::position_array_type position_array_type;
     typedef typename particle_type::position_type position_type;
 
+    /** relation of a binning cell to the region */
+    enum cell_location {
+        outside = 0
+      , boundary = 1
+      , inside = 2
+    };
+
     void update_();
+    /** classify cells of binning module */
+    void classify_cells_();
+    /** returns true if the cell lists are valid for the current positions */
+    bool cells_valid_();
+    /** collect particles of inside and boundary cells after a rebuild */
+    void assign_cells_();
+    /** update mask and selection from cell lists */
+    void update_from_cells_();
 
     /** particle instance */
     std::shared_ptr<particle_type const> particle_;
     /** region the particles are sorted by */
     std::shared_ptr<geometry_type const> geometry_;
     geometry_selection geometry_selection_;
+    /** optional binning module */
+    std::shared_ptr<binning_type const> binning_;
+    /** maximum displacement since the last rebuild of the cell lists */
+    std::shared_ptr<displacement_type> displacement_;
+    /** location of each cell with respect to the selected region */
+    std::vector<unsigned char> cell_location_;
+    /** ascending indices of particles in inside cells */
+    std::vector<size_type> inside_;
+    /** ascending indices of particles in boundary cells */
+    std::vector<size_type> boundary_;
+    /** selected particles of boundary cells, and those of the previous update */
+    std::vector<size_type> hit_;
+    std::vector<size_type> hit_prev_;
+    /** true if the cell lists contain all particles */
+    bool cells_complete_;
+    /** true if mask and selection were last updated from the cell lists */
+    bool from_cells_;
+    /** cache observer of cell lists */
+    cache<> cell_cache_;
+    /** cache observer of particle order at the last rebuild of the cell lists */
+    cache<> reverse_id_cache_;
     /** module logger */
     std::shared_ptr<logger> logger_;
 
@@ -115,7 +174,7 @@ private:
     cache<array_type> mask_;
     /** particle indices of particles in the region */
     cache<array_type> selection_;
-    /** cache observer of position updates for mask */
+    /** cache observer of position updates for mask and selection */
     cache<> mask_cache_;
 
     /** ordered sequence of particle indices */
@@ -27,6 +27,7 @@
 #include <memory>
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/matrix_shape.hpp>
 
@@ -47,6 +48,7 @@ class hard_core
 public:
     typedef typename potential_type::float_type float_type;
     typedef typename potential_type::matrix_type matrix_type;
+    typedef typename potential_type::batch_type batch_type;
 
     template<typename... Args>
     hard_core(matrix_type const& core, Args&&... args)
@@ -72,6 +74,12 @@ public:
         return make_tuple(f_abs, en_pot);
     }
 
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        evaluate_pairwise(*this, pairs);
+    }
+
     /**
      * Bind class to Lua.
      */
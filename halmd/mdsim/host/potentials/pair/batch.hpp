@@ -0,0 +1,103 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_MDSIM_HOST_POTENTIALS_PAIR_BATCH_HPP
+#define HALMD_MDSIM_HOST_POTENTIALS_PAIR_BATCH_HPP
+
+#include <tuple>
+
+namespace halmd {
+namespace mdsim {
+namespace host {
+namespace potentials {
+namespace pair {
+
+/**
+ * Batch of particle pairs for vectorised evaluation of a pair potential
+ *
+ * The pairs of a batch share the first particle, and thus its species 'a'.
+ * The squared distances and the species of the second particles are stored
+ * in contiguous arrays, which allows the compiler to evaluate the potential
+ * for several pairs with a single SIMD instruction.
+ *
+ * A pair potential provides the batched evaluation as an overload
+ *
+ *   void operator()(batch<float_type>& batch) const;
+ *
+ * which computes 'fval' and 'en_pot' for the first 'size' pairs, i.e.,
+ * the same quantities as the scalar operator() for a single pair.
+ */
+template <typename float_type>
+struct batch
+{
+    /** maximum number of pairs in a batch */
+    static constexpr unsigned int capacity = 32;
+
+    /** number of pairs in the batch */
+    unsigned int size;
+    /** species of the first particle */
+    unsigned int a;
+    /** species of the second particles */
+    unsigned int b[capacity];
+    /** squared distances */
+    float_type rr[capacity];
+    /** unit "force" @f$ -U'(r)/r @f$ */
+    float_type fval[capacity];
+    /** potential @f$ U(r) @f$ */
+    float_type en_pot[capacity];
+};
+
+template <typename float_type>
+constexpr unsigned int batch<float_type>::capacity;
+
+/**
+ * Evaluate pair potential for a batch pair by pair.
+ *
+ * This is the fallback for potentials without a vectorised implementation.
+ */
+template <typename potential_type, typename float_type>
+inline void evaluate_pairwise(potential_type const& potential, batch<float_type>& batch)
+{
+    for (unsigned int k = 0; k < batch.size; ++k) {
+        std::tie(batch.fval[k], batch.en_pot[k]) = potential(batch.rr[k], batch.a, batch.b[k]);
+    }
+}
+
+/**
+ * Gather pair parameters of a batch from a matrix of parameters.
+ *
+ * The parameters are copied to a contiguous array, which avoids gather
+ * instructions in the subsequent vectorised evaluation.
+ */
+template <typename matrix_type, typename float_type, typename value_type>
+inline void gather(matrix_type const& param, batch<float_type> const& batch, value_type* value)
+{
+    for (unsigned int k = 0; k < batch.size; ++k) {
+        value[k] = param(batch.a, batch.b[k]);
+    }
+}
+
+} // namespace pair
+} // namespace potentials
+} // namespace host
+} // namespace mdsim
+} // namespace halmd
+
+#endif /* ! HALMD_MDSIM_HOST_POTENTIALS_PAIR_BATCH_HPP */
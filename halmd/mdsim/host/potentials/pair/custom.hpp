@@ -27,6 +27,7 @@
 #include <memory>
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
 
 namespace halmd {
 namespace mdsim {
@@ -43,6 +44,7 @@ class custom
 public:
     typedef float_type_ float_type;
     typedef boost::numeric::ublas::matrix<float_type> matrix_type;
+    typedef pair::batch<float_type> batch_type;
 
     // FIXME rename param[2-3] to sensible identifiers for
     // the parameters of the custom potential
@@ -73,6 +75,12 @@ public:
         return std::make_tuple(fval, en_pot);
     }
 
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        evaluate_pairwise(*this, pairs);
+    }
+
     matrix_type const& sigma() const
     {
         return sigma_;
@@ -29,6 +29,7 @@
 #include <memory>
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
 
 namespace halmd {
 namespace mdsim {
@@ -45,6 +46,7 @@ class lennard_jones
 public:
     typedef float_type_ float_type;
     typedef boost::numeric::ublas::matrix<float_type> matrix_type;
+    typedef pair::batch<float_type> batch_type;
 
     lennard_jones(
         matrix_type const& epsilon
@@ -65,6 +67,23 @@ public:
         return std::make_tuple(fval, en_pot);
     }
 
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        float_type sigma2[batch_type::capacity];
+        float_type epsilon[batch_type::capacity];
+        gather(sigma2_, pairs, sigma2);
+        gather(epsilon_, pairs, epsilon);
+
+        for (unsigned int k = 0; k < pairs.size; ++k) {
+            float_type rri = sigma2[k] / pairs.rr[k];
+            float_type r6i = rri * rri * rri;
+            float_type eps_r6i = epsilon[k] * r6i;
+            pairs.fval[k] = 48 * rri * eps_r6i * (r6i - float_type(0.5)) / sigma2[k];
+            pairs.en_pot[k] = 4 * eps_r6i * (r6i - 1);
+        }
+    }
+
     matrix_type const& epsilon() const
     {
         return epsilon_;
@@ -24,10 +24,12 @@
 
 #include <boost/numeric/ublas/matrix.hpp>
 #include <lua.hpp>
+#include <algorithm>
 #include <tuple>
 #include <memory>
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
 
 namespace halmd {
 namespace mdsim {
@@ -50,6 +52,7 @@ public:
     typedef float_type_ float_type;
     typedef boost::numeric::ublas::matrix<float_type> matrix_type;
     typedef boost::numeric::ublas::matrix<unsigned> uint_matrix_type;
+    typedef pair::batch<float_type> batch_type;
 
     mie(
         matrix_type const& epsilon
@@ -84,6 +87,37 @@ public:
         return std::make_tuple(fval, en_pot);
     }
 
+    /** compute potential and its derivatives for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        float_type sigma2[batch_type::capacity];
+        float_type epsilon_C[batch_type::capacity];
+        unsigned int m_2[batch_type::capacity];
+        unsigned int n_2[batch_type::capacity];
+        gather(sigma2_, pairs, sigma2);
+        gather(epsilon_C_, pairs, epsilon_C);
+        gather(index_m_2_, pairs, m_2);
+        gather(index_n_2_, pairs, n_2);
+
+        float_type rri[batch_type::capacity];
+        unsigned int mn_2[batch_type::capacity];
+        for (unsigned int k = 0; k < pairs.size; ++k) {
+            rri[k] = sigma2[k] / pairs.rr[k];
+            mn_2[k] = m_2[k] - n_2[k];
+        }
+
+        float_type rni[batch_type::capacity];
+        float_type rmni[batch_type::capacity];
+        pow_(rri, n_2, rni, pairs.size);
+        pow_(rri, mn_2, rmni, pairs.size);
+
+        for (unsigned int k = 0; k < pairs.size; ++k) {
+            float_type eps_rni = epsilon_C[k] * rni[k];
+            pairs.fval[k] = 2 * rri[k] * eps_rni * (m_2[k] * rmni[k] - n_2[k]) / sigma2[k];
+            pairs.en_pot[k] = eps_rni * (rmni[k] - 1);
+        }
+    }
+
     matrix_type const& epsilon() const
     {
         return epsilon_;
@@ -120,6 +154,29 @@ public:
     static void luaopen(lua_State* L);
 
 private:
+    /**
+     * Compute integer powers y = x^n of a batch by binary exponentiation.
+     *
+     * The number of squarings is that of the largest exponent for all
+     * elements, which allows vectorisation over the elements.
+     */
+    static void pow_(float_type const* x, unsigned int const* n, float_type* y, unsigned int size)
+    {
+        float_type x_2k[batch_type::capacity];
+        unsigned int n_max = 0;
+        for (unsigned int k = 0; k < size; ++k) {
+            x_2k[k] = x[k];
+            y[k] = 1;
+            n_max = std::max(n_max, n[k]);
+        }
+        for (unsigned int bit = 1; bit <= n_max; bit <<= 1) {
+            for (unsigned int k = 0; k < size; ++k) {
+                y[k] = (n[k] & bit) ? y[k] * x_2k[k] : y[k];
+                x_2k[k] *= x_2k[k];
+            }
+        }
+    }
+
     /** potential well depths in MD units */
     matrix_type epsilon_;
     /** potential well depths times prefactor C(m,n) */
@@ -28,6 +28,7 @@
 #include <memory>
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
 
 namespace halmd {
 namespace mdsim {
@@ -44,6 +45,7 @@ class morse
 public:
     typedef float_type_ float_type;
     typedef boost::numeric::ublas::matrix<float_type> matrix_type;
+    typedef pair::batch<float_type> batch_type;
 
     morse(
         matrix_type const& epsilon
@@ -77,6 +79,12 @@ public:
         return std::make_tuple(fval, en_pot);
     }
 
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        evaluate_pairwise(*this, pairs);
+    }
+
     matrix_type const& epsilon() const
     {
         return epsilon_;
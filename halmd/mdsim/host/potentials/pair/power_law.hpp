@@ -28,6 +28,7 @@
 #include <memory>
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
 #include <halmd/numeric/pow.hpp>
 
 namespace halmd {
@@ -49,6 +50,7 @@ public:
     typedef float_type_ float_type;
     typedef boost::numeric::ublas::matrix<float_type> matrix_type;
     typedef boost::numeric::ublas::matrix<unsigned int> uint_matrix_type;
+    typedef pair::batch<float_type> batch_type;
 
     power_law(
         matrix_type const& epsilon
@@ -140,6 +142,12 @@ public:
         }
     }
 
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        evaluate_pairwise(*this, pairs);
+    }
+
     matrix_type const& epsilon() const
     {
         return epsilon_;
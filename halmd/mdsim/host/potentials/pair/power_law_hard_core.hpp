@@ -40,6 +40,7 @@ class hard_core<power_law<float_type_>> : public power_law<float_type_>
 public:
     typedef float_type_ float_type;
     typedef typename power_law<float_type>::matrix_type matrix_type;
+    typedef typename power_law<float_type>::batch_type batch_type;
 
     template<typename... Args>
     hard_core(matrix_type const& core, Args&&... args)
@@ -136,6 +137,13 @@ public:
                 return impl_<0>(rr, a, b);
         }
     }
+
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        evaluate_pairwise(*this, pairs);
+    }
+
     /**
      * Bind class to Lua.
      */
@@ -0,0 +1,282 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/numeric/ublas/io.hpp>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/forces/pair_full.hpp>
+#include <halmd/mdsim/host/forces/pair_trunc.hpp>
+#include <halmd/mdsim/host/potentials/pair/adapters/hard_core.hpp>
+#include <halmd/mdsim/host/potentials/pair/lennard_jones.hpp>
+#include <halmd/mdsim/host/potentials/pair/mie.hpp>
+#include <halmd/mdsim/host/potentials/pair/morse.hpp>
+#include <halmd/mdsim/host/potentials/pair/power_law.hpp>
+#include <halmd/mdsim/host/potentials/pair/tabulated.hpp>
+#include <halmd/mdsim/host/potentials/pair/truncations/truncations.hpp>
+#include <halmd/utility/lua/lua.hpp>
+#include <halmd/utility/matrix_shape.hpp>
+
+using namespace boost::numeric::ublas;
+using namespace std;
+
+namespace halmd {
+namespace mdsim {
+namespace host {
+namespace potentials {
+namespace pair {
+
+/**
+ * Compute derivatives dU/dt at the grid nodes of a natural cubic spline
+ * through the values U, where t is the position in units of the grid spacing.
+ */
+template <typename float_type>
+static std::vector<float_type> spline_derivative(std::vector<float_type> const& u)
+{
+    std::size_t n = u.size() - 1;
+    std::vector<float_type> d(n + 1);
+    if (n == 1) {
+        d[0] = d[1] = u[1] - u[0];
+        return d;
+    }
+
+    // solve M[i-1] + 4 M[i] + M[i+1] = 6 (U[i+1] - 2 U[i] + U[i-1])
+    // for the second derivatives with M[0] = M[n] = 0 (Thomas algorithm)
+    std::vector<float_type> m(n + 1, 0);
+    std::vector<float_type> c(n + 1, 0);
+    for (std::size_t i = 1; i < n; ++i) {
+        float_type denom = 4 - c[i - 1];
+        c[i] = 1 / denom;
+        m[i] = (6 * (u[i + 1] - 2 * u[i] + u[i - 1]) - m[i - 1]) / denom;
+    }
+    for (std::size_t i = n - 1; i > 0; --i) {
+        m[i] -= c[i] * m[i + 1];
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        d[i] = (u[i + 1] - u[i]) - (2 * m[i] + m[i + 1]) / 6;
+    }
+    d[n] = (u[n] - u[n - 1]) + (m[n - 1] + 2 * m[n]) / 6;
+    return d;
+}
+
+/**
+ * Initialise tabulated potential from node values
+ */
+template <typename float_type>
+tabulated<float_type>::tabulated(
+    matrix_type const& sigma
+  , matrix_type const& r_min
+  , matrix_type const& r_max
+  , table_type const& energy
+  , table_type const& force
+  , std::shared_ptr<logger> logger
+)
+  // allocate potential parameters
+  : sigma_(sigma)
+  , r_min_(check_shape(r_min, sigma))
+  , r_max_(check_shape(r_max, sigma))
+  , rr_min_(element_prod(r_min_, r_min_))
+  , rr_max_(element_prod(r_max_, r_max_))
+  , drr_inv_(size1(), size2())
+  , offset_(size1(), size2())
+  , ninterval_(size1(), size2())
+  , logger_(logger)
+{
+    LOG("interaction range: σ = " << sigma_);
+    LOG("lower bound of table: r_min = " << r_min_);
+    LOG("upper bound of table: r_max = " << r_max_);
+
+    unsigned int ntype2 = size2();
+    if (energy.size() != size1() * ntype2) {
+        throw std::invalid_argument("number of potential tables does not match number of species pairs");
+    }
+    if (!force.empty() && force.size() != energy.size()) {
+        throw std::invalid_argument("number of force tables does not match number of species pairs");
+    }
+
+    std::size_t ncoefficient = 0;
+    for (unsigned int a = 0; a < size1(); ++a) {
+        for (unsigned int b = 0; b < ntype2; ++b) {
+            std::vector<float_type> const& u = energy[a * ntype2 + b];
+            if (u.size() < 2) {
+                throw std::invalid_argument("tabulated potential requires at least 2 grid points");
+            }
+            if (!force.empty() && force[a * ntype2 + b].size() != u.size()) {
+                throw std::invalid_argument("force and potential tables differ in length");
+            }
+            if (!(r_min_(a, b) >= 0 && r_max_(a, b) > r_min_(a, b))) {
+                throw std::invalid_argument("invalid range of tabulated potential");
+            }
+            offset_(a, b) = ncoefficient;
+            ninterval_(a, b) = u.size() - 1;
+            drr_inv_(a, b) = ninterval_(a, b) / (rr_max_(a, b) - rr_min_(a, b));
+            ncoefficient += ninterval_(a, b);
+        }
+    }
+    LOG("number of grid points: " << npoint());
+
+    // construct cubic Hermite polynomial for each grid interval
+    coefficient_.resize(ncoefficient);
+    for (unsigned int a = 0; a < size1(); ++a) {
+        for (unsigned int b = 0; b < ntype2; ++b) {
+            std::vector<float_type> const& u = energy[a * ntype2 + b];
+            std::vector<float_type> d;
+            if (force.empty()) {
+                d = spline_derivative(u);
+            }
+            else {
+                // dU/dt = dU/d(r²) × Δ(r²) = -fval × Δ(r²) / 2
+                std::vector<float_type> const& f = force[a * ntype2 + b];
+                d.resize(f.size());
+                for (std::size_t i = 0; i < f.size(); ++i) {
+                    d[i] = -f[i] / (2 * drr_inv_(a, b));
+                }
+            }
+            for (unsigned int i = 0; i < ninterval_(a, b); ++i) {
+                coefficient_type& c = coefficient_[offset_(a, b) + i];
+                c[0] = u[i];
+                c[1] = d[i];
+                c[2] = 3 * (u[i + 1] - u[i]) - 2 * d[i] - d[i + 1];
+                c[3] = 2 * (u[i] - u[i + 1]) + d[i] + d[i + 1];
+            }
+        }
+    }
+}
+
+template <typename float_type>
+void tabulated<float_type>::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("mdsim")
+        [
+            namespace_("host")
+            [
+                namespace_("potentials")
+                [
+                    namespace_("pair")
+                    [
+                        class_<tabulated, std::shared_ptr<tabulated> >("tabulated")
+                            .def(constructor<
+                                matrix_type const&
+                              , matrix_type const&
+                              , matrix_type const&
+                              , table_type const&
+                              , table_type const&
+                              , std::shared_ptr<logger>
+                            >())
+                            .property("sigma", &tabulated::sigma)
+                            .property("r_min", &tabulated::r_min)
+                            .property("r_max", &tabulated::r_max)
+                            .property("npoint", &tabulated::npoint)
+                            .scope
+                            [
+                                def("tabulate", &tabulated::template sample<lennard_jones<float_type> >)
+                              , def("tabulate", &tabulated::template sample<mie<float_type> >)
+                              , def("tabulate", &tabulated::template sample<morse<float_type> >)
+                              , def("tabulate", &tabulated::template sample<power_law<float_type> >)
+                            ]
+                    ]
+                ]
+            ]
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_mdsim_host_potentials_pair_tabulated(lua_State* L)
+{
+#ifndef USE_HOST_SINGLE_PRECISION
+    tabulated<double>::luaopen(L);
+    forces::pair_full<3, double, tabulated<double> >::luaopen(L);
+    forces::pair_full<2, double, tabulated<double> >::luaopen(L);
+    truncations::truncations_luaopen<double, tabulated<double> >(L);
+
+    adapters::hard_core<tabulated<double> >::luaopen(L);
+    forces::pair_full<3, double, adapters::hard_core<tabulated<double> > >::luaopen(L);
+    forces::pair_full<2, double, adapters::hard_core<tabulated<double> > >::luaopen(L);
+    truncations::truncations_luaopen<double, adapters::hard_core<tabulated<double> > >(L);
+#else
+    tabulated<float>::luaopen(L);
+    forces::pair_full<3, float, tabulated<float> >::luaopen(L);
+    forces::pair_full<2, float, tabulated<float> >::luaopen(L);
+    truncations::truncations_luaopen<float, tabulated<float> >(L);
+
+    adapters::hard_core<tabulated<float> >::luaopen(L);
+    forces::pair_full<3, float, adapters::hard_core<tabulated<float> > >::luaopen(L);
+    forces::pair_full<2, float, adapters::hard_core<tabulated<float> > >::luaopen(L);
+    truncations::truncations_luaopen<float, adapters::hard_core<tabulated<float> > >(L);
+#endif
+    return 0;
+}
+
+// explicit instantiation
+#ifndef USE_HOST_SINGLE_PRECISION
+template class tabulated<double>;
+HALMD_MDSIM_HOST_POTENTIALS_PAIR_TRUNCATIONS_INSTANTIATE(tabulated<double>)
+
+template class adapters::hard_core<tabulated<double> >;
+HALMD_MDSIM_HOST_POTENTIALS_PAIR_TRUNCATIONS_INSTANTIATE(adapters::hard_core<tabulated<double> >)
+#else
+template class tabulated<float>;
+HALMD_MDSIM_HOST_POTENTIALS_PAIR_TRUNCATIONS_INSTANTIATE(tabulated<float>)
+
+template class adapters::hard_core<tabulated<float> >;
+HALMD_MDSIM_HOST_POTENTIALS_PAIR_TRUNCATIONS_INSTANTIATE(adapters::hard_core<tabulated<float> >)
+#endif
+
+} // namespace pair
+} // namespace potentials
+
+namespace forces {
+
+// explicit instantiation of force modules
+#ifndef USE_HOST_SINGLE_PRECISION
+template class pair_full<3, double, potentials::pair::tabulated<double> >;
+template class pair_full<2, double, potentials::pair::tabulated<double> >;
+HALMD_MDSIM_HOST_POTENTIALS_PAIR_TRUNCATIONS_INSTANTIATE_FORCES(double, potentials::pair::tabulated<double>)
+
+template class pair_full<3, double, potentials::pair::adapters::hard_core<potentials::pair::tabulated<double> > >;
+template class pair_full<2, double, potentials::pair::adapters::hard_core<potentials::pair::tabulated<double> > >;
+HALMD_MDSIM_HOST_POTENTIALS_PAIR_TRUNCATIONS_INSTANTIATE_FORCES(
+    double
+  , potentials::pair::adapters::hard_core<potentials::pair::tabulated<double> >
+  )
+#else
+template class pair_full<3, float, potentials::pair::tabulated<float> >;
+template class pair_full<2, float, potentials::pair::tabulated<float> >;
+HALMD_MDSIM_HOST_POTENTIALS_PAIR_TRUNCATIONS_INSTANTIATE_FORCES(float, potentials::pair::tabulated<float>)
+
+template class pair_full<3, float, potentials::pair::adapters::hard_core<potentials::pair::tabulated<float> > >;
+template class pair_full<2, float, potentials::pair::adapters::hard_core<potentials::pair::tabulated<float> > >;
+HALMD_MDSIM_HOST_POTENTIALS_PAIR_TRUNCATIONS_INSTANTIATE_FORCES(
+    float
+  , potentials::pair::adapters::hard_core<potentials::pair::tabulated<float> >
+  )
+#endif
+
+} // namespace forces
+} // namespace host
+} // namespace mdsim
+} // namespace halmd
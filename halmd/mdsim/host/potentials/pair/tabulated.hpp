@@ -0,0 +1,263 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_MDSIM_HOST_POTENTIALS_PAIR_TABULATED_HPP
+#define HALMD_MDSIM_HOST_POTENTIALS_PAIR_TABULATED_HPP
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <lua.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
+#include <halmd/numeric/blas/fixed_vector.hpp>
+
+namespace halmd {
+namespace mdsim {
+namespace host {
+namespace potentials {
+namespace pair {
+
+/**
+ * Tabulated pair potential with cubic spline interpolation
+ *
+ * For each pair of species, the potential @f$ U @f$ and the unit "force"
+ * @f$ -U'(r)/r @f$ are sampled at the nodes of a uniform grid in the squared
+ * distance @f$ r^2 \in [r_\text{min}^2, r_\text{max}^2] @f$. Between the
+ * nodes, the potential is interpolated by a piecewise cubic Hermite polynomial
+ * in @f$ r^2 @f$, which is continuous with a continuous first derivative, and
+ * the force follows from the derivative of the polynomial. The evaluation
+ * requires neither a square root nor transcendental functions.
+ *
+ * If no forces are given, the derivatives at the nodes are obtained from a
+ * natural cubic spline through the potential values.
+ *
+ * Below @f$ r_\text{min} @f$, the polynomial of the first interval is
+ * extrapolated. Beyond @f$ r_\text{max} @f$, potential and force vanish; the
+ * cutoff of the truncation should not exceed @f$ r_\text{max} @f$.
+ */
+template <typename float_type_>
+class tabulated
+{
+public:
+    typedef float_type_ float_type;
+    typedef boost::numeric::ublas::matrix<float_type> matrix_type;
+    typedef boost::numeric::ublas::matrix<unsigned int> uint_matrix_type;
+    typedef pair::batch<float_type> batch_type;
+    /** node values for all pairs of species in row-major order */
+    typedef std::vector<std::vector<float_type>> table_type;
+
+    tabulated(
+        matrix_type const& sigma
+      , matrix_type const& r_min
+      , matrix_type const& r_max
+      , table_type const& energy
+      , table_type const& force
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
+    );
+
+    /**
+     * Tabulate given pair potential on a grid with 'npoint' nodes.
+     */
+    template <typename potential_type>
+    static std::shared_ptr<tabulated> sample(
+        potential_type const& potential
+      , matrix_type const& r_min
+      , matrix_type const& r_max
+      , unsigned int npoint
+      , std::shared_ptr<halmd::logger> logger
+    );
+
+    /**
+     * Compute potential and its derivative at squared distance 'rr'
+     * for particles of type 'a' and 'b'
+     *
+     * @param rr squared distance between particles
+     * @param a type of first interacting particle
+     * @param b type of second interacting particle
+     * @returns tuple of unit "force" @f$ -U'(r)/r @f$ and potential @f$ U(r) @f$
+     */
+    std::tuple<float_type, float_type> operator()(float_type rr, unsigned a, unsigned b) const
+    {
+        float_type fval, en_pot;
+        std::tie(fval, en_pot) = interpolate_(
+            rr, rr_min_(a, b), rr_max_(a, b), drr_inv_(a, b), offset_(a, b), ninterval_(a, b)
+        );
+        return std::make_tuple(fval, en_pot);
+    }
+
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        float_type rr_min[batch_type::capacity];
+        float_type rr_max[batch_type::capacity];
+        float_type drr_inv[batch_type::capacity];
+        unsigned int offset[batch_type::capacity];
+        unsigned int ninterval[batch_type::capacity];
+        gather(rr_min_, pairs, rr_min);
+        gather(rr_max_, pairs, rr_max);
+        gather(drr_inv_, pairs, drr_inv);
+        gather(offset_, pairs, offset);
+        gather(ninterval_, pairs, ninterval);
+
+        for (unsigned int k = 0; k < pairs.size; ++k) {
+            std::tie(pairs.fval[k], pairs.en_pot[k]) = interpolate_(
+                pairs.rr[k], rr_min[k], rr_max[k], drr_inv[k], offset[k], ninterval[k]
+            );
+        }
+    }
+
+    matrix_type const& sigma() const
+    {
+        return sigma_;
+    }
+
+    matrix_type const& r_min() const
+    {
+        return r_min_;
+    }
+
+    matrix_type const& r_max() const
+    {
+        return r_max_;
+    }
+
+    /** returns number of grid nodes for each pair of species */
+    uint_matrix_type npoint() const
+    {
+        uint_matrix_type npoint(ninterval_);
+        for (auto& n : npoint.data()) {
+            n += 1;
+        }
+        return npoint;
+    }
+
+    unsigned int size1() const
+    {
+        return sigma_.size1();
+    }
+
+    unsigned int size2() const
+    {
+        return sigma_.size2();
+    }
+
+    /**
+     * Bind class to Lua.
+     */
+    static void luaopen(lua_State* L);
+
+private:
+    typedef fixed_vector<float_type, 4> coefficient_type;
+
+    /**
+     * Evaluate the cubic polynomial of the interval containing 'rr'.
+     *
+     * With the reduced coordinate t ∈ [0, 1) within the interval,
+     * U = c₀ + c₁ t + c₂ t² + c₃ t³ and -U'(r)/r = -2 dU/d(r²).
+     */
+    std::tuple<float_type, float_type> interpolate_(
+        float_type rr
+      , float_type rr_min
+      , float_type rr_max
+      , float_type drr_inv
+      , unsigned int offset
+      , unsigned int ninterval
+    ) const
+    {
+        float_type x = (rr - rr_min) * drr_inv;
+        // index of interval, the first and last intervals are extrapolated
+        unsigned int i = std::min(static_cast<unsigned int>(std::max(x, float_type(0))), ninterval - 1);
+        float_type t = x - i;
+        coefficient_type const& c = coefficient_[offset + i];
+
+        float_type en_pot = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+        float_type fval = -2 * drr_inv * (c[1] + t * (2 * c[2] + t * 3 * c[3]));
+
+        // the potential vanishes beyond the table
+        bool inside = (rr < rr_max);
+        return std::make_tuple(inside ? fval : 0, inside ? en_pot : 0);
+    }
+
+    /** interaction range in MD units, used as unit of length by truncations */
+    matrix_type sigma_;
+    /** lower bound of table in MD units */
+    matrix_type r_min_;
+    /** upper bound of table in MD units */
+    matrix_type r_max_;
+    /** square of lower bound */
+    matrix_type rr_min_;
+    /** square of upper bound */
+    matrix_type rr_max_;
+    /** inverse grid spacing in squared distance */
+    matrix_type drr_inv_;
+    /** offset of the table of each pair of species in the array of coefficients */
+    uint_matrix_type offset_;
+    /** number of grid intervals */
+    uint_matrix_type ninterval_;
+    /** polynomial coefficients of all grid intervals */
+    std::vector<coefficient_type> coefficient_;
+    /** module logger */
+    std::shared_ptr<logger> logger_;
+};
+
+template <typename float_type>
+template <typename potential_type>
+std::shared_ptr<tabulated<float_type>> tabulated<float_type>::sample(
+    potential_type const& potential
+  , matrix_type const& r_min
+  , matrix_type const& r_max
+  , unsigned int npoint
+  , std::shared_ptr<halmd::logger> logger
+)
+{
+    if (npoint < 2) {
+        throw std::invalid_argument("tabulated potential requires at least 2 grid points");
+    }
+    unsigned int ntype1 = potential.size1();
+    unsigned int ntype2 = potential.size2();
+    table_type energy(ntype1 * ntype2, std::vector<float_type>(npoint));
+    table_type force(ntype1 * ntype2, std::vector<float_type>(npoint));
+
+    for (unsigned int a = 0; a < ntype1; ++a) {
+        for (unsigned int b = 0; b < ntype2; ++b) {
+            float_type rr_min = r_min(a, b) * r_min(a, b);
+            float_type drr = (r_max(a, b) * r_max(a, b) - rr_min) / (npoint - 1);
+            unsigned int k = a * ntype2 + b;
+            for (unsigned int i = 0; i < npoint; ++i) {
+                std::tie(force[k][i], energy[k][i]) = potential(rr_min + i * drr, a, b);
+            }
+        }
+    }
+    return std::make_shared<tabulated>(potential.sigma(), r_min, r_max, energy, force, logger);
+}
+
+} // namespace pair
+} // namespace potentials
+} // namespace host
+} // namespace mdsim
+} // namespace halmd
+
+#endif /* ! HALMD_MDSIM_HOST_POTENTIALS_PAIR_TABULATED_HPP */
@@ -27,6 +27,7 @@
 #include <memory>
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/matrix_shape.hpp>
 
@@ -47,6 +48,7 @@ class sharp
 public:
     typedef typename potential_type::float_type float_type;
     typedef typename potential_type::matrix_type matrix_type;
+    typedef typename potential_type::batch_type batch_type;
 
     template<typename... Args>
     sharp(matrix_type const& cutoff, Args&&... args)
@@ -91,6 +93,12 @@ public:
         return potential_type::operator()(rr, a, b);
     }
 
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        potential_type::operator()(pairs);
+    }
+
     /**
      * Bind class to Lua.
      */
@@ -27,6 +27,7 @@
 #include <memory>
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/matrix_shape.hpp>
 
@@ -47,6 +48,7 @@ class shifted
 public:
     typedef typename potential_type::float_type float_type;
     typedef typename potential_type::matrix_type matrix_type;
+    typedef typename potential_type::batch_type batch_type;
 
     template<typename... Args>
     shifted(matrix_type const& cutoff, Args&&... args)
@@ -103,6 +105,18 @@ public:
         return std::make_tuple(f_abs, en_pot);
     }
 
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        potential_type::operator()(pairs);
+
+        float_type en_cut[batch_type::capacity];
+        gather(en_cut_, pairs, en_cut);
+        for (unsigned int k = 0; k < pairs.size; ++k) {
+            pairs.en_pot[k] -= en_cut[k];
+        }
+    }
+
     /**
      * Bind class to Lua.
      */
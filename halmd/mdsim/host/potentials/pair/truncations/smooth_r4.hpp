@@ -27,6 +27,7 @@
 #include <memory>
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/potentials/pair/batch.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/matrix_shape.hpp>
 
@@ -47,6 +48,7 @@ class smooth_r4
 public:
     typedef typename potential_type::float_type float_type;
     typedef typename potential_type::matrix_type matrix_type;
+    typedef typename potential_type::batch_type batch_type;
 
     template<typename... Args>
     smooth_r4(matrix_type const& cutoff, float_type h, Args&&... args)
@@ -117,6 +119,29 @@ public:
         return std::make_tuple(f_abs, en_pot);
     }
 
+    /** compute potential and its derivative for a batch of pairs */
+    void operator()(batch_type& pairs) const
+    {
+        potential_type::operator()(pairs);
+
+        float_type r_cut[batch_type::capacity];
+        float_type en_cut[batch_type::capacity];
+        gather(r_cut_, pairs, r_cut);
+        gather(en_cut_, pairs, en_cut);
+        for (unsigned int k = 0; k < pairs.size; ++k) {
+            float_type en_pot = pairs.en_pot[k] - en_cut[k];
+            float_type r = std::sqrt(pairs.rr[k]);
+            float_type dr = r - r_cut[k];
+            float_type x2 = dr * dr * rri_smooth_;
+            float_type x4 = x2 * x2;
+            float_type x4i = 1 / (1 + x4);
+            float_type h0_r = x4 * x4i;
+            float_type h1_r = 4 * dr * rri_smooth_ * x2 * x4i * x4i;
+            pairs.fval[k] = h0_r * pairs.fval[k] - h1_r * (en_pot / r);
+            pairs.en_pot[k] = h0_r * en_pot;
+        }
+    }
+
     /**
      * Bind class to Lua.
      */
@@ -20,7 +20,9 @@
 
 #include <algorithm>
 #include <boost/bind/bind.hpp>
+#include <cassert>
 #include <cmath>
+#include <numeric>
 
 #include <halmd/mdsim/host/sorts/hilbert.hpp>
 #include <halmd/mdsim/sorts/hilbert_kernel.hpp>
@@ -36,12 +38,14 @@ hilbert<dimension, float_type>::hilbert(
     std::shared_ptr<particle_type> particle
   , std::shared_ptr<box_type const> box
   , std::shared_ptr<binning_type> binning
+  , std::shared_ptr<thread_pool_type> thread_pool
   , std::shared_ptr<logger> logger
 )
   // dependency injection
   : particle_(particle)
   , box_(box)
   , binning_(binning)
+  , thread_pool_(thread_pool)
   , logger_(logger)
 {
     using namespace boost::placeholders;
@@ -86,6 +90,11 @@ hilbert<dimension, float_type>::hilbert(
 
 /**
  * Order particles after Hilbert space-filling curve
+ *
+ * The index sequence is generated by a parallel scan over the Hilbert-sorted
+ * cells: each thread counts the particles in its subrange of cells, the
+ * counts are summed to offsets into the index sequence, and each thread then
+ * copies the particle indices of its cells.
  */
 template <int dimension, typename float_type>
 void hilbert<dimension, float_type>::order()
@@ -93,22 +102,35 @@ void hilbert<dimension, float_type>::order()
     LOG_DEBUG("order particles after Hilbert space-filling curve");
     {
         scoped_timer_type timer(runtime_.order);
-        std::vector<unsigned int> index;
         {
             scoped_timer_type timer(runtime_.map);
             // particle binning
             binning_->cell();
+
+            unsigned int const nthread = thread_pool_->size();
+            offset_.assign(nthread + 1, 0);
+            thread_pool_->parallel_for(0, map_.size(), [&](unsigned int thread, std::size_t first, std::size_t last) {
+                std::size_t count = 0;
+                for (std::size_t i = first; i < last; ++i) {
+                    count += map_[i]->size();
+                }
+                offset_[thread + 1] = count;
+            });
+            std::partial_sum(offset_.begin(), offset_.end(), offset_.begin());
+            assert(offset_.back() == particle_->nparticle());
+
             // generate index sequence according to Hilbert-sorted cells
-            index.reserve(particle_->nparticle());
-            for (cell_list const* cell : map_) {
-                for (unsigned int p : *cell) {
-                    index.push_back(p);
+            index_.resize(offset_.back());
+            thread_pool_->parallel_for(0, map_.size(), [&](unsigned int thread, std::size_t first, std::size_t last) {
+                auto output = index_.begin() + offset_[thread];
+                for (std::size_t i = first; i < last; ++i) {
+                    output = std::copy(map_[i]->begin(), map_[i]->end(), output);
                 }
-            }
+            });
         }
 
         // reorder particles in memory
-        particle_->rearrange(index);
+        particle_->rearrange(index_, *thread_pool_);
     }
     on_order_();
 }
@@ -157,6 +179,7 @@ void hilbert<dimension, float_type>::luaopen(lua_State* L)
                   , std::shared_ptr<particle_type>
                   , std::shared_ptr<box_type const>
                   , std::shared_ptr<binning_type>
+                  , std::shared_ptr<thread_pool_type>
                   , std::shared_ptr<logger>
                 >)
             ]
@@ -30,6 +30,10 @@
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/utility/profiler.hpp>
 #include <halmd/utility/signal.hpp>
+#include <halmd/utility/thread_pool.hpp>
+
+#include <cstddef>
+#include <vector>
 
 namespace halmd {
 namespace mdsim {
@@ -44,6 +48,7 @@ public:
     typedef typename particle_type::vector_type vector_type;
     typedef mdsim::box<dimension> box_type;
     typedef host::binning<dimension, float_type> binning_type;
+    typedef utility::thread_pool thread_pool_type;
 
     static void luaopen(lua_State* L);
 
@@ -51,6 +56,7 @@ public:
         std::shared_ptr<particle_type> particle
       , std::shared_ptr<box_type const> box
       , std::shared_ptr<binning_type> binning
+      , std::shared_ptr<thread_pool_type> thread_pool = std::make_shared<thread_pool_type>()
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
     void order();
@@ -77,9 +83,14 @@ private:
     std::shared_ptr<particle_type> particle_;
     std::shared_ptr<box_type const> box_;
     std::shared_ptr<binning_type> binning_;
+    std::shared_ptr<thread_pool_type> thread_pool_;
 
     /** 1-dimensional Hilbert curve mapping of cell lists */
     std::vector<cell_list const*> map_;
+    /** index sequence of Hilbert-sorted particles */
+    std::vector<unsigned int> index_;
+    /** per-thread offsets into index sequence */
+    std::vector<std::size_t> offset_;
     /** signal emitted after particle ordering */
     signal<void ()> on_order_;
     /** module logger */
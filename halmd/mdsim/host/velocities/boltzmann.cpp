@@ -32,12 +32,14 @@ template <int dimension, typename float_type>
 boltzmann<dimension, float_type>::boltzmann(
     std::shared_ptr<particle_type> particle
   , std::shared_ptr<random_type> random
+  , std::shared_ptr<clock_type const> clock
   , double temperature
   , std::shared_ptr<logger> logger
 )
   // dependency injection
   : particle_(particle)
   , random_(random)
+  , clock_(clock)
   , logger_(logger)
 {
     set_temperature(temperature);
@@ -59,30 +61,29 @@ void boltzmann<dimension, float_type>::set()
 
     auto velocity = make_cache_mutable(particle_->velocity());
     mass_array_type const& mass = read_cache(particle_->mass());
+    id_array_type const& id = read_cache(particle_->id());
     size_type nparticle = particle_->nparticle();
 
     float_type const sigma = std::sqrt(temp_);
     fixed_vector<double, dimension> mv = 0;
     double mv2 = 0;
     double m = 0;
-    float_type r;
-    bool r_valid = false;
+
+    // draw from a separate stream of random numbers for each particle,
+    // keyed by the simulation step and the particle identifier
+    std::uint64_t sequence = random_type::sequence(clock_->step(), random_type::stream_id::boltzmann);
 
     for (size_type i = 0; i < nparticle; ++i) {
         vector_type& v = (*velocity)[i];
+        random_type::random_generator rng = random_->stream(sequence, id[i]);
         // assign two components at a time
         for (unsigned int j = 0; j < dimension - 1; j += 2) {
-            std::tie(v[j], v[j + 1]) = random_->normal(sigma);
+            std::tie(v[j], v[j + 1]) = random::host::normal(rng, sigma);
         }
         // handle last component separately for odd dimensions
         if (dimension % 2 == 1) {
-            if (r_valid) {
-                v[dimension - 1] = r;
-            }
-            else {
-                std::tie(v[dimension - 1], r) = random_->normal(sigma);
-            }
-            r_valid = !r_valid;
+            float_type r;
+            std::tie(v[dimension - 1], r) = random::host::normal(rng, sigma);
         }
         double m_i = mass[i];
         v /= std::sqrt(m_i);
@@ -119,6 +120,7 @@ void boltzmann<dimension, float_type>::luaopen(lua_State* L)
               , def("boltzmann", &std::make_shared<boltzmann
                   , std::shared_ptr<particle_type>
                   , std::shared_ptr<random_type>
+                  , std::shared_ptr<clock_type const>
                   , double
                   , std::shared_ptr<logger>
                 >)
@@ -23,6 +23,7 @@
 #define HALMD_MDSIM_HOST_VELOCITIES_BOLTZMANN_HPP
 
 #include <halmd/io/logger.hpp>
+#include <halmd/mdsim/clock.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/random/host/random.hpp>
 #include <halmd/utility/profiler.hpp>
@@ -42,16 +43,21 @@ class boltzmann
 public:
     typedef host::particle<dimension, float_type> particle_type;
     typedef random::host::random random_type;
+    typedef mdsim::clock clock_type;
 
     boltzmann(
         std::shared_ptr<particle_type> particle
       , std::shared_ptr<random_type> random
+      , std::shared_ptr<clock_type const> clock
       , double temperature
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
     /**
      * Initialise velocities from Maxwell-Boltzmann distribution
+     *
+     * The random numbers are keyed by the current simulation step, thus
+     * repeated calls within the same step assign the same velocities.
      */
     void set();
 
@@ -78,11 +84,14 @@ private:
     typedef typename particle_type::size_type size_type;
     typedef typename particle_type::velocity_array_type velocity_array_type;
     typedef typename particle_type::mass_array_type mass_array_type;
+    typedef typename particle_type::id_array_type id_array_type;
 
     /** system state */
     std::shared_ptr<particle_type> particle_;
     /** random number generator */
     std::shared_ptr<random_type> random_;
+    /** simulation clock */
+    std::shared_ptr<clock_type const> clock_;
     /** module logger */
     std::shared_ptr<logger> logger_;
     /** temperature */
@@ -0,0 +1,76 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_NUMERIC_BLAS_PADDED_VECTOR_HPP
+#define HALMD_NUMERIC_BLAS_PADDED_VECTOR_HPP
+
+#include <halmd/numeric/blas/fixed_vector.hpp>
+
+#include <cstddef>
+
+namespace halmd {
+namespace detail {
+
+/** smallest power of two not less than N */
+template <std::size_t N>
+struct padded_size
+{
+    enum { value = 2 * padded_size<(N + 1) / 2>::value };
+};
+
+template <>
+struct padded_size<1>
+{
+    enum { value = 1 };
+};
+
+} // namespace detail
+
+/**
+ * Fixed-size vector padded and aligned to a power-of-two number of elements
+ *
+ * A three-dimensional vector occupies the storage of four elements, which
+ * matches the layout of float4 or double4 particle arrays on the GPU. Arrays
+ * of padded vectors allow aligned SIMD loads and stores of whole elements.
+ *
+ * The vector derives from fixed_vector and is used as the element type of
+ * arrays only: arithmetic yields fixed_vector, and values convert implicitly
+ * in both directions.
+ */
+template <typename T, std::size_t N>
+struct alignas(detail::padded_size<N>::value * sizeof(T)) padded_vector
+  : fixed_vector<T, N>
+{
+    typedef fixed_vector<T, N> vector_type;
+
+    padded_vector() {}
+
+    /** inherit constructors of fixed_vector */
+    using fixed_vector<T, N>::fixed_vector;
+
+    /**
+     * Conversion from unpadded vector
+     */
+    padded_vector(vector_type const& v) : vector_type(v) {}
+};
+
+} // namespace halmd
+
+#endif /* ! HALMD_NUMERIC_BLAS_PADDED_VECTOR_HPP */
@@ -0,0 +1,90 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_NUMERIC_KAHAN_SUM_HPP
+#define HALMD_NUMERIC_KAHAN_SUM_HPP
+
+#include <halmd/config.hpp>
+
+namespace halmd {
+
+/**
+ * Compensated summation
+ *
+ * The rounding error of each addition is carried along and subtracted from
+ * the next summand, so that the error of the sum does not grow with the
+ * number of summands. The value type may be a scalar or a fixed-size vector,
+ * in which case the summation is compensated element-wise.
+ *
+ * The algorithm requires strict IEEE floating-point semantics and is
+ * defeated by compiler flags such as -ffast-math.
+ *
+ * W. Kahan, Further remarks on reducing truncation errors,
+ * Commun. ACM 8, 40 (1965)
+ */
+template <typename T>
+class kahan_sum
+{
+public:
+    typedef T value_type;
+
+    HALMD_GPU_ENABLED kahan_sum()
+      : sum_(0), error_(0) {}
+
+    /**
+     * add value to sum
+     */
+    HALMD_GPU_ENABLED kahan_sum& operator+=(value_type const& value)
+    {
+        value_type y = value - error_;
+        value_type t = sum_ + y;
+        error_ = (t - sum_) - y;
+        sum_ = t;
+        return *this;
+    }
+
+    /**
+     * add partial sum, including its error
+     */
+    HALMD_GPU_ENABLED kahan_sum& operator+=(kahan_sum const& other)
+    {
+        *this += other.sum_;
+        *this += -other.error_;
+        return *this;
+    }
+
+    /**
+     * returns compensated sum
+     */
+    HALMD_GPU_ENABLED value_type operator()() const
+    {
+        return sum_ - error_;
+    }
+
+private:
+    /** uncompensated sum */
+    value_type sum_;
+    /** rounding error accumulated in the sum */
+    value_type error_;
+};
+
+} // namespace halmd
+
+#endif /* ! HALMD_NUMERIC_KAHAN_SUM_HPP */
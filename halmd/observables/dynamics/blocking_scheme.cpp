@@ -22,6 +22,8 @@
 #include <cassert>
 #include <cmath>
 #include <exception>
+#include <utility>
+#include <vector>
 
 #include <halmd/observables/dynamics/blocking_scheme.hpp>
 #include <halmd/utility/lua/lua.hpp>
@@ -39,6 +41,7 @@ blocking_scheme::blocking_scheme(
   , unsigned int block_size
   , unsigned int shift
   , unsigned int separation
+  , unsigned int nthread
   , std::shared_ptr<logger> logger
 )
   // member initialisation
@@ -108,11 +111,20 @@ blocking_scheme::blocking_scheme(
             time_[i][j] = (interval_[i] * j) * clock_->timestep();
         }
     }
+
+    // set up threads for concurrent computation of correlations, the
+    // simulation waits if too many computations are pending
+    if (nthread > 0) {
+        thread_pool_ = std::make_shared<halmd::utility::thread_pool>(nthread);
+        task_queue_ = std::make_shared<halmd::utility::task_queue>(2 * block_count);
+        LOG("compute correlations concurrently using " << thread_pool_->size() << " thread(s)");
+    }
 }
 
 connection blocking_scheme::on_correlate(std::shared_ptr<correlation_base> tcf)
 {
     assert(find(tcf_.begin(), tcf_.end(), tcf) == tcf_.end());
+    tcf->set_task_queue(task_queue_);
     return tcf_.connect(tcf);
 }
 
@@ -170,16 +182,81 @@ void blocking_scheme::finalise()
             process(i);
         }
     }
+    // complete pending computations before the results are written, and
+    // account their runtimes in this thread
+    if (task_queue_) {
+        task_queue_->wait();
+        for (std::shared_ptr<correlation_base> tcf : tcf_) {
+            tcf->wait();
+        }
+    }
     on_append_finalise_();
 }
 
+/**
+ * Execute the work items of the given tasks on the thread pool.
+ *
+ * The items are interleaved across the tasks, i.e., the first items of all
+ * tasks are followed by the second items and so on, and the sequence is
+ * split into contiguous blocks for the threads. Thus, the correlation
+ * functions are computed concurrently, and each thread receives a similar
+ * share of the items of each correlation function.
+ */
+static void run_tasks(
+    halmd::utility::thread_pool& pool
+  , std::vector<correlation_base::task_type> const& tasks
+)
+{
+    std::size_t nitem = 0;
+    std::size_t size = 0;
+    for (correlation_base::task_type const& task : tasks) {
+        nitem += task.size;
+        size = std::max(size, task.size);
+    }
+    // pairs of task and item index
+    std::vector<std::pair<unsigned int, std::size_t>> items;
+    items.reserve(nitem);
+    for (std::size_t i = 0; i < size; ++i) {
+        for (unsigned int j = 0; j < tasks.size(); ++j) {
+            if (i < tasks[j].size) {
+                items.emplace_back(j, i);
+            }
+        }
+    }
+    pool.parallel_for(0, items.size(), [&](unsigned int, std::size_t begin, std::size_t end) {
+        for (std::size_t k = begin; k < end; ++k) {
+            tasks[items[k].first].compute(items[k].second);
+        }
+    });
+}
+
 void blocking_scheme::process(unsigned int level)
 {
     // call all registered correlation modules
     // and correlate block data with first entry
     LOG_DEBUG("compute correlations at blocking level " << level << " from step " << origin_[level]);
+    //
+    // If enabled, the computation is deferred to the worker threads for
+    // correlation functions of host samples. The tasks hold on to the
+    // current entries, and the tasks of all correlation functions at this
+    // level are executed together in one batch. The batches are executed in
+    // order, so that an output accumulator is never updated concurrently.
+    std::vector<correlation_base::task_type> tasks;
     for (std::shared_ptr<correlation_base> tcf : tcf_) {
-        tcf->compute(level);
+        correlation_base::task_type task{0, nullptr};
+        if (task_queue_) {
+            task = tcf->task(level);
+        }
+        if (task.compute) {
+            tasks.push_back(std::move(task));
+        }
+        else {
+            tcf->compute(level);
+        }
+    }
+    if (!tasks.empty()) {
+        std::shared_ptr<halmd::utility::thread_pool> pool = thread_pool_;
+        task_queue_->submit([=]() { run_tasks(*pool, tasks); });
     }
 
     // update time origin for next computation at this level
@@ -260,6 +337,7 @@ void blocking_scheme::luaopen(lua_State* L)
                       , unsigned int
                       , unsigned int
                       , unsigned int
+                      , unsigned int
                       , std::shared_ptr<logger>
                     >())
                     .property("finalise", &wrap_finalise)
@@ -267,6 +345,7 @@ void blocking_scheme::luaopen(lua_State* L)
                     .property("block_size", &blocking_scheme::block_size)
                     .property("separation", &blocking_scheme::separation)
                     .property("count", &blocking_scheme::count)
+                    .property("threads", &blocking_scheme::threads)
                     .property("time", &wrap_time)
                     .def("on_correlate", &blocking_scheme::on_correlate)
                     .def("on_sample", &blocking_scheme::on_sample)
@@ -30,6 +30,8 @@
 #include <halmd/observables/dynamics/correlation.hpp>
 #include <halmd/observables/samples/blocking_scheme.hpp>
 #include <halmd/utility/signal.hpp>
+#include <halmd/utility/task_queue.hpp>
+#include <halmd/utility/thread_pool.hpp>
 
 namespace halmd {
 namespace observables {
@@ -63,6 +65,9 @@ public:
      *  @param shift              coarse-graining shift between odd and even levels,
      *                            if 0 it is computed as sqrt(block_size)
      *  @param separation         minimal sample separation for time averages (in simulation steps)
+     *  @param nthread            number of threads for the computation of correlations
+     *                            concurrently to the simulation, if 0 the correlations
+     *                            are computed in the calling thread
      */
     blocking_scheme(
         std::shared_ptr<clock_type const> clock
@@ -71,6 +76,7 @@ public:
       , unsigned int block_size
       , unsigned int shift = 0
       , unsigned int separation = 1
+      , unsigned int nthread = 0
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
@@ -114,6 +120,12 @@ public:
         return separation_;
     }
 
+    /** returns number of threads for concurrent computation of correlations */
+    unsigned int threads() const
+    {
+        return thread_pool_ ? thread_pool_->size() : 0;
+    }
+
     /** returns block-wise time grid for correlation functions */
     block_time_type const& time() const
     {
@@ -158,6 +170,10 @@ private:
     signal_type on_prepend_finalise_;
     /** signal emitted after finalise */
     signal_type on_append_finalise_;
+    /** worker threads for the computation of correlations, or nullptr */
+    std::shared_ptr<halmd::utility::thread_pool> thread_pool_;
+    /** queue of pending computations, destroyed first to complete the tasks */
+    std::shared_ptr<halmd::utility::task_queue> task_queue_;
 };
 
 } // namespace dynamics
@@ -24,13 +24,20 @@
 
 #include <boost/array.hpp>
 #include <boost/multi_array.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
 #include <halmd/io/logger.hpp>
 #include <halmd/numeric/accumulator.hpp>
 #include <halmd/observables/samples/blocking_scheme.hpp>
 #include <halmd/utility/lua/lua.hpp>
 #include <halmd/utility/profiler.hpp>
+#include <halmd/utility/task_queue.hpp>
 
 namespace halmd {
 namespace observables {
@@ -42,8 +49,21 @@ namespace dynamics {
  * on_correlate_block which correlation functions connect to.
  */
 class correlation_base
+  : public std::enable_shared_from_this<correlation_base>
 {
 public:
+    /**
+     * Deferred computation of the correlations at a coarse-graining level,
+     * which consists of independent work items.
+     */
+    struct task_type
+    {
+        /** number of work items */
+        std::size_t size;
+        /** compute work item of given index, may be called concurrently */
+        std::function<void (std::size_t)> compute;
+    };
+
     correlation_base() {}
     virtual ~correlation_base() {}
     /** Lua bindings */
@@ -51,6 +71,46 @@ public:
 
     /** compute correlations at the given coarse-graining level */
     virtual void compute(unsigned int level) = 0;
+
+    /**
+     * Returns task that computes the correlations at the given level from
+     * a copy of the current block data, which may be executed by other
+     * threads. Returns a task with an empty compute function if the
+     * correlations must be computed by compute() in the calling thread.
+     */
+    virtual task_type task(unsigned int level)
+    {
+        return task_type{0, nullptr};
+    }
+
+    /**
+     * Set queue of pending tasks, which is completed before the results
+     * are accessed.
+     */
+    void set_task_queue(std::shared_ptr<halmd::utility::task_queue> queue)
+    {
+        queue_ = queue;
+    }
+
+    /**
+     * Wait for completion of pending tasks, and account their runtimes in
+     * the calling thread.
+     */
+    void wait()
+    {
+        if (auto queue = queue_.lock()) {
+            queue->wait();
+        }
+        collect_runtime();
+    }
+
+protected:
+    /** add runtimes of completed tasks to the runtime accumulators */
+    virtual void collect_runtime() {}
+
+private:
+    /** queue of pending tasks, owned by the blocking scheme */
+    std::weak_ptr<halmd::utility::task_queue> queue_;
 };
 
 namespace detail {
@@ -97,6 +157,34 @@ unsigned int const* get_shape(T const& obj)
     return get_shape_impl(obj, 0); // 0 is of type 'int' which takes precedence over 'long'
 }
 
+/**
+ * determine whether samples are located in host memory
+ */
+template <typename T>
+constexpr auto is_gpu_sample_impl(int) -> decltype(bool(T::gpu_sample))
+{
+    return T::gpu_sample;
+}
+
+template <typename T>
+constexpr bool is_gpu_sample_impl(long)
+{
+    return false;
+}
+
+/**
+ * Correlations may be computed concurrently to the simulation for samples
+ * in host memory, but not for GPU samples or for samples held by the Lua
+ * interpreter.
+ */
+template <typename T>
+struct is_concurrent
+  : std::integral_constant<bool, !is_gpu_sample_impl<T>(0)> {};
+
+template <>
+struct is_concurrent<luaponte::object>
+  : std::false_type {};
+
 } // namespace detail
 
 template <typename tcf_type>
@@ -125,6 +213,8 @@ public:
 
     virtual void compute(unsigned int level);
 
+    virtual task_type task(unsigned int level);
+
     block_result_type const& result() const
     {
         return result_;
@@ -139,9 +229,21 @@ public:
     static std::function<block_count_type const& ()>
     get_count(std::shared_ptr<correlation> self);
 
+protected:
+    virtual void collect_runtime();
+
 private:
     typedef correlation_base _Base;
     typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
+    typedef halmd::utility::profiler::timer_type timer_type;
+
+    /** returns task for concurrent computation */
+    task_type task_(unsigned int level, std::true_type);
+    /** returns empty task for computation in calling thread */
+    task_type task_(unsigned int level, std::false_type)
+    {
+        return task_type{0, nullptr};
+    }
 
     struct runtime
     {
@@ -167,6 +269,10 @@ private:
 
     /** profiling runtime accumulators */
     runtime runtime_;
+    /** runtimes of completed tasks, to be added to runtime_.tcf */
+    std::vector<double> task_runtime_;
+    /** guards task_runtime_ */
+    std::mutex task_runtime_mutex_;
 };
 
 template <typename tcf_type>
@@ -223,11 +329,63 @@ void correlation<tcf_type>::compute(unsigned int level)
     }
 }
 
+template <typename tcf_type>
+typename correlation<tcf_type>::task_type correlation<tcf_type>::task(unsigned int level)
+{
+    collect_runtime();
+    return task_(level, detail::is_concurrent<sample_type>());
+}
+
+template <typename tcf_type>
+void correlation<tcf_type>::collect_runtime()
+{
+    std::vector<double> elapsed;
+    {
+        std::lock_guard<std::mutex> lock(task_runtime_mutex_);
+        elapsed.swap(task_runtime_);
+    }
+    for (double t : elapsed) {
+        runtime_.tcf(t);
+    }
+}
+
+template <typename tcf_type>
+typename correlation<tcf_type>::task_type correlation<tcf_type>::task_(unsigned int level, std::true_type)
+{
+    typedef std::shared_ptr<sample_type const> sample_ptr_type;
+
+    // hold on to the samples, which are immutable, while the block
+    // structures are modified by the blocking scheme
+    auto self = std::static_pointer_cast<correlation>(shared_from_this());
+    sample_ptr_type first = block_sample1_->index(level).front();
+    auto const& block2 = block_sample2_->index(level);
+    std::vector<sample_ptr_type> second(block2.begin(), block2.end());
+
+    // each lag time is a separate work item, which writes to its own
+    // output accumulator
+    auto compute = [=](std::size_t i) {
+        LOG_TRACE("compute correlations at level " << level << " for lag " << i);
+        // the runtime accumulator is read by the profiler in the calling
+        // thread, which adds the runtime of the item, see collect_runtime()
+        timer_type timer;
+        bool traced = halmd::utility::trace::enabled();
+        std::uint64_t begin = traced ? halmd::utility::trace::begin() : 0;
+        (*self->tcf_)(*first, *second[i], self->result_[level][i]);
+        if (traced) {
+            halmd::utility::trace::end(&self->runtime_.tcf, begin);
+        }
+        std::lock_guard<std::mutex> lock(self->task_runtime_mutex_);
+        self->task_runtime_.push_back(timer.elapsed());
+    };
+    return task_type{second.size(), compute};
+}
+
 template <typename tcf_type>
 std::function<typename correlation<tcf_type>::block_mean_type const& ()>
 correlation<tcf_type>::get_mean(std::shared_ptr<correlation<tcf_type>> self)
 {
     return [=]() -> block_mean_type const& {
+        self->wait();
         auto in  = self->result_.origin();
         auto out = self->mean_.origin();
         for (unsigned int i = 0; i < self->mean_.num_elements(); ++i) {
@@ -242,6 +400,7 @@ std::function<typename correlation<tcf_type>::block_mean_type const& ()>
 correlation<tcf_type>::get_error(std::shared_ptr<correlation<tcf_type>> self)
 {
     return [=]() -> block_mean_type const& {
+        self->wait();
         auto in  = self->result_.origin();
         auto out = self->error_.origin();
         for (unsigned int i = 0; i < self->error_.num_elements(); ++i) {
@@ -256,6 +415,7 @@ std::function<typename correlation<tcf_type>::block_count_type const& ()>
 correlation<tcf_type>::get_count(std::shared_ptr<correlation<tcf_type>> self)
 {
     return [=]() -> block_count_type const& {
+        self->wait();
         auto in  = self->result_.origin();
         auto out = self->count_.origin();
         for (unsigned int i = 0; i < self->count_.num_elements(); ++i) {
@@ -22,6 +22,9 @@
 #include <halmd/observables/host/density_mode.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
+#include <cmath>
+#include <stdexcept>
+
 using namespace std;
 
 namespace halmd {
@@ -33,14 +36,60 @@ density_mode<dimension, float_type>::density_mode(
     shared_ptr<particle_type const> particle
   , shared_ptr<particle_group_type> particle_group
   , shared_ptr<wavevector_type const> wavevector
+  , shared_ptr<thread_pool_type> thread_pool
   , shared_ptr<logger> logger
 )
     // dependency injection
   : particle_(particle)
   , particle_group_(particle_group)
   , wavevector_(wavevector)
+  , thread_pool_(thread_pool)
   , logger_(logger)
-{}
+{
+    unit_wavenumber_ = element_div(fixed_vector<double, dimension>(2 * M_PI), wavevector_->box_length());
+
+    // determine Miller indices of the wavevectors
+    auto const& q = wavevector_->value();
+    std::vector<fixed_vector<int, dimension>> miller(q.size());
+    max_index_ = 0;
+    for (size_t k = 0; k < q.size(); ++k) {
+        fixed_vector<double, dimension> n = element_div(q[k], unit_wavenumber_);
+        for (int i = 0; i < dimension; ++i) {
+            miller[k][i] = static_cast<int>(lround(n[i]));
+            if (fabs(n[i] - miller[k][i]) > 1e-6 * max(fabs(n[i]), 1.)) {
+                throw logic_error("wavevector is not compatible with the reciprocal lattice of the simulation box");
+            }
+            max_index_[i] = max(max_index_[i], static_cast<unsigned int>(abs(miller[k][i])));
+        }
+    }
+
+    // the table of powers holds exp(-i n 2π r / L) for -max ≤ n ≤ max
+    // consecutively for each Cartesian component
+    index_type base;
+    table_size_ = 0;
+    for (int i = 0; i < dimension; ++i) {
+        base[i] = table_size_ + max_index_[i];
+        table_size_ += 2 * max_index_[i] + 1;
+    }
+    offset_.resize(q.size());
+    for (size_t k = 0; k < q.size(); ++k) {
+        for (int i = 0; i < dimension; ++i) {
+            offset_[k][i] = base[i] + miller[k][i];
+        }
+    }
+    LOG_DEBUG("maximum Miller indices: " << max_index_);
+}
+
+/**
+ * Returns product of complex numbers
+ */
+static inline fixed_vector<double, 2> complex_prod(fixed_vector<double, 2> const& a, fixed_vector<double, 2> const& b)
+{
+    fixed_vector<double, 2> c;
+    c[0] = a[0] * b[0] - a[1] * b[1];
+    c[1] = a[0] * b[1] + a[1] * b[0];
+    return c;
+}
 
 /**
  * Acquire density modes from particle positions
@@ -69,20 +118,68 @@ density_mode<dimension, float_type>::acquire()
         // to track the update via std::weak_ptr.
         result_ = make_shared<result_type>(wavevector.size());
 
-        // compute density modes
-        // initialise result array
-        fill(begin(*result_), end(*result_), 0);
+        size_t const nq = wavevector.size();
+        unsigned int const nthread = thread_pool_->size();
+        power_.resize(nthread * table_size_);
+        partial_.resize((nthread - 1) * nq);
 
         // compute sum of exponentials: rho_q = sum_r exp(-i q·r)
-        // 1st loop: iterate over particle group
-        for (auto i : group) {
-            vector_type const& r = position[i];
-            // 2nd loop: iterate over wavevectors
-            typedef typename result_type::value_type mode_type;
+        // 1st loop: iterate over particle group, split into blocks of particles
+        thread_pool_->parallel_for(0, group.size(), [&](unsigned int thread, size_t first, size_t last) {
+            mode_type* rho = (thread == 0) ? result_->begin() : partial_.data() + (thread - 1) * nq;
+            mode_type* power = power_.data() + thread * table_size_;
+            fill(rho, rho + nq, 0);
+
+            for (size_t j = first; j < last; ++j) {
+                vector_type const& r = position[group[j]];
+
+                // tabulate exp(-i n 2π r / L) by recurrence, with one
+                // evaluation of cos and sin per Cartesian component and per
+                // 32 powers
+                mode_type* table = power;
+                for (int i = 0; i < dimension; ++i) {
+                    double phi = unit_wavenumber_[i] * r[i];
+                    mode_type e;
+                    e[0] = cos(phi);
+                    e[1] = -sin(phi);
+                    unsigned int const max_n = max_index_[i];
+                    mode_type* centre = table + max_n;
+                    centre[0][0] = 1;
+                    centre[0][1] = 0;
+                    for (unsigned int n = 1; n <= max_n; ++n) {
+                        if (n % 32 == 0) {
+                            // bound the accumulation of rounding errors for large indices
+                            centre[n][0] = cos(n * phi);
+                            centre[n][1] = -sin(n * phi);
+                        }
+                        else {
+                            centre[n] = complex_prod(centre[n - 1], e);
+                        }
+                        // negative powers are the complex conjugates
+                        centre[-int(n)][0] = centre[n][0];
+                        centre[-int(n)][1] = -centre[n][1];
+                    }
+                    table += 2 * max_n + 1;
+                }
+
+                // 2nd loop: iterate over wavevectors
+                for (size_t k = 0; k < nq; ++k) {
+                    index_type const& offset = offset_[k];
+                    mode_type z = power[offset[0]];
+                    for (int i = 1; i < dimension; ++i) {
+                        z = complex_prod(z, power[offset[i]]);
+                    }
+                    rho[k] += z;
+                }
+            }
+        });
+
+        // reduce partial sums in thread order
+        for (unsigned int thread = 1; thread < nthread; ++thread) {
+            mode_type const* rho = partial_.data() + (thread - 1) * nq;
             auto rho_q = begin(*result_);
-            for (auto const& q : wavevector) {
-                float_type q_r = inner_prod(static_cast<vector_type>(q), r);
-                *rho_q++ += mode_type({{ cos(q_r), -sin(q_r) }});
+            for (size_t k = 0; k < nq; ++k) {
+                *rho_q++ += rho[k];
             }
         }
 
@@ -118,6 +215,7 @@ void density_mode<dimension, float_type>::luaopen(lua_State* L)
               , shared_ptr<particle_type const>
               , shared_ptr<particle_group_type>
               , shared_ptr<wavevector_type const>
+              , shared_ptr<thread_pool_type>
               , shared_ptr<logger>
             >)
         ]
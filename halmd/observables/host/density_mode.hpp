@@ -24,6 +24,7 @@
 
 #include <lua.hpp>
 #include <memory>
+#include <vector>
 
 #include <halmd/io/logger.hpp>
 #include <halmd/mdsim/host/particle.hpp>
@@ -33,6 +34,7 @@
 #include <halmd/utility/owner_equal.hpp>
 #include <halmd/utility/profiler.hpp>
 #include <halmd/utility/raw_array.hpp>
+#include <halmd/utility/thread_pool.hpp>
 
 namespace halmd {
 namespace observables {
@@ -47,6 +49,15 @@ namespace host {
  * efficient copying, e.g., in dynamics::blocking_scheme.  Further, the result
  * may be tracked by std::weak_ptr providing a similar functionality as
  * halmd::cache
+ *
+ * The wavevectors are points of the reciprocal lattice of the periodic
+ * simulation box, @f$ \vec q = 2\pi (n_1 / L_1, n_2 / L_2, \dots) @f$ with
+ * integer Miller indices @f$ n_\alpha @f$. Thus the exponentials factorise
+ * into integer powers of @f$ \exp(\textrm{i} 2\pi r_\alpha / L_\alpha) @f$,
+ * which are obtained for each particle from a complex recurrence with a
+ * single evaluation of sine and cosine per Cartesian component. The particles
+ * are distributed over the threads of the thread pool, and the per-thread
+ * partial sums are reduced in a fixed order.
  */
 template <int dimension, typename float_type>
 class density_mode
@@ -56,11 +67,13 @@ public:
     typedef mdsim::host::particle_group particle_group_type;
     typedef observables::utility::wavevector<dimension> wavevector_type;
     typedef raw_array<fixed_vector<double, 2>> result_type;
+    typedef halmd::utility::thread_pool thread_pool_type;
 
     density_mode(
         std::shared_ptr<particle_type const> particle
       , std::shared_ptr<particle_group_type> particle_group
       , std::shared_ptr<wavevector_type const> wavevector
+      , std::shared_ptr<thread_pool_type> thread_pool = std::make_shared<thread_pool_type>()
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("density_mode")
     );
 
@@ -98,6 +111,8 @@ public:
 
 private:
     typedef fixed_vector<float_type, dimension> vector_type;
+    typedef typename result_type::value_type mode_type;
+    typedef fixed_vector<unsigned int, dimension> index_type;
 
     /** system state */
     std::shared_ptr<particle_type const> particle_;
@@ -105,9 +120,24 @@ private:
     std::shared_ptr<particle_group_type> particle_group_;
     /** wavevector list */
     std::shared_ptr<wavevector_type const> wavevector_;
+    /** thread pool */
+    std::shared_ptr<thread_pool_type> thread_pool_;
     /** logger instance */
     std::shared_ptr<logger> logger_;
 
+    /** reciprocal edge lengths of the simulation box times 2π */
+    fixed_vector<double, dimension> unit_wavenumber_;
+    /** maximum absolute Miller index per Cartesian component */
+    index_type max_index_;
+    /** offsets of the Miller indices of each wavevector in the table of powers */
+    std::vector<index_type> offset_;
+    /** number of entries of the table of powers */
+    unsigned int table_size_;
+    /** tables of powers of exp(-i 2π r / L) of each thread */
+    std::vector<mode_type> power_;
+    /** partial sums of density modes of threads 1, 2, … */
+    std::vector<mode_type> partial_;
+
     /** result for the density modes */
     std::shared_ptr<result_type> result_;
     /** cache observer for particle positions */
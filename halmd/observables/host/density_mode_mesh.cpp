@@ -0,0 +1,386 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/observables/host/density_mode_mesh.hpp>
+#include <halmd/utility/lua/lua.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace halmd {
+namespace observables {
+namespace host {
+
+template <int dimension, typename float_type>
+density_mode_mesh<dimension, float_type>::density_mode_mesh(
+    shared_ptr<particle_type const> particle
+  , shared_ptr<particle_group_type> particle_group
+  , shared_ptr<wavevector_type const> wavevector
+  , unsigned int order
+  , unsigned int oversampling
+  , shared_ptr<thread_pool_type> thread_pool
+  , shared_ptr<logger> logger
+)
+    // dependency injection
+  : particle_(particle)
+  , particle_group_(particle_group)
+  , wavevector_(wavevector)
+  , thread_pool_(thread_pool)
+  , logger_(logger)
+  // initialise parameters
+  , order_(order)
+{
+    if (order != 2 && order != 3) {
+        throw invalid_argument("order of assignment function must be 2 (cloud-in-cell) or 3 (triangular-shaped cloud)");
+    }
+    if (oversampling < 1) {
+        throw invalid_argument("oversampling factor of mesh must be positive");
+    }
+
+    fixed_vector<double, dimension> const& box_length = wavevector_->box_length();
+    fixed_vector<double, dimension> unit_wavenumber = element_div(fixed_vector<double, dimension>(2 * M_PI), box_length);
+
+    // determine Miller indices of the wavevectors
+    auto const& q = wavevector_->value();
+    vector<fixed_vector<int, dimension>> miller(q.size());
+    mesh_size_type max_index = 0;
+    for (size_t k = 0; k < q.size(); ++k) {
+        fixed_vector<double, dimension> n = element_div(q[k], unit_wavenumber);
+        for (int i = 0; i < dimension; ++i) {
+            miller[k][i] = static_cast<int>(lround(n[i]));
+            if (fabs(n[i] - miller[k][i]) > 1e-6 * max(fabs(n[i]), 1.)) {
+                throw logic_error("wavevector is not compatible with the reciprocal lattice of the simulation box");
+            }
+            max_index[i] = max(max_index[i], static_cast<unsigned int>(abs(miller[k][i])));
+        }
+    }
+
+    // choose smallest power of two above the oversampled Nyquist index
+    mesh_points_ = 1;
+    for (int i = 0; i < dimension; ++i) {
+        unsigned int size = 1;
+        if (max_index[i] > 0) {
+            while (size <= 2 * oversampling * max_index[i]) {
+                size *= 2;
+            }
+        }
+        mesh_size_[i] = size;
+        mesh_points_ *= size;
+        mesh_scale_[i] = size / box_length[i];
+        fft_.emplace_back(size);
+    }
+
+    // locate wavevectors on the mesh and tabulate the deconvolution factors
+    mesh_index_.resize(q.size());
+    deconvolution_.resize(q.size());
+    for (size_t k = 0; k < q.size(); ++k) {
+        size_t index = 0;
+        double window = 1;
+        for (int i = 0; i < dimension; ++i) {
+            int const size = mesh_size_[i];
+            index = index * size + ((miller[k][i] % size) + size) % size;
+            if (miller[k][i] != 0) {
+                double x = M_PI * miller[k][i] / size;
+                window *= pow(sin(x) / x, order_);
+            }
+        }
+        mesh_index_[k] = index;
+        deconvolution_[k] = 1 / window;
+    }
+
+    LOG("order of assignment function: " << order_);
+    LOG("number of mesh points per axis: " << mesh_size_);
+}
+
+template <int dimension, typename float_type>
+shared_ptr<typename density_mode_mesh<dimension, float_type>::result_type const>
+density_mode_mesh<dimension, float_type>::acquire()
+{
+    // check validity of caches
+    auto const& group_cache  = particle_group_->ordered();
+    auto const& position_cache = particle_->position();
+
+    if (group_cache_ != group_cache || position_cache_ != position_cache) {
+        // obtain read access to input caches
+        auto const& group = read_cache(group_cache);
+        auto const& position = read_cache(position_cache);
+
+        LOG_DEBUG("acquire sample");
+
+        scoped_timer_type timer(runtime_.acquire);
+
+        assign_(group, position);
+        transform_();
+
+        // allocate new memory which allows modules (e.g.,
+        // dynamics::blocking_scheme) to hold a previous copy of the result or
+        // to track the update via std::weak_ptr.
+        size_t const nq = mesh_index_.size();
+        result_ = make_shared<result_type>(nq);
+        for (size_t k = 0; k < nq; ++k) {
+            complex_type rho = mesh_[mesh_index_[k]] * deconvolution_[k];
+            (*result_)[k][0] = rho.real();
+            (*result_)[k][1] = rho.imag();
+        }
+
+        // update cache observers
+        group_cache_ = group_cache;
+        position_cache_ = position_cache;
+    }
+
+    return result_;
+}
+
+/**
+ * Compute mesh indices and weights of the assignment function per axis
+ */
+template <int dimension, typename float_type>
+void density_mode_mesh<dimension, float_type>::stencil_(
+    vector_type const& r
+  , fixed_vector<unsigned int, dimension>* index
+  , fixed_vector<double, dimension>* weight
+) const
+{
+    for (int i = 0; i < dimension; ++i) {
+        double s = r[i] * mesh_scale_[i];
+        long base;
+        if (order_ == 2) {
+            // cloud-in-cell
+            base = static_cast<long>(floor(s));
+            double f = s - base;
+            weight[0][i] = 1 - f;
+            weight[1][i] = f;
+        }
+        else {
+            // triangular-shaped cloud, centred at nearest mesh point
+            long centre = static_cast<long>(floor(s + 0.5));
+            double d = s - centre;
+            weight[0][i] = 0.5 * (0.5 - d) * (0.5 - d);
+            weight[1][i] = 0.75 - d * d;
+            weight[2][i] = 0.5 * (0.5 + d) * (0.5 + d);
+            base = centre - 1;
+        }
+        long const size = mesh_size_[i];
+        unsigned int m = ((base % size) + size) % size;
+        for (unsigned int p = 0; p < order_; ++p) {
+            index[p][i] = m;
+            m = (m + 1 == size) ? 0 : m + 1;
+        }
+    }
+}
+
+/**
+ * Assign particles to the mesh
+ *
+ * The mesh is divided along the first axis into slabs of two planes, which
+ * is at least the extent of the assignment function minus one. Thus, the
+ * particles of a slab, whose stencils start within the slab, contribute to
+ * this and to the following slab only. The particles are sorted by slab,
+ * and the even and the odd slabs are processed in two parallel passes,
+ * which write to the shared mesh without conflicts. The result does not
+ * depend on the number of threads.
+ */
+template <int dimension, typename float_type>
+void density_mode_mesh<dimension, float_type>::assign_(
+    particle_group_type::array_type const& group
+  , typename particle_type::position_array_type const& position
+)
+{
+    scoped_timer_type timer(runtime_.assign);
+
+    unsigned int const nthread = thread_pool_->size();
+    unsigned int const slab_planes = min(mesh_size_[0], 2u);
+    unsigned int const nslab = mesh_size_[0] / slab_planes;
+
+    // count particles per slab, with fixed blocks of particles per thread
+    slab_.resize(group.size());
+    slab_count_.assign(nslab * nthread, 0);
+    thread_pool_->parallel_for(0, group.size(), [&](unsigned int thread, size_t first, size_t last) {
+        fixed_vector<unsigned int, dimension> index[3];
+        fixed_vector<double, dimension> weight[3];
+        for (size_t j = first; j < last; ++j) {
+            stencil_(position[group[j]], index, weight);
+            unsigned int slab = index[0][0] / slab_planes;
+            slab_[j] = slab;
+            ++slab_count_[slab * nthread + thread];
+        }
+    });
+
+    // exclusive prefix sum over slabs, and threads within a slab
+    unsigned int count = 0;
+    for (unsigned int& n : slab_count_) {
+        count += n;
+        n = count - n;
+    }
+    slab_offset_.resize(nslab + 1);
+    for (unsigned int slab = 0; slab < nslab; ++slab) {
+        slab_offset_[slab] = slab_count_[slab * nthread];
+    }
+    slab_offset_[nslab] = group.size();
+
+    // scatter particles, which preserves their order within a slab
+    slab_particle_.resize(group.size());
+    thread_pool_->parallel_for(0, group.size(), [&](unsigned int thread, size_t first, size_t last) {
+        for (size_t j = first; j < last; ++j) {
+            slab_particle_[slab_count_[slab_[j] * nthread + thread]++] = j;
+        }
+    });
+
+    mesh_.resize(mesh_points_);
+    thread_pool_->parallel_for(0, mesh_points_, [&](unsigned int, size_t first, size_t last) {
+        fill(mesh_.begin() + first, mesh_.begin() + last, complex_type(0));
+    });
+
+    // assign even slabs, then odd slabs
+    for (unsigned int parity = 0; parity < min(nslab, 2u); ++parity) {
+        thread_pool_->parallel_for(0, (nslab - parity + 1) / 2, [&](unsigned int, size_t first, size_t last) {
+            // mesh indices and weights of the assignment function per axis
+            fixed_vector<unsigned int, dimension> index[3];
+            fixed_vector<double, dimension> weight[3];
+
+            for (size_t k = first; k < last; ++k) {
+                unsigned int const slab = 2 * k + parity;
+                for (unsigned int n = slab_offset_[slab]; n < slab_offset_[slab + 1]; ++n) {
+                    stencil_(position[group[slab_particle_[n]]], index, weight);
+
+                    // add weights of the order^dimension mesh points
+                    fixed_vector<unsigned int, dimension> p(0);
+                    for (;;) {
+                        size_t offset = 0;
+                        double w = 1;
+                        for (int i = 0; i < dimension; ++i) {
+                            offset = offset * mesh_size_[i] + index[p[i]][i];
+                            w *= weight[p[i]][i];
+                        }
+                        mesh_[offset] += w;
+
+                        // advance to next point of the stencil
+                        int i = dimension - 1;
+                        while (i >= 0 && ++p[i] == order_) {
+                            p[i--] = 0;
+                        }
+                        if (i < 0) {
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+/**
+ * Fourier transform the mesh along each axis
+ */
+template <int dimension, typename float_type>
+void density_mode_mesh<dimension, float_type>::transform_()
+{
+    scoped_timer_type timer(runtime_.fft);
+
+    unsigned int const nthread = thread_pool_->size();
+    size_t stride = mesh_points_;
+    for (int i = 0; i < dimension; ++i) {
+        size_t const size = mesh_size_[i];
+        stride /= size;
+        if (size == 1) {
+            continue;
+        }
+        buffer_.resize(nthread * size);
+
+        // copy each line of the mesh along axis i to a contiguous buffer
+        thread_pool_->parallel_for(0, mesh_points_ / size, [&](unsigned int thread, size_t first, size_t last) {
+            complex_type* buffer = buffer_.data() + thread * size;
+            for (size_t line = first; line < last; ++line) {
+                complex_type* start = mesh_.data() + (line / stride) * size * stride + line % stride;
+                for (size_t k = 0; k < size; ++k) {
+                    buffer[k] = start[k * stride];
+                }
+                fft_[i](buffer);
+                for (size_t k = 0; k < size; ++k) {
+                    start[k * stride] = buffer[k];
+                }
+            }
+        });
+    }
+}
+
+template <int dimension, typename float_type>
+void density_mode_mesh<dimension, float_type>::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("observables")
+        [
+            namespace_("host")
+            [
+                class_<density_mode_mesh>()
+                    .property("acquisitor", &density_mode_mesh::acquisitor)
+                    .property("wavevector", &density_mode_mesh::wavevector)
+                    .property("mesh_size", &density_mode_mesh::mesh_size)
+                    .scope
+                    [
+                        class_<runtime>("runtime")
+                            .def_readonly("acquire", &runtime::acquire)
+                            .def_readonly("assign", &runtime::assign)
+                            .def_readonly("fft", &runtime::fft)
+                    ]
+                    .def_readonly("runtime", &density_mode_mesh::runtime_)
+            ]
+          , def("density_mode_mesh", &make_shared<density_mode_mesh
+              , shared_ptr<particle_type const>
+              , shared_ptr<particle_group_type>
+              , shared_ptr<wavevector_type const>
+              , unsigned int
+              , unsigned int
+              , shared_ptr<thread_pool_type>
+              , shared_ptr<logger>
+            >)
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_observables_host_density_mode_mesh(lua_State* L)
+{
+#ifndef USE_HOST_SINGLE_PRECISION
+    density_mode_mesh<3, double>::luaopen(L);
+    density_mode_mesh<2, double>::luaopen(L);
+#else
+    density_mode_mesh<3, float>::luaopen(L);
+    density_mode_mesh<2, float>::luaopen(L);
+#endif
+    return 0;
+}
+
+// explicit instantiation
+#ifndef USE_HOST_SINGLE_PRECISION
+template class density_mode_mesh<3, double>;
+template class density_mode_mesh<2, double>;
+#else
+template class density_mode_mesh<3, float>;
+template class density_mode_mesh<2, float>;
+#endif
+
+}  // namespace host
+}  // namespace observables
+}  // namespace halmd
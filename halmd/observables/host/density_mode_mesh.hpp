@@ -0,0 +1,215 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_OBSERVABLES_HOST_DENSITY_MODE_MESH_HPP
+#define HALMD_OBSERVABLES_HOST_DENSITY_MODE_MESH_HPP
+
+#include <complex>
+#include <lua.hpp>
+#include <memory>
+#include <vector>
+
+#include <halmd/algorithm/host/fft.hpp>
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_group.hpp>
+#include <halmd/observables/utility/wavevector.hpp>
+#include <halmd/utility/cache.hpp>
+#include <halmd/utility/profiler.hpp>
+#include <halmd/utility/raw_array.hpp>
+#include <halmd/utility/thread_pool.hpp>
+
+namespace halmd {
+namespace observables {
+namespace host {
+
+/**
+ * Compute Fourier modes of the particle density on a mesh.
+ *
+ * @f$ \rho_{\vec q} = \sum_{i=1}^N \exp(\textrm{i}\vec q \cdot \vec r_i) @f$
+ *
+ * The particles are assigned to a periodic mesh by a charge assignment
+ * function of order p, i.e., cloud-in-cell (p = 2) or triangular-shaped
+ * cloud (p = 3). The mesh density is Fourier transformed by an FFT, and the
+ * modes at the wavevectors are divided by the Fourier transform of the
+ * assignment function, @f$ \prod_\alpha \operatorname{sinc}(\pi n_\alpha /
+ * M_\alpha)^p @f$, with the Miller indices @f$ n_\alpha @f$ and the mesh size
+ * @f$ M_\alpha @f$. The computational cost is @f$ O(N p^d + M \log M) @f$ for
+ * all wavevectors, compared to @f$ O(N n_q) @f$ of density_mode.
+ *
+ * The mesh size is the smallest power of two that exceeds the largest Miller
+ * index along the respective axis by the factor 2 × oversampling. The
+ * remaining error is due to aliasing and decreases with the oversampling
+ * factor and with the order of the assignment function. Along axes that
+ * carry no wavevector component, the mesh is a single point.
+ *
+ * The result type coincides with that of density_mode, so either module
+ * may serve as input for the static structure factor or the intermediate
+ * scattering function. The particles are sorted into slabs of the mesh along
+ * the first axis, and alternate slabs are assigned in parallel to the shared
+ * mesh, so that the result does not depend on the number of threads. The
+ * Fourier transforms along the mesh lines are distributed over the threads.
+ */
+template <int dimension, typename float_type>
+class density_mode_mesh
+{
+public:
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::host::particle_group particle_group_type;
+    typedef observables::utility::wavevector<dimension> wavevector_type;
+    typedef raw_array<fixed_vector<double, 2>> result_type;
+    typedef halmd::utility::thread_pool thread_pool_type;
+    typedef fixed_vector<unsigned int, dimension> mesh_size_type;
+
+    /**
+     * Construct density modes for the given order of the assignment
+     * function, 2 (cloud-in-cell) or 3 (triangular-shaped cloud), and the
+     * oversampling factor of the mesh.
+     */
+    density_mode_mesh(
+        std::shared_ptr<particle_type const> particle
+      , std::shared_ptr<particle_group_type> particle_group
+      , std::shared_ptr<wavevector_type const> wavevector
+      , unsigned int order
+      , unsigned int oversampling
+      , std::shared_ptr<thread_pool_type> thread_pool = std::make_shared<thread_pool_type>()
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("density_mode_mesh")
+    );
+
+    /** Compute density modes from particle group.
+     *
+     * The result is re-computed only if the particle positions have been
+     * modified. In this case, the data array managed by std::shared_ptr is
+     * re-allocated before.
+     */
+    std::shared_ptr<result_type const> acquire();
+
+    /**
+     * Functor wrapping acquire() for class instance stored within std::shared_ptr
+     */
+    static std::function<std::shared_ptr<result_type const> ()>
+    acquisitor(std::shared_ptr<density_mode_mesh> self)
+    {
+        return [=]() {
+           return self->acquire();
+        };
+    }
+
+    /**
+     * Return wavevector instance passed to constructor
+     */
+    std::shared_ptr<wavevector_type const> wavevector()
+    {
+        return wavevector_;
+    }
+
+    /** returns number of mesh points per axis */
+    mesh_size_type const& mesh_size() const
+    {
+        return mesh_size_;
+    }
+
+    /**
+     * Bind class to Lua.
+     */
+    static void luaopen(lua_State* L);
+
+private:
+    typedef typename particle_type::vector_type vector_type;
+    typedef std::complex<double> complex_type;
+
+    /** assign particles to mesh */
+    void assign_(
+        particle_group_type::array_type const& group
+      , typename particle_type::position_array_type const& position
+    );
+    /** compute mesh indices and weights of assignment function per axis */
+    void stencil_(
+        vector_type const& r
+      , fixed_vector<unsigned int, dimension>* index
+      , fixed_vector<double, dimension>* weight
+    ) const;
+    /** Fourier transform mesh in place along each axis */
+    void transform_();
+
+    /** system state */
+    std::shared_ptr<particle_type const> particle_;
+    /** particle group */
+    std::shared_ptr<particle_group_type> particle_group_;
+    /** wavevector list */
+    std::shared_ptr<wavevector_type const> wavevector_;
+    /** thread pool */
+    std::shared_ptr<thread_pool_type> thread_pool_;
+    /** logger instance */
+    std::shared_ptr<logger> logger_;
+
+    /** order of the assignment function */
+    unsigned int order_;
+    /** number of mesh points per axis */
+    mesh_size_type mesh_size_;
+    /** total number of mesh points */
+    std::size_t mesh_points_;
+    /** inverse mesh spacings */
+    fixed_vector<double, dimension> mesh_scale_;
+    /** Fourier transforms along each axis */
+    std::vector<fft<double>> fft_;
+    /** linear mesh index of each wavevector */
+    std::vector<std::size_t> mesh_index_;
+    /** reciprocal Fourier transform of assignment function for each wavevector */
+    std::vector<double> deconvolution_;
+    /** slab of each particle in the group */
+    std::vector<unsigned int> slab_;
+    /** particle counts per slab and thread, and scatter offsets */
+    std::vector<unsigned int> slab_count_;
+    /** offsets of the slabs in slab_particle_ */
+    std::vector<unsigned int> slab_offset_;
+    /** group indices of particles sorted by slab */
+    std::vector<unsigned int> slab_particle_;
+    /** complex mesh */
+    std::vector<complex_type> mesh_;
+    /** contiguous buffers for the Fourier transforms of the threads */
+    std::vector<complex_type> buffer_;
+
+    /** result for the density modes */
+    std::shared_ptr<result_type> result_;
+    /** cache observer for particle positions */
+    cache<> position_cache_;
+    /** cache observer for particle group */
+    cache<> group_cache_;
+
+    typedef halmd::utility::profiler::accumulator_type accumulator_type;
+    typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
+
+    struct runtime
+    {
+        accumulator_type acquire;
+        accumulator_type assign;
+        accumulator_type fft;
+    };
+
+    /** profiling runtime accumulators */
+    runtime runtime_;
+};
+
+} // namespace host
+} // namespace observables
+} // namespace halmd
+
+#endif /* ! HALMD_OBSERVABLES_HOST_DENSITY_MODE_MESH_HPP */
@@ -21,6 +21,7 @@
 #include <halmd/io/logger.hpp>
 #include <halmd/observables/dynamics/correlation.hpp>
 #include <halmd/observables/host/dynamics/mean_quartic_displacement.hpp>
+#include <halmd/observables/host/dynamics/multi_tau.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
 namespace halmd {
@@ -69,6 +70,7 @@ void mean_quartic_displacement<dimension, float_type>::luaopen(lua_State* L)
             namespace_("dynamics")
             [
                 class_<mean_quartic_displacement>()
+                    .property("multi_tau", &multi_tau_supported<mean_quartic_displacement>)
 
               , def("mean_quartic_displacement", &select_tcf_by_acquire<mean_quartic_displacement>)
             ]
@@ -86,6 +88,10 @@ HALMD_LUA_API int luaopen_libhalmd_observables_host_dynamics_mean_quartic_displa
     observables::dynamics::correlation<mean_quartic_displacement<2, double> >::luaopen(L);
     observables::dynamics::correlation<mean_quartic_displacement<3, float> >::luaopen(L);
     observables::dynamics::correlation<mean_quartic_displacement<2, float> >::luaopen(L);
+    multi_tau<mean_quartic_displacement<3, double> >::luaopen(L);
+    multi_tau<mean_quartic_displacement<2, double> >::luaopen(L);
+    multi_tau<mean_quartic_displacement<3, float> >::luaopen(L);
+    multi_tau<mean_quartic_displacement<2, float> >::luaopen(L);
     return 0;
 }
 
@@ -94,6 +100,13 @@ template class mean_quartic_displacement<3, double>;
 template class mean_quartic_displacement<2, double>;
 template class mean_quartic_displacement<3, float>;
 template class mean_quartic_displacement<2, float>;
+#ifndef USE_HOST_SINGLE_PRECISION
+template class multi_tau<mean_quartic_displacement<3, double> >;
+template class multi_tau<mean_quartic_displacement<2, double> >;
+#else
+template class multi_tau<mean_quartic_displacement<3, float> >;
+template class multi_tau<mean_quartic_displacement<2, float> >;
+#endif
 
 } // namespace dynamics
 } // namespace host
@@ -24,6 +24,7 @@
 #include <halmd/io/logger.hpp>
 #include <halmd/observables/dynamics/correlation.hpp>
 #include <halmd/observables/host/dynamics/mean_square_displacement.hpp>
+#include <halmd/observables/host/dynamics/multi_tau.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
 namespace halmd {
@@ -65,6 +66,7 @@ void mean_square_displacement<dimension, float_type>::luaopen(lua_State* L)
             namespace_("dynamics")
             [
                 class_<mean_square_displacement>()
+                    .property("multi_tau", &multi_tau_supported<mean_square_displacement>)
 
               , def("mean_square_displacement", &select_tcf_by_acquire<mean_square_displacement>)
             ]
@@ -82,6 +84,10 @@ HALMD_LUA_API int luaopen_libhalmd_observables_host_dynamics_mean_square_displac
     observables::dynamics::correlation<mean_square_displacement<2, double> >::luaopen(L);
     observables::dynamics::correlation<mean_square_displacement<3, float> >::luaopen(L);
     observables::dynamics::correlation<mean_square_displacement<2, float> >::luaopen(L);
+    multi_tau<mean_square_displacement<3, double> >::luaopen(L);
+    multi_tau<mean_square_displacement<2, double> >::luaopen(L);
+    multi_tau<mean_square_displacement<3, float> >::luaopen(L);
+    multi_tau<mean_square_displacement<2, float> >::luaopen(L);
     return 0;
 }
 
@@ -90,6 +96,13 @@ template class mean_square_displacement<3, double>;
 template class mean_square_displacement<2, double>;
 template class mean_square_displacement<3, float>;
 template class mean_square_displacement<2, float>;
+#ifndef USE_HOST_SINGLE_PRECISION
+template class multi_tau<mean_square_displacement<3, double> >;
+template class multi_tau<mean_square_displacement<2, double> >;
+#else
+template class multi_tau<mean_square_displacement<3, float> >;
+template class multi_tau<mean_square_displacement<2, float> >;
+#endif
 
 } // namespace dynamics
 } // namespace host
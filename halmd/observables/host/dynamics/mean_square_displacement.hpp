@@ -42,6 +42,7 @@ public:
     typedef host::samples::sample<dimension, float_type> sample_type;
     typedef typename sample_type::data_type vector_type;
     typedef double result_type;
+    typedef observables::dynamics::mean_square_displacement<dimension, float_type> correlate_function_type;
 
     static void luaopen(lua_State* L);
 
@@ -53,9 +54,6 @@ public:
      * @param result returns MSD at lag time t2 - t1, averaged over all particles of specified type
      */
     void operator() (sample_type const& first, sample_type const& second, accumulator<result_type>& result);
-
-private:
-    typedef observables::dynamics::mean_square_displacement<dimension, float_type> correlate_function_type;
 };
 
 } // namespace dynamics
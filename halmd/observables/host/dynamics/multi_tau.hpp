@@ -0,0 +1,460 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_OBSERVABLES_HOST_DYNAMICS_MULTI_TAU_HPP
+#define HALMD_OBSERVABLES_HOST_DYNAMICS_MULTI_TAU_HPP
+
+#include <boost/multi_array.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/observables/host/samples/sample.hpp>
+#include <halmd/utility/lua/lua.hpp>
+#include <halmd/utility/profiler.hpp>
+
+namespace halmd {
+namespace observables {
+namespace host {
+namespace dynamics {
+
+/**
+ * Order-n multi-tau correlator for per-particle time correlation functions
+ *
+ * The correlator processes each sample as it is acquired and stores only
+ * the per-particle data of the last block_size samples for each
+ * coarse-graining level in a ring buffer, see
+ *
+ *   J. Ramírez, S. K. Sukumaran, B. Vorselaars, and A. E. Likhtman,
+ *   Efficient on the fly calculation of time correlation functions in
+ *   computer simulations, J. Chem. Phys. 133, 154103 (2010)
+ *
+ *   D. Frenkel and B. Smit, Understanding Molecular Simulation, 2nd ed.,
+ *   Academic Press (2002), section 4.4.2
+ *
+ * Level k holds data separated by resolution × block_size^k. Each new
+ * entry is correlated with all entries of its level, which yields the
+ * correlation function on the same time grid as the even levels of the
+ * blocking scheme, but with every sample serving as time origin. Every
+ * block_size-th entry of level k, or the block average of block_size
+ * consecutive entries, is passed on to level k + 1. Decimation is exact for
+ * displacements, while block averaging additionally smooths the data, as
+ * is commonly done for the velocity autocorrelation function.
+ *
+ * The correlation functions are averages over particles of per-particle
+ * correlations, hence every level holds the particle data of its entries.
+ * Each correlator keeps a private ring buffer of block_size() entries per
+ * level and, with block averaging, one more entry per level for the block
+ * sums. That is (block_size() + 1) × count() × N elements of data_type,
+ * e.g., about 650 MB for the mean-square displacement of 10⁵ particles in
+ * three dimensions with 16 levels of 16 entries in double precision. The
+ * memory is allocated upon the first sample, and there are no per-sample
+ * allocations. Unlike the blocking scheme, correlators of the same
+ * observable do not share their buffers.
+ */
+template <typename tcf_type>
+class multi_tau
+{
+public:
+    typedef typename tcf_type::sample_type sample_type;
+    typedef typename tcf_type::correlate_function_type correlate_function_type;
+    typedef typename sample_type::data_type data_type;
+    typedef std::function<std::shared_ptr<sample_type const> ()> acquire_type;
+    typedef mdsim::clock clock_type;
+    typedef clock_type::step_type step_type;
+    typedef clock_type::time_type time_type;
+    typedef double result_type;
+    typedef boost::multi_array<accumulator<result_type>, 2> block_result_type;
+    typedef boost::multi_array<result_type, 2> block_mean_type;
+    typedef boost::multi_array<accumulator<result_type>::size_type, 2> block_count_type;
+    typedef boost::multi_array<time_type, 2> block_time_type;
+
+    /**
+     * @param acquire           acquisitor of particle data
+     * @param clock             simulation clock
+     * @param maximum_lag_time  maximum lag time for correlations
+     * @param resolution        time resolution of lowest level, i.e., sampling interval
+     * @param block_size        number of entries per level, i.e., coarse-graining factor
+     * @param average           pass block averages instead of every block_size-th entry to next level,
+     *                          which is the default of the Lua bindings
+     */
+    multi_tau(
+        acquire_type const& acquire
+      , std::shared_ptr<clock_type const> clock
+      , time_type maximum_lag_time
+      , time_type resolution
+      , unsigned int block_size
+      , bool average
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("dynamics.multi_tau")
+    );
+
+    /** acquire sample and update correlations */
+    void sample();
+
+    /** returns number of coarse-graining levels */
+    unsigned int count() const
+    {
+        return level_.size();
+    }
+
+    /** returns number of entries per level */
+    unsigned int block_size() const
+    {
+        return block_size_;
+    }
+
+    /** returns accumulated results */
+    block_result_type const& result() const
+    {
+        return result_;
+    }
+
+    /** returns time grid of correlation functions */
+    block_time_type const& time() const
+    {
+        return time_;
+    }
+
+    static std::function<block_mean_type const& ()>
+    get_mean(std::shared_ptr<multi_tau> self);
+
+    static std::function<block_mean_type const& ()>
+    get_error(std::shared_ptr<multi_tau> self);
+
+    static std::function<block_count_type const& ()>
+    get_count(std::shared_ptr<multi_tau> self);
+
+    /**
+     * Construct correlator for given time correlation function.
+     *
+     * The instance of the time correlation function serves for the
+     * selection of the template by the Lua bindings only.
+     */
+    static std::shared_ptr<multi_tau>
+    create(
+        std::shared_ptr<tcf_type const>
+      , acquire_type const& acquire
+      , std::shared_ptr<clock_type const> clock
+      , time_type maximum_lag_time
+      , time_type resolution
+      , unsigned int block_size
+      , bool average
+      , std::shared_ptr<halmd::logger> logger
+    )
+    {
+        return std::make_shared<multi_tau>(acquire, clock, maximum_lag_time, resolution, block_size, average, logger);
+    }
+
+    /** Lua bindings */
+    static void luaopen(lua_State* L);
+
+private:
+    typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
+
+    struct runtime
+    {
+        halmd::utility::profiler::accumulator_type tcf;
+    };
+
+    /** coarse-graining level */
+    struct level_type
+    {
+        /** ring buffer of block_size entries of the particle data */
+        std::vector<data_type> data;
+        /** number of entries pushed to this level */
+        step_type nentry;
+        /** sum of entries of current block, for block averaging */
+        std::vector<data_type> block_sum;
+    };
+
+    /** append entry to level and correlate with the stored entries */
+    void push_(unsigned int level, data_type const* entry);
+
+    /** acquisitor of particle data */
+    acquire_type acquire_;
+    /** simulation clock */
+    std::shared_ptr<clock_type const> clock_;
+    /** module logger */
+    std::shared_ptr<logger> logger_;
+    /** number of entries per level */
+    unsigned int block_size_;
+    /** pass block averages to next level */
+    bool average_;
+    /** number of particles */
+    std::size_t nparticle_;
+    /** coarse-graining levels */
+    std::vector<level_type> level_;
+    /** accumulated results */
+    block_result_type result_;
+    /** mean values */
+    block_mean_type mean_;
+    /** standard error of mean */
+    block_mean_type error_;
+    /** accumulator count */
+    block_count_type count_;
+    /** time grid */
+    block_time_type time_;
+    /** snapshot of time step at construction */
+    time_type timestep_;
+    /** profiling runtime accumulators */
+    runtime runtime_;
+};
+
+template <typename tcf_type>
+multi_tau<tcf_type>::multi_tau(
+    acquire_type const& acquire
+  , std::shared_ptr<clock_type const> clock
+  , time_type maximum_lag_time
+  , time_type resolution
+  , unsigned int block_size
+  , bool average
+  , std::shared_ptr<logger> logger
+)
+  : acquire_(acquire)
+  , clock_(clock)
+  , logger_(logger)
+  , block_size_(block_size)
+  , average_(average)
+  , nparticle_(0)
+  , timestep_(clock_->timestep())
+{
+    if (block_size_ < 2) {
+        throw std::invalid_argument("Minimum size of coarse-graining blocks is 2.");
+    }
+    if (resolution <= 0) {
+        throw std::invalid_argument("Resolution must be a positive value.");
+    }
+    step_type max_interval = static_cast<step_type>(std::round(maximum_lag_time / timestep_));
+    step_type s = static_cast<step_type>(std::round(resolution / timestep_));
+    if (s == 0) {
+        throw std::invalid_argument("Resolution must not be smaller than the integration time step.");
+    }
+
+    std::vector<step_type> interval;
+    for (; s <= max_interval; s *= block_size_) {
+        interval.push_back(s);
+    }
+    if (interval.empty()) {
+        throw std::invalid_argument("Sampling interval of dynamic correlations is too large.");
+    }
+    level_.resize(interval.size());
+    LOG("number of coarse-graining levels: " << level_.size());
+    LOG("size of coarse-graining levels: " << block_size_);
+    LOG("coarse-grain by " << (average_ ? "block averages" : "decimation"));
+
+    result_.resize(boost::extents[level_.size()][block_size_]);
+    mean_.resize(boost::extents[level_.size()][block_size_]);
+    error_.resize(boost::extents[level_.size()][block_size_]);
+    count_.resize(boost::extents[level_.size()][block_size_]);
+    time_.resize(boost::extents[level_.size()][block_size_]);
+    for (unsigned int i = 0; i < level_.size(); ++i) {
+        for (unsigned int j = 0; j < block_size_; ++j) {
+            time_[i][j] = (interval[i] * j) * timestep_;
+        }
+    }
+}
+
+template <typename tcf_type>
+void multi_tau<tcf_type>::sample()
+{
+    if (clock_->timestep() != timestep_) {
+        throw std::logic_error("multi-tau correlator does not allow variable time step");
+    }
+    std::shared_ptr<sample_type const> sample = acquire_();
+    auto const& data = sample->data();
+
+    if (nparticle_ == 0) {
+        // allocate ring buffers upon first sample
+        nparticle_ = data.size();
+        for (level_type& level : level_) {
+            level.data.resize(block_size_ * nparticle_);
+            level.nentry = 0;
+            if (average_) {
+                level.block_sum.assign(nparticle_, data_type(0));
+            }
+        }
+        LOG_DEBUG("allocate " << level_.size() * block_size_ << " entries of " << nparticle_ << " particles");
+    }
+    else if (data.size() != nparticle_) {
+        throw std::logic_error("multi-tau correlator requires a fixed number of particles");
+    }
+
+    scoped_timer_type timer(runtime_.tcf);
+    push_(0, &*data.begin());
+}
+
+template <typename tcf_type>
+void multi_tau<tcf_type>::push_(unsigned int l, data_type const* entry)
+{
+    level_type& level = level_[l];
+    unsigned int const head = level.nentry % block_size_;
+    data_type* first = &level.data[head * nparticle_];
+    std::copy(entry, entry + nparticle_, first);
+    ++level.nentry;
+
+    // correlate new entry with itself and all stored entries
+    unsigned int const nlag = std::min<step_type>(level.nentry, block_size_);
+    correlate_function_type correlate;
+    for (unsigned int lag = 0; lag < nlag; ++lag) {
+        unsigned int const origin = (head + block_size_ - lag) % block_size_;
+        data_type const* r1 = &level.data[origin * nparticle_];
+        accumulator<result_type> acc;
+        for (std::size_t i = 0; i < nparticle_; ++i) {
+            acc(correlate(r1[i], first[i]));
+        }
+        result_[l][lag](acc);
+    }
+
+    // pass entry on to the next level
+    if (l + 1 < level_.size()) {
+        if (average_) {
+            for (std::size_t i = 0; i < nparticle_; ++i) {
+                level.block_sum[i] += first[i];
+            }
+            if (level.nentry % block_size_ == 0) {
+                for (std::size_t i = 0; i < nparticle_; ++i) {
+                    level.block_sum[i] /= block_size_;
+                }
+                push_(l + 1, &level.block_sum[0]);
+                std::fill(level.block_sum.begin(), level.block_sum.end(), data_type(0));
+            }
+        }
+        else if ((level.nentry - 1) % block_size_ == 0) {
+            // entries at multiples of the interval of the next level
+            push_(l + 1, first);
+        }
+    }
+}
+
+/**
+ * Returns true for correlation functions supported by multi_tau.
+ *
+ * Bound as property "multi_tau" of the correlation function, which lets the
+ * Lua blocking scheme check for support before constructing the correlator.
+ */
+template <typename tcf_type>
+inline bool multi_tau_supported(tcf_type const&)
+{
+    return true;
+}
+
+template <typename tcf_type>
+std::function<typename multi_tau<tcf_type>::block_mean_type const& ()>
+multi_tau<tcf_type>::get_mean(std::shared_ptr<multi_tau> self)
+{
+    return [=]() -> block_mean_type const& {
+        auto in  = self->result_.origin();
+        auto out = self->mean_.origin();
+        for (unsigned int i = 0; i < self->mean_.num_elements(); ++i) {
+            *out++ = mean(*in++);
+        }
+        return self->mean_;
+    };
+}
+
+template <typename tcf_type>
+std::function<typename multi_tau<tcf_type>::block_mean_type const& ()>
+multi_tau<tcf_type>::get_error(std::shared_ptr<multi_tau> self)
+{
+    return [=]() -> block_mean_type const& {
+        auto in  = self->result_.origin();
+        auto out = self->error_.origin();
+        for (unsigned int i = 0; i < self->error_.num_elements(); ++i) {
+            *out++ = error_of_mean(*in++);
+        }
+        return self->error_;
+    };
+}
+
+template <typename tcf_type>
+std::function<typename multi_tau<tcf_type>::block_count_type const& ()>
+multi_tau<tcf_type>::get_count(std::shared_ptr<multi_tau> self)
+{
+    return [=]() -> block_count_type const& {
+        auto in  = self->result_.origin();
+        auto out = self->count_.origin();
+        for (unsigned int i = 0; i < self->count_.num_elements(); ++i) {
+            *out++ = numeric::detail::count(*in++);
+        }
+        return self->count_;
+    };
+}
+
+template <typename tcf_type>
+static std::function<void ()>
+wrap_sample(std::shared_ptr<multi_tau<tcf_type>> self)
+{
+    return [=]() {
+        self->sample();
+    };
+}
+
+template <typename tcf_type>
+static std::function<typename multi_tau<tcf_type>::block_time_type const& ()>
+wrap_time(std::shared_ptr<multi_tau<tcf_type>> self)
+{
+    typedef typename multi_tau<tcf_type>::block_time_type block_time_type;
+    return [=]() -> block_time_type const& {
+        return self->time();
+    };
+}
+
+template <typename tcf_type>
+void multi_tau<tcf_type>::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("observables")
+        [
+            namespace_("dynamics")
+            [
+                class_<multi_tau, std::shared_ptr<multi_tau>>()
+                    .property("sample", &wrap_sample<tcf_type>)
+                    .property("time", &wrap_time<tcf_type>)
+                    .property("mean", &multi_tau::get_mean)
+                    .property("error", &multi_tau::get_error)
+                    .property("count", &multi_tau::get_count)
+                    .property("block_size", &multi_tau::block_size)
+                    .scope
+                    [
+                        class_<runtime>("runtime")
+                            .def_readonly("tcf", &runtime::tcf)
+                    ]
+                    .def_readonly("runtime", &multi_tau::runtime_)
+
+              , def("multi_tau", &multi_tau::create)
+            ]
+        ]
+    ];
+}
+
+} // namespace dynamics
+} // namespace host
+} // namespace observables
+} // namespace halmd
+
+#endif /* ! HALMD_OBSERVABLES_HOST_DYNAMICS_MULTI_TAU_HPP */
@@ -21,6 +21,7 @@
 #include <halmd/io/logger.hpp>
 #include <halmd/observables/dynamics/correlation.hpp>
 #include <halmd/observables/host/dynamics/velocity_autocorrelation.hpp>
+#include <halmd/observables/host/dynamics/multi_tau.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
 namespace halmd {
@@ -69,6 +70,7 @@ void velocity_autocorrelation<dimension, float_type>::luaopen(lua_State* L)
             namespace_("dynamics")
             [
                 class_<velocity_autocorrelation>()
+                    .property("multi_tau", &multi_tau_supported<velocity_autocorrelation>)
 
               , def("velocity_autocorrelation", &select_tcf_by_acquire<velocity_autocorrelation>)
             ]
@@ -86,6 +88,10 @@ HALMD_LUA_API int luaopen_libhalmd_observables_host_dynamics_velocity_autocorrel
     observables::dynamics::correlation<velocity_autocorrelation<2, double> >::luaopen(L);
     observables::dynamics::correlation<velocity_autocorrelation<3, float> >::luaopen(L);
     observables::dynamics::correlation<velocity_autocorrelation<2, float> >::luaopen(L);
+    multi_tau<velocity_autocorrelation<3, double> >::luaopen(L);
+    multi_tau<velocity_autocorrelation<2, double> >::luaopen(L);
+    multi_tau<velocity_autocorrelation<3, float> >::luaopen(L);
+    multi_tau<velocity_autocorrelation<2, float> >::luaopen(L);
     return 0;
 }
 
@@ -94,6 +100,13 @@ template class velocity_autocorrelation<3, double>;
 template class velocity_autocorrelation<2, double>;
 template class velocity_autocorrelation<3, float>;
 template class velocity_autocorrelation<2, float>;
+#ifndef USE_HOST_SINGLE_PRECISION
+template class multi_tau<velocity_autocorrelation<3, double> >;
+template class multi_tau<velocity_autocorrelation<2, double> >;
+#else
+template class multi_tau<velocity_autocorrelation<3, float> >;
+template class multi_tau<velocity_autocorrelation<2, float> >;
+#endif
 
 } // namespace dynamics
 } // namespace host
@@ -42,13 +42,11 @@ public:
     typedef host::samples::sample<dimension, float_type> sample_type;
     typedef typename sample_type::data_type vector_type;
     typedef double result_type;
+    typedef observables::dynamics::velocity_autocorrelation<dimension, float_type> correlate_function_type;
 
     static void luaopen(lua_State* L);
 
     void operator() (sample_type const& first, sample_type const& second, accumulator<result_type>& result);
-
-private:
-    typedef observables::dynamics::velocity_autocorrelation<dimension, float_type> correlate_function_type;
 };
 
 } // namespace dynamics
@@ -40,14 +40,17 @@ namespace host {
  *
  * copies the data to a host sample and provides the actual implementation
  * for the sample related interface of phase_space
+ *
+ * The element type of the particle array may differ from the data type of the
+ * sample, e.g., for padded vectors, if the former converts to the latter.
  */
-template<int dimension, typename scalar_type>
+template<int dimension, typename scalar_type, typename array_value_type = typename samples::sample<dimension, scalar_type>::data_type>
 class phase_space_sampler_typed : public phase_space_sampler
 {
 public:
     typedef samples::sample<dimension, scalar_type> sample_type;
     typedef mdsim::host::particle_group particle_group_type;
-    typedef mdsim::host::particle_array_typed<typename sample_type::data_type> particle_array_type;
+    typedef mdsim::host::particle_array_typed<array_value_type> particle_array_type;
 
     /**
      * Construct a phase space sampler for a given particle group and array.
@@ -59,7 +62,7 @@ public:
         std::shared_ptr<particle_group_type> group
       , std::shared_ptr<mdsim::host::particle_array> array
     )
-      : particle_group_(group), array_(mdsim::host::particle_array::cast<typename sample_type::data_type>(array))
+      : particle_group_(group), array_(mdsim::host::particle_array::cast<array_value_type>(array))
     {}
 
     /**
@@ -195,18 +198,25 @@ phase_space_sampler_typed_create_map = {
   , { typeid(fixed_vector<unsigned int, 2>), phase_space_sampler_typed<2, unsigned int>::create }
   , { typeid(fixed_vector<unsigned int, 3>), phase_space_sampler_typed<3, unsigned int>::create }
   , { typeid(fixed_vector<unsigned int, 4>), phase_space_sampler_typed<4, unsigned int>::create }
+
+#ifdef USE_HOST_PADDED_VECTOR
+  , { typeid(padded_vector<float, 2>), phase_space_sampler_typed<2, float, padded_vector<float, 2>>::create }
+  , { typeid(padded_vector<float, 3>), phase_space_sampler_typed<3, float, padded_vector<float, 3>>::create }
+  , { typeid(padded_vector<double, 2>), phase_space_sampler_typed<2, double, padded_vector<double, 2>>::create }
+  , { typeid(padded_vector<double, 3>), phase_space_sampler_typed<3, double, padded_vector<double, 3>>::create }
+#endif
 };
 
 
-template<int dimension, typename scalar_type>
+template<int dimension, typename scalar_type, typename array_value_type>
 class phase_space_sampler_position
-  : public phase_space_sampler_typed<dimension, scalar_type>
+  : public phase_space_sampler_typed<dimension, scalar_type, array_value_type>
 {
 public:
     typedef samples::sample<dimension, scalar_type> sample_type;
     typedef mdsim::host::particle_group particle_group_type;
     typedef mdsim::box<dimension> box_type;
-    typedef mdsim::host::particle_array_typed<typename sample_type::data_type> particle_array_type;
+    typedef mdsim::host::particle_array_typed<array_value_type> particle_array_type;
 
     static std::shared_ptr<phase_space_sampler_position> create(
         std::shared_ptr<particle_group_type> group
@@ -224,9 +234,9 @@ public:
       , std::shared_ptr<mdsim::host::particle_array> position_array
       , std::shared_ptr<mdsim::host::particle_array> image_array
     )
-      : phase_space_sampler_typed<dimension, scalar_type>(group, position_array)
+      : phase_space_sampler_typed<dimension, scalar_type, array_value_type>(group, position_array)
       , box_(box)
-      , image_array_(mdsim::host::particle_array::cast<typename sample_type::data_type>(image_array))
+      , image_array_(mdsim::host::particle_array::cast<array_value_type>(image_array))
     {}
 
     virtual std::shared_ptr<sample_base> acquire()
@@ -250,7 +260,7 @@ public:
             for (std::size_t i : group) {
                 auto& r = sample_position[id++];
                 r = particle_position[i];
-                box_->extend_periodic(r, particle_image[i]);
+                box_->extend_periodic(r, typename sample_type::data_type(particle_image[i]));
             }
 
             this->array_observer_ = this->array_->cache_observer();
@@ -328,7 +338,9 @@ phase_space<dimension, float_type>::get_sampler(std::string const& name)
         auto array = particle_->get_array(name);
         if(!name.compare("position")) {
             auto image = particle_->get_array("image");
-            auto sampler = phase_space_sampler_position<dimension, float_type>::create(particle_group_, box_, array, image);
+            auto sampler = phase_space_sampler_position<
+                dimension, float_type, typename particle_type::position_array_type::value_type
+            >::create(particle_group_, box_, array, image);
             return (samplers_[name] = sampler);
         } else {
             auto it = phase_space_sampler_typed_create_map.find(array->type());
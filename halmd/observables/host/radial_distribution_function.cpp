@@ -0,0 +1,455 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/observables/host/radial_distribution_function.hpp>
+#include <halmd/utility/lua/lua.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace halmd {
+namespace observables {
+namespace host {
+
+template <int dimension, typename float_type>
+radial_distribution_function<dimension, float_type>::radial_distribution_function(
+    shared_ptr<particle_type const> particle
+  , shared_ptr<box_type const> box
+  , double r_max
+  , unsigned int nbin
+  , shared_ptr<neighbour_type> neighbour
+  , shared_ptr<binning_type> binning
+  , shared_ptr<thread_pool_type> thread_pool
+  , shared_ptr<logger> logger
+)
+    // dependency injection
+  : particle_(particle)
+  , box_(box)
+  , neighbour_(neighbour)
+  , binning_(binning)
+  , thread_pool_(thread_pool)
+  , logger_(logger)
+  // initialise parameters
+  , nbin_(nbin)
+  , nspecies_(particle->nspecies())
+  , npair_(nspecies_ * (nspecies_ + 1) / 2)
+  , rr_max_(r_max * r_max)
+  , bin_scale_(nbin / r_max)
+  , count_(0)
+{
+    if (nbin == 0) {
+        throw invalid_argument("number of bins must be positive");
+    }
+    if (!(r_max > 0)) {
+        throw invalid_argument("maximum distance must be positive");
+    }
+    // the minimum image convention holds up to half the shortest edge length
+    double L_min = *min_element(box_->length().begin(), box_->length().end());
+    if (r_max > L_min / 2) {
+        throw invalid_argument("maximum distance exceeds half the edge length of the simulation box");
+    }
+
+    if (neighbour_) {
+        binning_ = nullptr;
+        LOG("enumerate particle pairs from neighbour lists");
+    }
+    else {
+        if (binning_) {
+            vector_type const& cell_length = binning_->cell_length();
+            if (*min_element(cell_length.begin(), cell_length.end()) < r_max) {
+                LOG("cells of binning module are smaller than maximum distance");
+                binning_ = nullptr;
+            }
+        }
+        if (!binning_) {
+            typename binning_type::matrix_type r_cut(1, 1);
+            r_cut(0, 0) = r_max;
+            binning_ = make_shared<binning_type>(particle_, box_, r_cut, 0, thread_pool_, logger_);
+        }
+        LOG("enumerate particle pairs from cell lists");
+
+        // offsets of the 3^d neighbouring cells, modulo the number of cells,
+        // omitting duplicates if there are less than 3 cells along an axis
+        cell_size_type ncell = binning_->ncell();
+        cell_offset_.assign(1, cell_size_type(0));
+        for (int j = 0; j < dimension; ++j) {
+            vector<size_t> shift = {0};
+            if (ncell[j] > 1) {
+                shift.push_back(1);
+            }
+            if (ncell[j] > 2) {
+                shift.push_back(ncell[j] - 1);
+            }
+            vector<cell_size_type> offset;
+            for (cell_size_type const& k : cell_offset_) {
+                for (size_t s : shift) {
+                    offset.push_back(k);
+                    offset.back()[j] = s;
+                }
+            }
+            cell_offset_.swap(offset);
+        }
+    }
+
+    // bin centres and volumes of the spherical shells
+    double dr = r_max / nbin;
+    double unit_volume = (dimension == 3) ? 4 * M_PI / 3 : M_PI;
+    position_.resize(nbin);
+    shell_volume_.resize(nbin);
+    for (unsigned int k = 0; k < nbin; ++k) {
+        position_[k] = (k + 0.5) * dr;
+        shell_volume_[k] = unit_volume * (pow((k + 1) * dr, dimension) - pow(k * dr, dimension));
+    }
+
+    acc_.resize(boost::extents[npair_][nbin_]);
+    value_.resize(boost::extents[npair_][nbin_]);
+    error_.resize(boost::extents[npair_][nbin_]);
+
+    LOG("maximum distance: " << r_max);
+    LOG("number of bins: " << nbin_);
+    LOG("number of species pairs: " << npair_);
+}
+
+template <int dimension, typename float_type>
+void radial_distribution_function<dimension, float_type>::sample()
+{
+    LOG_DEBUG("acquire sample");
+
+    scoped_timer_type timer(runtime_.sample);
+
+    unsigned int const nthread = thread_pool_->size();
+    size_t const size = npair_ * nbin_;
+    histogram_.assign(nthread * size, 0);
+
+    if (neighbour_) {
+        histogram_neighbour_();
+    }
+    else {
+        histogram_binning_();
+    }
+
+    // reduce histograms in thread order
+    for (unsigned int thread = 1; thread < nthread; ++thread) {
+        histogram_value_type const* histogram = histogram_.data() + thread * size;
+        for (size_t k = 0; k < size; ++k) {
+            histogram_[k] += histogram[k];
+        }
+    }
+
+    // count particles per species
+    auto const& species = read_cache(particle_->species());
+    vector<double> nparticle(nspecies_, 0);
+    for (size_t i = 0; i < particle_->nparticle(); ++i) {
+        ++nparticle[species[i]];
+    }
+
+    // normalise histograms by the number of pairs per volume and accumulate
+    double const volume = box_->volume();
+    for (unsigned int a = 0; a < nspecies_; ++a) {
+        for (unsigned int b = a; b < nspecies_; ++b) {
+            unsigned int const pair = pair_index_(a, b);
+            // each unordered pair of like species contributes twice to the ordered sum
+            double npair = (a == b) ? nparticle[a] * (nparticle[a] - 1) / 2 : nparticle[a] * nparticle[b];
+            double norm = (npair > 0) ? volume / npair : 0;
+            for (unsigned int k = 0; k < nbin_; ++k) {
+                acc_[pair][k](norm * histogram_[pair * nbin_ + k] / shell_volume_[k]);
+            }
+        }
+    }
+    ++count_;
+}
+
+template <int dimension, typename float_type>
+void radial_distribution_function<dimension, float_type>::histogram_neighbour_()
+{
+    // update neighbour lists first, which may reorder the particles
+    auto const& lists = read_cache(neighbour_->lists());
+    auto const& position = read_cache(particle_->position());
+    auto const& species = read_cache(particle_->species());
+
+    // the neighbour lists of the particle instance with itself contain each pair once
+    thread_pool_->parallel_for(0, particle_->nparticle(), [&](unsigned int thread, size_t first, size_t last) {
+        histogram_value_type* histogram = histogram_.data() + thread * npair_ * nbin_;
+        for (size_t i = first; i < last; ++i) {
+            for (unsigned int j : lists[i]) {
+                add_(histogram, position[i] - position[j], species[i], species[j]);
+            }
+        }
+    });
+}
+
+template <int dimension, typename float_type>
+void radial_distribution_function<dimension, float_type>::histogram_binning_()
+{
+    auto const& cell = read_cache(binning_->cell());
+    auto const& position = read_cache(particle_->position());
+    auto const& species = read_cache(particle_->species());
+
+    cell_size_type const& ncell = binning_->ncell();
+    thread_pool_->parallel_for(0, cell.num_elements(), [&](unsigned int thread, size_t first, size_t last) {
+        histogram_value_type* histogram = histogram_.data() + thread * npair_ * nbin_;
+        for (size_t c = first; c < last; ++c) {
+            // convert linear index in row-major storage order to cell index
+            cell_size_type i;
+            size_t k = c;
+            for (int j = dimension - 1; j >= 0; --j) {
+                i[j] = k % ncell[j];
+                k /= ncell[j];
+            }
+            // visit all neighbouring cells, and count each pair once
+            for (cell_size_type const& offset : cell_offset_) {
+                auto const& neighbour_cell = cell(element_mod(i + offset, ncell));
+                for (unsigned int p : cell(i)) {
+                    for (unsigned int q : neighbour_cell) {
+                        if (q > p) {
+                            add_(histogram, position[p] - position[q], species[p], species[q]);
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+template <int dimension, typename float_type>
+typename radial_distribution_function<dimension, float_type>::result_type const&
+radial_distribution_function<dimension, float_type>::value()
+{
+    for (unsigned int pair = 0; pair < npair_; ++pair) {
+        for (unsigned int k = 0; k < nbin_; ++k) {
+            value_[pair][k] = mean(acc_[pair][k]);
+        }
+    }
+    return value_;
+}
+
+template <int dimension, typename float_type>
+typename radial_distribution_function<dimension, float_type>::result_type const&
+radial_distribution_function<dimension, float_type>::error()
+{
+    for (unsigned int pair = 0; pair < npair_; ++pair) {
+        for (unsigned int k = 0; k < nbin_; ++k) {
+            error_[pair][k] = count_ > 1 ? error_of_mean(acc_[pair][k]) : 0;
+        }
+    }
+    return error_;
+}
+
+template <int dimension, typename float_type>
+void radial_distribution_function<dimension, float_type>::reset()
+{
+    LOG_DEBUG("reset accumulated samples");
+    for (unsigned int pair = 0; pair < npair_; ++pair) {
+        for (unsigned int k = 0; k < nbin_; ++k) {
+            acc_[pair][k].reset();
+        }
+    }
+    count_ = 0;
+}
+
+template <typename rdf_type>
+static function<void ()>
+wrap_sample(shared_ptr<rdf_type> self)
+{
+    return [=]() {
+        self->sample();
+    };
+}
+
+template <typename rdf_type>
+static function<void ()>
+wrap_reset(shared_ptr<rdf_type> self)
+{
+    return [=]() {
+        self->reset();
+    };
+}
+
+template <typename rdf_type>
+static function<typename rdf_type::result_type const& ()>
+wrap_value(shared_ptr<rdf_type> self)
+{
+    return [=]() -> typename rdf_type::result_type const& {
+        return self->value();
+    };
+}
+
+template <typename rdf_type>
+static function<typename rdf_type::result_type const& ()>
+wrap_error(shared_ptr<rdf_type> self)
+{
+    return [=]() -> typename rdf_type::result_type const& {
+        return self->error();
+    };
+}
+
+template <typename rdf_type>
+static function<typename rdf_type::size_type ()>
+wrap_count(shared_ptr<rdf_type> self)
+{
+    return [=]() {
+        return self->count();
+    };
+}
+
+template <typename rdf_type>
+static function<vector<double> const& ()>
+wrap_position(shared_ptr<rdf_type> self)
+{
+    return [=]() -> vector<double> const& {
+        return self->position();
+    };
+}
+
+/**
+ * Construct radial distribution function with pairs from neighbour lists
+ */
+template <typename rdf_type>
+static shared_ptr<rdf_type>
+wrap_radial_distribution_function(
+    shared_ptr<typename rdf_type::particle_type const> particle
+  , shared_ptr<typename rdf_type::box_type const> box
+  , double r_max
+  , unsigned int nbin
+  , shared_ptr<typename rdf_type::neighbour_type> neighbour
+  , shared_ptr<typename rdf_type::thread_pool_type> thread_pool
+  , shared_ptr<logger> logger
+)
+{
+    return make_shared<rdf_type>(particle, box, r_max, nbin, neighbour, nullptr, thread_pool, logger);
+}
+
+/**
+ * Construct radial distribution function with pairs from cell lists
+ */
+template <typename rdf_type>
+static shared_ptr<rdf_type>
+wrap_radial_distribution_function(
+    shared_ptr<typename rdf_type::particle_type const> particle
+  , shared_ptr<typename rdf_type::box_type const> box
+  , double r_max
+  , unsigned int nbin
+  , shared_ptr<typename rdf_type::binning_type> binning
+  , shared_ptr<typename rdf_type::thread_pool_type> thread_pool
+  , shared_ptr<logger> logger
+)
+{
+    return make_shared<rdf_type>(particle, box, r_max, nbin, nullptr, binning, thread_pool, logger);
+}
+
+/**
+ * Construct radial distribution function with private cell lists
+ */
+template <typename rdf_type>
+static shared_ptr<rdf_type>
+wrap_radial_distribution_function(
+    shared_ptr<typename rdf_type::particle_type const> particle
+  , shared_ptr<typename rdf_type::box_type const> box
+  , double r_max
+  , unsigned int nbin
+  , shared_ptr<typename rdf_type::thread_pool_type> thread_pool
+  , shared_ptr<logger> logger
+)
+{
+    return make_shared<rdf_type>(particle, box, r_max, nbin, nullptr, nullptr, thread_pool, logger);
+}
+
+template <int dimension, typename float_type>
+void radial_distribution_function<dimension, float_type>::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("observables")
+        [
+            namespace_("host")
+            [
+                class_<radial_distribution_function>()
+                    .property("sample", &wrap_sample<radial_distribution_function>)
+                    .property("reset", &wrap_reset<radial_distribution_function>)
+                    .property("value", &wrap_value<radial_distribution_function>)
+                    .property("error", &wrap_error<radial_distribution_function>)
+                    .property("count", &wrap_count<radial_distribution_function>)
+                    .property("position", &wrap_position<radial_distribution_function>)
+                    .property("npair", &radial_distribution_function::npair)
+                    .scope
+                    [
+                        class_<runtime>("runtime")
+                            .def_readonly("sample", &runtime::sample)
+                    ]
+                    .def_readonly("runtime", &radial_distribution_function::runtime_)
+            ]
+          , def("radial_distribution_function", static_cast<shared_ptr<radial_distribution_function> (*)(
+                shared_ptr<particle_type const>
+              , shared_ptr<box_type const>
+              , double
+              , unsigned int
+              , shared_ptr<neighbour_type>
+              , shared_ptr<thread_pool_type>
+              , shared_ptr<logger>
+            )>(&wrap_radial_distribution_function<radial_distribution_function>))
+          , def("radial_distribution_function", static_cast<shared_ptr<radial_distribution_function> (*)(
+                shared_ptr<particle_type const>
+              , shared_ptr<box_type const>
+              , double
+              , unsigned int
+              , shared_ptr<binning_type>
+              , shared_ptr<thread_pool_type>
+              , shared_ptr<logger>
+            )>(&wrap_radial_distribution_function<radial_distribution_function>))
+          , def("radial_distribution_function", static_cast<shared_ptr<radial_distribution_function> (*)(
+                shared_ptr<particle_type const>
+              , shared_ptr<box_type const>
+              , double
+              , unsigned int
+              , shared_ptr<thread_pool_type>
+              , shared_ptr<logger>
+            )>(&wrap_radial_distribution_function<radial_distribution_function>))
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_observables_host_radial_distribution_function(lua_State* L)
+{
+#ifndef USE_HOST_SINGLE_PRECISION
+    radial_distribution_function<3, double>::luaopen(L);
+    radial_distribution_function<2, double>::luaopen(L);
+#else
+    radial_distribution_function<3, float>::luaopen(L);
+    radial_distribution_function<2, float>::luaopen(L);
+#endif
+    return 0;
+}
+
+// explicit instantiation
+#ifndef USE_HOST_SINGLE_PRECISION
+template class radial_distribution_function<3, double>;
+template class radial_distribution_function<2, double>;
+#else
+template class radial_distribution_function<3, float>;
+template class radial_distribution_function<2, float>;
+#endif
+
+}  // namespace host
+}  // namespace observables
+}  // namespace halmd
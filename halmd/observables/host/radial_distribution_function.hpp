@@ -0,0 +1,228 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_OBSERVABLES_HOST_RADIAL_DISTRIBUTION_FUNCTION_HPP
+#define HALMD_OBSERVABLES_HOST_RADIAL_DISTRIBUTION_FUNCTION_HPP
+
+#include <boost/multi_array.hpp>
+#include <lua.hpp>
+#include <memory>
+#include <vector>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/host/binning.hpp>
+#include <halmd/mdsim/host/neighbour.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/utility/profiler.hpp>
+#include <halmd/utility/thread_pool.hpp>
+
+namespace halmd {
+namespace observables {
+namespace host {
+
+/**
+ * Compute partial radial distribution functions.
+ *
+ * @f$ g_{\alpha\beta}(r) = \frac{V}{N_\alpha N_\beta \, s_d r^{d-1}}
+ * \bigl\langle \sum_{i \in \alpha} \sum_{j \in \beta, j \neq i} \delta(r - r_{ij})
+ * \bigr\rangle @f$
+ *
+ * for all pairs of species @f$ \alpha \leq \beta @f$, with the surface
+ * area @f$ s_d @f$ of the d-dimensional unit sphere. For @f$ \alpha = \beta
+ * @f$, the normalisation @f$ N_\alpha^2 @f$ is replaced by @f$ N_\alpha
+ * (N_\alpha - 1) @f$. The pair distances are histogrammed in bins of equal width up to
+ * @f$ r_\text{max} @f$, and the histogram of each sample is accumulated in
+ * place, which yields the mean and its standard error for each bin.
+ *
+ * The pairs are enumerated from the host neighbour lists of the particle
+ * instance with itself, which must contain all pairs within @f$
+ * r_\text{max} @f$. Otherwise, the pairs are found by traversing the cell
+ * lists of a binning module, which is either passed in, e.g., shared with
+ * the neighbour lists, or constructed for cells with an edge length of at
+ * least @f$ r_\text{max} @f$. The particles are distributed over the threads
+ * of the thread pool, and the per-thread histograms are reduced in a fixed
+ * order.
+ */
+template <int dimension, typename float_type>
+class radial_distribution_function
+{
+public:
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::neighbour neighbour_type;
+    typedef mdsim::host::binning<dimension, float_type> binning_type;
+    typedef halmd::utility::thread_pool thread_pool_type;
+    /** histograms of shape (species pairs, bins) */
+    typedef boost::multi_array<double, 2> result_type;
+    typedef halmd::accumulator<double>::size_type size_type;
+
+    /**
+     * Construct radial distribution function for the given number of bins
+     * in the interval [0, r_max).
+     *
+     * The neighbour lists, if given, must be those of the particle instance
+     * with itself and must contain all pairs with a distance below r_max.
+     * The binning module is used only if neighbour is a null pointer, and if
+     * its cells are large enough; otherwise a private binning module is
+     * constructed.
+     */
+    radial_distribution_function(
+        std::shared_ptr<particle_type const> particle
+      , std::shared_ptr<box_type const> box
+      , double r_max
+      , unsigned int nbin
+      , std::shared_ptr<neighbour_type> neighbour = nullptr
+      , std::shared_ptr<binning_type> binning = nullptr
+      , std::shared_ptr<thread_pool_type> thread_pool = std::make_shared<thread_pool_type>()
+      , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>("radial_distribution_function")
+    );
+
+    /**
+     * Histogram pair distances of the current particle positions and add
+     * the result to the accumulated histograms.
+     */
+    void sample();
+
+    /** returns mean of accumulated radial distribution functions */
+    result_type const& value();
+
+    /** returns standard error of mean of accumulated radial distribution functions */
+    result_type const& error();
+
+    /** returns number of accumulated samples */
+    size_type count() const
+    {
+        return count_;
+    }
+
+    /** discard accumulated samples */
+    void reset();
+
+    /** returns centres of the histogram bins */
+    std::vector<double> const& position() const
+    {
+        return position_;
+    }
+
+    /** returns number of species pairs, @f$ n (n + 1) / 2 @f$ for n species */
+    unsigned int npair() const
+    {
+        return npair_;
+    }
+
+    /**
+     * Bind class to Lua.
+     */
+    static void luaopen(lua_State* L);
+
+private:
+    typedef typename particle_type::vector_type vector_type;
+    typedef typename particle_type::position_array_type position_array_type;
+    typedef typename particle_type::species_array_type species_array_type;
+    typedef typename binning_type::cell_size_type cell_size_type;
+    typedef unsigned long histogram_value_type;
+
+    /** histogram pair distances from neighbour lists */
+    void histogram_neighbour_();
+    /** histogram pair distances from cell lists */
+    void histogram_binning_();
+
+    /** returns index of the unordered species pair (a, b) */
+    unsigned int pair_index_(unsigned int a, unsigned int b) const
+    {
+        if (a > b) {
+            std::swap(a, b);
+        }
+        return a * nspecies_ - a * (a + 1) / 2 + b;
+    }
+
+    /** add pair distance to histogram of thread */
+    void add_(histogram_value_type* histogram, vector_type r, unsigned int a, unsigned int b) const
+    {
+        box_->reduce_periodic(r);
+        float_type rr = inner_prod(r, r);
+        if (rr < rr_max_) {
+            unsigned int bin = static_cast<unsigned int>(std::sqrt(rr) * bin_scale_);
+            if (bin < nbin_) {
+                ++histogram[pair_index_(a, b) * nbin_ + bin];
+            }
+        }
+    }
+
+    /** system state */
+    std::shared_ptr<particle_type const> particle_;
+    /** simulation domain */
+    std::shared_ptr<box_type const> box_;
+    /** neighbour lists, or nullptr */
+    std::shared_ptr<neighbour_type> neighbour_;
+    /** cell lists, used if neighbour lists are unavailable */
+    std::shared_ptr<binning_type> binning_;
+    /** thread pool */
+    std::shared_ptr<thread_pool_type> thread_pool_;
+    /** logger instance */
+    std::shared_ptr<logger> logger_;
+
+    /** number of bins */
+    unsigned int nbin_;
+    /** number of species */
+    unsigned int nspecies_;
+    /** number of species pairs */
+    unsigned int npair_;
+    /** squared maximum distance */
+    float_type rr_max_;
+    /** inverse bin width */
+    float_type bin_scale_;
+    /** centres of histogram bins */
+    std::vector<double> position_;
+    /** volumes of the spherical shells of the histogram bins */
+    std::vector<double> shell_volume_;
+    /** relative offsets of the neighbouring cells, including the cell itself */
+    std::vector<cell_size_type> cell_offset_;
+
+    /** histograms of each thread */
+    std::vector<histogram_value_type> histogram_;
+    /** accumulated radial distribution functions */
+    boost::multi_array<halmd::accumulator<double>, 2> acc_;
+    /** number of accumulated samples */
+    size_type count_;
+    /** mean of accumulated samples */
+    result_type value_;
+    /** standard error of mean of accumulated samples */
+    result_type error_;
+
+    typedef halmd::utility::profiler::accumulator_type accumulator_type;
+    typedef halmd::utility::profiler::scoped_timer_type scoped_timer_type;
+
+    struct runtime
+    {
+        accumulator_type sample;
+    };
+
+    /** profiling runtime accumulators */
+    runtime runtime_;
+};
+
+} // namespace host
+} // namespace observables
+} // namespace halmd
+
+#endif /* ! HALMD_OBSERVABLES_HOST_RADIAL_DISTRIBUTION_FUNCTION_HPP */
@@ -20,9 +20,12 @@
  * <http://www.gnu.org/licenses/>.
  */
 
+#include <halmd/numeric/kahan_sum.hpp>
 #include <halmd/observables/host/thermodynamics.hpp>
 #include <halmd/utility/lua/lua.hpp>
 
+#include <vector>
+
 namespace halmd {
 namespace observables {
 namespace host {
@@ -33,6 +36,7 @@ thermodynamics<dimension, float_type>::thermodynamics(
   , std::shared_ptr<particle_group_type> group
   , std::shared_ptr<box_type const> box
   , volume_type volume
+  , std::shared_ptr<thread_pool_type> thread_pool
   , std::shared_ptr<logger> logger
 )
   : particle_(particle)
@@ -40,6 +44,9 @@ thermodynamics<dimension, float_type>::thermodynamics(
   , box_(box)
     // use box volume by default
   , volume_(volume ? volume : [=](){ return box->volume(); })
+  , thread_pool_(thread_pool)
+  , requested_(0)
+  , requested_before_(0)
   , logger_(logger)
 {
     LOG_INFO("current reference volume: " << volume_());
@@ -60,15 +67,10 @@ double thermodynamics<dimension, float_type>::volume() const
 template <int dimension, typename float_type>
 double thermodynamics<dimension, float_type>::en_kin()
 {
-    cache<velocity_array_type> const& velocity_cache = particle_->velocity();
-    cache<mass_array_type> const& mass_cache = particle_->mass();
-    cache<size_type> const& group_cache = group_->size();
-
-    if (en_kin_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
+    if (outdated_(EN_KIN)) {
         LOG_DEBUG("acquire kinetic energy");
         scoped_timer_type timer(runtime_.en_kin);
-        en_kin_ = get_mean_en_kin(*particle_, *group_);
-        en_kin_cache_ = std::tie(velocity_cache, mass_cache, group_cache);
+        reduce_(EN_KIN);
     }
     return en_kin_;
 }
@@ -77,14 +79,10 @@ template <int dimension, typename float_type>
 typename thermodynamics<dimension, float_type>::vector_type const&
 thermodynamics<dimension, float_type>::total_force()
 {
-    cache<velocity_array_type> const& force_cache = particle_->force();
-    cache<size_type> const& group_cache = group_->size();
-
-    if (force_cache_ != std::tie(force_cache, group_cache)) {
+    if (outdated_(FORCE)) {
         LOG_DEBUG("acquire total force");
         scoped_timer_type timer(runtime_.force);
-        force_ = get_total_force(*particle_, *group_);
-        force_cache_ = std::tie(force_cache, group_cache);
+        reduce_(FORCE);
     }
     return force_;
 }
@@ -93,15 +91,10 @@ template <int dimension, typename float_type>
 typename thermodynamics<dimension, float_type>::vector_type const&
 thermodynamics<dimension, float_type>::v_cm()
 {
-    cache<velocity_array_type> const& velocity_cache = particle_->velocity();
-    cache<mass_array_type> const& mass_cache = particle_->mass();
-    cache<size_type> const& group_cache = group_->size();
-
-    if (v_cm_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
+    if (outdated_(V_CM)) {
         LOG_DEBUG("acquire centre-of-mass velocity");
         scoped_timer_type timer(runtime_.v_cm);
-        std::tie(v_cm_, mean_mass_) = get_v_cm_and_mean_mass(*particle_, *group_);
-        v_cm_cache_ = std::tie(velocity_cache, mass_cache, group_cache);
+        reduce_(V_CM);
     }
     return v_cm_;
 }
@@ -110,15 +103,10 @@ template <int dimension, typename float_type>
 typename thermodynamics<dimension, float_type>::vector_type const&
 thermodynamics<dimension, float_type>::r_cm()
 {
-    cache<velocity_array_type> const& position_cache = particle_->position();
-    cache<mass_array_type> const& mass_cache = particle_->mass();
-    cache<size_type> const& group_cache = group_->size();
-
-    if (r_cm_cache_ != std::tie(position_cache, mass_cache, group_cache)) {
+    if (outdated_(R_CM)) {
         LOG_DEBUG("acquire centre of mass");
         scoped_timer_type timer(runtime_.r_cm);
-        r_cm_ = get_r_cm(*particle_, *group_, *box_);
-        r_cm_cache_ = std::tie(position_cache, mass_cache, group_cache);
+        reduce_(R_CM);
     }
     return r_cm_;
 }
@@ -126,15 +114,10 @@ thermodynamics<dimension, float_type>::r_cm()
 template <int dimension, typename float_type>
 double thermodynamics<dimension, float_type>::mean_mass()
 {
-    cache<velocity_array_type> const& velocity_cache = particle_->velocity();
-    cache<mass_array_type> const& mass_cache = particle_->mass();
-    cache<size_type> const& group_cache = group_->size();
-
-    if (v_cm_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
+    if (outdated_(V_CM)) {
         LOG_DEBUG("acquire mean particle mass");
         scoped_timer_type timer(runtime_.v_cm);
-        std::tie(v_cm_, mean_mass_) = get_v_cm_and_mean_mass(*particle_, *group_);
-        v_cm_cache_ = std::tie(velocity_cache, mass_cache, group_cache);
+        reduce_(V_CM);
     }
     return mean_mass_;
 }
@@ -142,14 +125,10 @@ double thermodynamics<dimension, float_type>::mean_mass()
 template <int dimension, typename float_type>
 double thermodynamics<dimension, float_type>::en_pot()
 {
-    cache<en_pot_array_type> const& en_pot_cache = particle_->potential_energy();
-    cache<size_type> const& group_cache = group_->size();
-
-    if (en_pot_cache_ != std::tie(en_pot_cache, group_cache)) {
+    if (outdated_(EN_POT)) {
         LOG_DEBUG("acquire potential energy");
         scoped_timer_type timer(runtime_.en_pot);
-        en_pot_ = get_mean_en_pot(*particle_, *group_);
-        en_pot_cache_ = std::tie(en_pot_cache, group_cache);
+        reduce_(EN_POT);
     }
     return en_pot_;
 }
@@ -157,14 +136,10 @@ double thermodynamics<dimension, float_type>::en_pot()
 template <int dimension, typename float_type>
 double thermodynamics<dimension, float_type>::virial()
 {
-    cache<stress_pot_array_type> const& stress_pot_cache = particle_->stress_pot();
-    cache<size_type> const& group_cache = group_->size();
-
-    if (virial_cache_ != std::tie(stress_pot_cache, group_cache)) {
+    if (outdated_(VIRIAL)) {
         LOG_DEBUG("acquire virial");
         scoped_timer_type timer(runtime_.virial);
-        virial_ = get_mean_virial(*particle_, *group_);
-        virial_cache_ = std::tie(stress_pot_cache, group_cache);
+        reduce_(VIRIAL);
     }
     return virial_;
 }
@@ -173,19 +148,215 @@ template <int dimension, typename float_type>
 typename thermodynamics<dimension, float_type>::stress_tensor_type const&
 thermodynamics<dimension, float_type>::stress_tensor()
 {
-    cache<stress_pot_array_type> const& stress_pot_cache = particle_->stress_pot();
-    cache<velocity_array_type> const& velocity_cache = particle_->velocity();
-    cache<size_type> const& group_cache = group_->size();
-
-    if (stress_tensor_cache_ != std::tie(stress_pot_cache, velocity_cache, group_cache)) {
+    if (outdated_(STRESS_TENSOR)) {
         LOG_DEBUG("acquire stress tensor");
         scoped_timer_type timer(runtime_.stress_tensor);
-        stress_tensor_ = get_stress_tensor(*particle_, *group_);
-        stress_tensor_cache_ = std::tie(stress_pot_cache, velocity_cache, group_cache);
+        reduce_(STRESS_TENSOR);
     }
     return stress_tensor_;
 }
 
+/**
+ * The particle arrays are accessed only for the given quantities, since
+ * accessing the force or the auxiliary variables may trigger their
+ * computation.
+ */
+template <int dimension, typename float_type>
+unsigned int thermodynamics<dimension, float_type>::outdated_(unsigned int mask)
+{
+    cache<size_type> const& group_cache = group_->size();
+    unsigned int outdated = 0;
+
+    if (mask & (EN_KIN | V_CM)) {
+        cache<velocity_array_type> const& velocity_cache = particle_->velocity();
+        cache<mass_array_type> const& mass_cache = particle_->mass();
+        if ((mask & EN_KIN) && en_kin_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
+            outdated |= EN_KIN;
+        }
+        if ((mask & V_CM) && v_cm_cache_ != std::tie(velocity_cache, mass_cache, group_cache)) {
+            outdated |= V_CM;
+        }
+    }
+    if (mask & R_CM) {
+        if (r_cm_cache_ != std::tie(particle_->position(), particle_->mass(), group_cache)) {
+            outdated |= R_CM;
+        }
+    }
+    if (mask & FORCE) {
+        if (force_cache_ != std::tie(particle_->force(), group_cache)) {
+            outdated |= FORCE;
+        }
+    }
+    if (mask & EN_POT) {
+        if (en_pot_cache_ != std::tie(particle_->potential_energy(), group_cache)) {
+            outdated |= EN_POT;
+        }
+    }
+    if (mask & (VIRIAL | STRESS_TENSOR)) {
+        cache<stress_pot_array_type> const& stress_pot_cache = particle_->stress_pot();
+        if ((mask & VIRIAL) && virial_cache_ != std::tie(stress_pot_cache, group_cache)) {
+            outdated |= VIRIAL;
+        }
+        if ((mask & STRESS_TENSOR) && stress_tensor_cache_ != std::tie(stress_pot_cache, particle_->velocity(), group_cache)) {
+            outdated |= STRESS_TENSOR;
+        }
+    }
+    return outdated;
+}
+
+template <int dimension, typename float_type>
+void thermodynamics<dimension, float_type>::reduce_(unsigned int mask)
+{
+    // include previously requested quantities whose input arrays may be
+    // accessed without triggering a computation of the force or of the
+    // auxiliary variables that would not happen otherwise
+    unsigned int candidates = KINETIC;
+    if (mask & (FORCE | AUX)) {
+        candidates |= FORCE;
+    }
+    if (mask & AUX) {
+        candidates |= AUX;
+    }
+    // age the requested quantities once per step, i.e., whenever the
+    // particles have moved, such that a quantity is no longer included if
+    // it has not been requested during the current or the previous step
+    if (requested_cache_ != particle_->position()) {
+        requested_before_ = requested_;
+        requested_ = 0;
+        requested_cache_ = particle_->position();
+    }
+    requested_ |= mask;
+    mask |= outdated_((requested_ | requested_before_) & candidates & ~mask);
+
+    group_array_type const& unordered = read_cache(group_->unordered());
+    velocity_array_type const* velocity = nullptr;
+    mass_array_type const* mass = nullptr;
+    typename particle_type::position_array_type const* position = nullptr;
+    typename particle_type::image_array_type const* image = nullptr;
+    typename particle_type::force_array_type const* force = nullptr;
+    en_pot_array_type const* en_pot = nullptr;
+    stress_pot_array_type const* stress_pot = nullptr;
+
+    if (mask & (EN_KIN | V_CM | STRESS_TENSOR)) {
+        velocity = &read_cache(particle_->velocity());
+    }
+    if (mask & (EN_KIN | V_CM | R_CM | STRESS_TENSOR)) {
+        mass = &read_cache(particle_->mass());
+    }
+    if (mask & R_CM) {
+        position = &read_cache(particle_->position());
+        image = &read_cache(particle_->image());
+    }
+    if (mask & FORCE) {
+        force = &read_cache(particle_->force());
+    }
+    if (mask & EN_POT) {
+        en_pot = &read_cache(particle_->potential_energy());
+    }
+    if (mask & (VIRIAL | STRESS_TENSOR)) {
+        stress_pot = &read_cache(particle_->stress_pot());
+    }
+
+    struct partial_sum
+    {
+        kahan_sum<double> mv2;
+        kahan_sum<vector_type> mv;
+        kahan_sum<double> m;
+        kahan_sum<vector_type> mr;
+        kahan_sum<vector_type> f;
+        kahan_sum<double> en_pot;
+        kahan_sum<double> virial;
+        kahan_sum<stress_tensor_type> stress_tensor;
+    };
+
+    std::vector<partial_sum> partial(thread_pool_->size());
+    thread_pool_->parallel_for(0, unordered.size(), [&](unsigned int thread, std::size_t first, std::size_t last) {
+        partial_sum& sum = partial[thread];
+        for (std::size_t k = first; k < last; ++k) {
+            size_type const i = unordered[k];
+            if (mask & (EN_KIN | V_CM | R_CM)) {
+                sum.m += (*mass)[i];
+            }
+            if (mask & EN_KIN) {
+                sum.mv2 += (*mass)[i] * inner_prod((*velocity)[i], (*velocity)[i]);
+            }
+            if (mask & V_CM) {
+                sum.mv += static_cast<vector_type>((*mass)[i] * (*velocity)[i]);
+            }
+            if (mask & R_CM) {
+                auto r = (*position)[i];
+                box_->extend_periodic(r, (*image)[i]);
+                sum.mr += static_cast<vector_type>((*mass)[i] * r);
+            }
+            if (mask & FORCE) {
+                sum.f += static_cast<vector_type>((*force)[i]);
+            }
+            if (mask & EN_POT) {
+                sum.en_pot += (*en_pot)[i];
+            }
+            if (mask & VIRIAL) {
+                // compute trace of the stress tensor
+                double trace = 0;
+                for (int j = 0; j < dimension; ++j) {
+                    trace += (*stress_pot)[i][j];
+                }
+                sum.virial += trace;
+            }
+            if (mask & STRESS_TENSOR) {
+                stress_tensor_type stress_kin = static_cast<stress_tensor_type>((*mass)[i] * mdsim::make_stress_tensor((*velocity)[i]));
+                sum.stress_tensor += static_cast<stress_tensor_type>((*stress_pot)[i]) + stress_kin;
+            }
+        }
+    });
+
+    // combine partial sums in the order of the threads
+    partial_sum sum;
+    for (partial_sum const& p : partial) {
+        sum.mv2 += p.mv2;
+        sum.mv += p.mv;
+        sum.m += p.m;
+        sum.mr += p.mr;
+        sum.f += p.f;
+        sum.en_pot += p.en_pot;
+        sum.virial += p.virial;
+        sum.stress_tensor += p.stress_tensor;
+    }
+
+    // store results and update cache observers
+    cache<size_type> const& group_cache = group_->size();
+    std::size_t const npart = unordered.size();
+
+    if (mask & EN_KIN) {
+        en_kin_ = 0.5 * sum.mv2() / npart;
+        en_kin_cache_ = std::tie(particle_->velocity(), particle_->mass(), group_cache);
+    }
+    if (mask & V_CM) {
+        v_cm_ = sum.mv() / sum.m();
+        mean_mass_ = sum.m() / npart;
+        v_cm_cache_ = std::tie(particle_->velocity(), particle_->mass(), group_cache);
+    }
+    if (mask & R_CM) {
+        r_cm_ = sum.mr() / sum.m();
+        r_cm_cache_ = std::tie(particle_->position(), particle_->mass(), group_cache);
+    }
+    if (mask & FORCE) {
+        force_ = sum.f();
+        force_cache_ = std::tie(particle_->force(), group_cache);
+    }
+    if (mask & EN_POT) {
+        en_pot_ = sum.en_pot() / npart;
+        en_pot_cache_ = std::tie(particle_->potential_energy(), group_cache);
+    }
+    if (mask & VIRIAL) {
+        virial_ = sum.virial() / npart;
+        virial_cache_ = std::tie(particle_->stress_pot(), group_cache);
+    }
+    if (mask & STRESS_TENSOR) {
+        stress_tensor_ = sum.stress_tensor();
+        stress_tensor_cache_ = std::tie(particle_->stress_pot(), particle_->velocity(), group_cache);
+    }
+}
+
 template <int dimension, typename float_type>
 void thermodynamics<dimension, float_type>::luaopen(lua_State* L)
 {
@@ -213,6 +384,7 @@ void thermodynamics<dimension, float_type>::luaopen(lua_State* L)
               , std::shared_ptr<particle_group_type>
               , std::shared_ptr<box_type const>
               , volume_type
+              , std::shared_ptr<thread_pool_type>
               , std::shared_ptr<logger>
             >)
         ]
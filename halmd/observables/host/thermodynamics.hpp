@@ -30,6 +30,7 @@
 #include <halmd/observables/thermodynamics.hpp>
 #include <halmd/utility/cache.hpp>
 #include <halmd/utility/profiler.hpp>
+#include <halmd/utility/thread_pool.hpp>
 
 #include <lua.hpp>
 
@@ -41,6 +42,19 @@ namespace halmd {
 namespace observables {
 namespace host {
 
+/**
+ * Compute thermodynamic state variables of a particle group.
+ *
+ * Upon the first request of a quantity after an update of the particle data,
+ * the quantities requested during the current or the previous step are
+ * computed as well in a single parallel pass over the particle group,
+ * provided they depend on particle arrays that are up to date. Thus, the
+ * kinetic quantities are reduced together, and the potential energy, virial,
+ * and stress tensor are included once one of them has been requested, which
+ * triggers the computation of the auxiliary variables in the force modules.
+ * The sums employ compensated summation, and the per-thread partial sums are
+ * combined in a fixed order.
+ */
 template <int dimension, typename float_type>
 class thermodynamics
   : public observables::thermodynamics<dimension>
@@ -55,6 +69,7 @@ public:
     typedef std::function<double ()> volume_type;
     typedef mdsim::host::particle<dimension, float_type> particle_type;
     typedef mdsim::host::particle_group particle_group_type;
+    typedef halmd::utility::thread_pool thread_pool_type;
 
     static void luaopen(lua_State* L);
 
@@ -63,6 +78,7 @@ public:
       , std::shared_ptr<particle_group_type> group
       , std::shared_ptr<box_type const> box
       , volume_type volume = nullptr
+      , std::shared_ptr<thread_pool_type> thread_pool = std::make_shared<thread_pool_type>()
       , std::shared_ptr<halmd::logger> logger = std::make_shared<halmd::logger>()
     );
 
@@ -126,6 +142,24 @@ private:
     typedef typename particle_type::stress_pot_array_type stress_pot_array_type;
     typedef typename particle_group_type::array_type group_array_type;
 
+    /** flags of the quantities computed in a single pass */
+    enum {
+        EN_KIN = 1 << 0
+      , FORCE = 1 << 1
+      , V_CM = 1 << 2           // including mean mass
+      , R_CM = 1 << 3
+      , EN_POT = 1 << 4
+      , VIRIAL = 1 << 5
+      , STRESS_TENSOR = 1 << 6
+      , KINETIC = EN_KIN | V_CM | R_CM
+      , AUX = EN_POT | VIRIAL | STRESS_TENSOR
+    };
+
+    /** returns the subset of the given quantities whose caches are outdated */
+    unsigned int outdated_(unsigned int mask);
+    /** compute the given and the recently requested outdated quantities */
+    void reduce_(unsigned int mask);
+
     /** system state */
     std::shared_ptr<particle_type> particle_;
     /** particle group */
@@ -134,6 +168,14 @@ private:
     std::shared_ptr<box_type const> box_;
     /** reference volume */
     volume_type volume_;
+    /** thread pool for parallel reduction over the particle group */
+    std::shared_ptr<thread_pool_type> thread_pool_;
+    /** flags of the quantities requested since the particles last moved */
+    unsigned int requested_;
+    /** flags of the quantities requested before the particles last moved */
+    unsigned int requested_before_;
+    /** cache observer of particle positions at the last request */
+    cache<> requested_cache_;
     /** module logger */
     std::shared_ptr<logger> logger_;
 
@@ -20,8 +20,10 @@
  * <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <exception>
 #include <functional>
+#include <stdexcept>
 
 #include <halmd/io/logger.hpp>
 #include <halmd/observables/sampler.hpp>
@@ -37,13 +39,17 @@ sampler::sampler(
   : clock_(clock)
   , core_(core)
   , first_run_(true)
+  , poll_period_(0.1)
+  , poll_interval_(1)
+  , poll_step_(clock_->step())
 {}
 
 void sampler::sample()
 {
-    LOG_DEBUG("sample state at step " << clock_->step());
-    on_prepare_();
-    on_sample_();
+    step_type step = clock_->step();
+    LOG_DEBUG("sample state at step " << step);
+    on_prepare_.fire_all(step);
+    on_sample_.fire_all(step);
 }
 
 void sampler::run(step_type steps)
@@ -60,22 +66,40 @@ void sampler::run(step_type steps)
 
         step_type limit = clock_->step() + steps;
 
+        // account for steps performed by other means than run()
+        on_prepare_.rebase(clock_->step());
+        on_sample_.rebase(clock_->step());
+        poll_step_ = std::min(poll_step_, clock_->step());
+
         while (clock_->step() < limit) {
+            step_type next = std::min({next_event_step(), poll_step_ + poll_interval_, limit});
+
+            // perform MD integration steps up to the next due step
+            if (clock_->step() + 1 < next) {
+                LOG_DEBUG("performing MD steps #" << clock_->step() + 1 << " to #" << next - 1);
+                core_->mdstep(next - 1 - clock_->step(), [&]() { clock_->advance(); });
+            }
+
             // increment 1-based simulation step
             clock_->advance();
+            step_type step = clock_->step();
 
-            LOG_DEBUG("performing MD step #" << clock_->step());
+            LOG_DEBUG("performing MD step #" << step);
 
             {
                 scoped_timer_type timer(runtime_.prepare);
-                on_prepare_();
+                on_prepare_.fire(step);
             }
             // perform complete MD integration step
             core_->mdstep();
 
             {
                 scoped_timer_type timer(runtime_.sample);
-                on_sample_();
+                on_sample_.fire(step);
+            }
+
+            if (step >= poll_step_ + poll_interval_) {
+                poll_(step);
             }
         }
     }
@@ -103,12 +127,7 @@ connection sampler::on_prepare(std::function<void ()> const& slot, step_type int
     if (interval == 0) {
         throw std::logic_error("Slot must not be connected to signal 'on_prepare' with zero sampling interval");
     }
-    return on_prepare_.connect([=]() {
-        step_type step = clock_->step();
-        if (step >= start && (step - start) % interval == 0) {
-            slot();
-        }
-    });
+    return on_prepare_.connect(slot, interval, start, clock_->step());
 }
 
 connection sampler::on_sample(std::function<void ()> const& slot, step_type interval, step_type start)
@@ -116,12 +135,84 @@ connection sampler::on_sample(std::function<void ()> const& slot, step_type inte
     if (interval == 0) {
         throw std::logic_error("Slot must not be connected to signal 'on_sample' with zero sampling interval");
     }
-    return on_sample_.connect([=]() {
-        step_type step = clock_->step();
-        if (step >= start && (step - start) % interval == 0) {
-            slot();
+    return on_sample_.connect(slot, interval, start, clock_->step());
+}
+
+connection sampler::on_poll(std::function<void ()> const& slot)
+{
+    return on_poll_.connect(slot);
+}
+
+void sampler::set_poll_period(double period)
+{
+    if (!(period > 0)) {
+        throw std::logic_error("sampler: poll period must be positive");
+    }
+    poll_period_ = period;
+}
+
+void sampler::poll_(step_type step)
+{
+    // estimate number of steps per poll period from the runtime since the
+    // previous poll, and grow the interval at most by a factor of two
+    double elapsed = poll_timer_.elapsed();
+    double interval = 2. * poll_interval_;
+    if (elapsed > 0) {
+        interval = std::min(interval, (step - poll_step_) * poll_period_ / elapsed);
+    }
+    poll_interval_ = std::max(step_type(1), step_type(interval));
+
+    // reschedule before invoking the slots, which may throw
+    poll_step_ = step;
+    poll_timer_.restart();
+    on_poll_();
+}
+
+sampler::step_type sampler::next_event_step() const
+{
+    return std::min(on_prepare_.next(), on_sample_.next());
+}
+
+connection sampler::schedule::connect(std::function<void ()> const& slot, step_type interval, step_type start, step_type step)
+{
+    auto ev = std::make_shared<event>(event{slot, interval, start, count_++});
+    queue_.push(entry{ev->next(step), ev->order, ev});
+    return events_.connect(ev);
+}
+
+void sampler::schedule::fire(step_type step)
+{
+    while (!queue_.empty() && queue_.top().step <= step) {
+        entry top = queue_.top();
+        queue_.pop();
+        std::shared_ptr<event> ev = top.target.lock();
+        if (ev) {
+            // reschedule before invoking the slot, which may throw
+            queue_.push(entry{ev->next(step), top.order, top.target});
+            if (ev->due(step)) {
+                ev->slot();
+            }
+        }
+    }
+}
+
+void sampler::schedule::fire_all(step_type step) const
+{
+    for (std::shared_ptr<event> const& ev : events_) {
+        if (ev->due(step)) {
+            ev->slot();
+        }
+    }
+}
+
+void sampler::schedule::rebase(step_type step)
+{
+    if (!queue_.empty() && queue_.top().step <= step) {
+        queue_ = decltype(queue_)();
+        for (std::shared_ptr<event> const& ev : events_) {
+            queue_.push(entry{ev->next(step), ev->order, ev});
         }
-    });
+    }
 }
 
 connection sampler::on_start(std::function<void ()> const& slot)
@@ -157,9 +248,12 @@ void sampler::luaopen(lua_State* L)
             .def("finish", &sampler::finish)
             .def("on_prepare", &sampler::on_prepare)
             .def("on_sample", &sampler::on_sample)
+            .def("on_poll", &sampler::on_poll)
             .def("on_start", &sampler::on_start)
             .def("on_finish", &sampler::on_finish)
             .property("first_run", &sampler::first_run)
+            .property("next_event_step", &sampler::next_event_step)
+            .property("poll_period", &sampler::poll_period, &sampler::set_poll_period)
             .scope
             [
                 class_<runtime>("runtime")
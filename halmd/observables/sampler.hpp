@@ -27,12 +27,33 @@
 #include <halmd/mdsim/core.hpp>
 #include <halmd/utility/profiler.hpp>
 #include <halmd/utility/signal.hpp>
+#include <halmd/utility/timer.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <vector>
 
 namespace halmd {
 namespace observables {
 
 /**
  * Sampler to run Molecular Dynamics simulation
+ *
+ * Slots connected with on_prepare() and on_sample() are invoked at periodic
+ * steps only. Instead of testing each slot at every step, the sampler keeps
+ * the slots in a queue ordered by the next step at which they are due. The
+ * integration steps up to the next due step are performed without invoking
+ * any slot.
+ *
+ * Slots connected with on_poll() are invoked between the batches of
+ * integration steps after a wall-clock period, see poll_period(). The step
+ * interval between polls is estimated from the measured runtime per step
+ * since the previous poll, and grows at most by a factor of two per poll.
+ * Thus, the latency of a poll is about one period while the runtime per step
+ * is steady, but not less than the runtime of a single step.
  */
 class sampler
 {
@@ -81,6 +102,15 @@ public:
         return first_run_;
     }
 
+    /**
+     * Returns the next step after the current one at which a slot connected
+     * with on_prepare() or on_sample() is due, or the maximum value of
+     * step_type if no such slot is connected.
+     *
+     * The returned step may be too early if slots have been disconnected.
+     */
+    step_type next_event_step() const;
+
     /**
      * Connect slot to signal emitted before MD integration step
      */
@@ -91,6 +121,25 @@ public:
      */
     connection on_sample(std::function<void ()> const& slot, step_type interval, step_type start);
 
+    /**
+     * Connect slot to signal emitted periodically in wall-clock time
+     */
+    connection on_poll(std::function<void ()> const& slot);
+
+    /**
+     * Returns the wall-clock period in seconds between invocations of slots
+     * connected with on_poll()
+     */
+    double poll_period() const
+    {
+        return poll_period_;
+    }
+
+    /**
+     * Set wall-clock period in seconds for slots connected with on_poll()
+     */
+    void set_poll_period(double period);
+
     /**
      * Connect slot to signal emitted before starting simulation run
      */
@@ -111,12 +160,96 @@ private:
     std::shared_ptr<clock_type> clock_;
     /** simulation core */
     std::shared_ptr<core_type> core_;
+    /**
+     * Periodic slots ordered by the next step at which they are due
+     *
+     * The slots are stored in a slots container, which provides the
+     * connection objects and the order of connection. The queue refers to the
+     * slots with weak pointers, thus a disconnected slot is dropped once it
+     * reaches the top of the queue.
+     */
+    class schedule
+    {
+    public:
+        schedule() : count_(0) {}
+
+        /** connect slot that is due at steps start + n × interval after given step */
+        connection connect(std::function<void ()> const& slot, step_type interval, step_type start, step_type step);
+        /** invoke slots due at given step in order of connection, and reschedule them */
+        void fire(step_type step);
+        /** invoke slots due at given step in order of connection, without rescheduling */
+        void fire_all(step_type step) const;
+        /** reschedule all slots if the queue refers to steps up to the given step */
+        void rebase(step_type step);
+
+        /** returns next step at which a slot is due, or maximum step if none */
+        step_type next() const
+        {
+            return queue_.empty() ? std::numeric_limits<step_type>::max() : queue_.top().step;
+        }
+
+    private:
+        struct event
+        {
+            std::function<void ()> slot;
+            step_type interval;
+            step_type start;
+            /** sequence number of connection */
+            std::uint64_t order;
+
+            /** returns true if slot is due at given step */
+            bool due(step_type step) const
+            {
+                return step >= start && (step - start) % interval == 0;
+            }
+
+            /** returns first step after given step at which slot is due */
+            step_type next(step_type step) const
+            {
+                return step < start ? start : start + ((step - start) / interval + 1) * interval;
+            }
+        };
+
+        struct entry
+        {
+            step_type step;
+            std::uint64_t order;
+            std::weak_ptr<event> target;
+
+            /** ordering for std::priority_queue, which yields the greatest element first */
+            bool operator<(entry const& other) const
+            {
+                return step > other.step || (step == other.step && order > other.order);
+            }
+        };
+
+        /** connected slots */
+        slots<std::shared_ptr<event>> events_;
+        /** queue of next due steps */
+        std::priority_queue<entry, std::vector<entry>> queue_;
+        /** number of connected slots since construction */
+        std::uint64_t count_;
+    };
+
     /** flag that is set upon first invocation of run() */
     bool first_run_;
-    /** signal emitted before MD integration step */
-    signal<void ()> on_prepare_;
-    /** signal emitted after MD integration step */
-    signal<void ()> on_sample_;
+    /** slots invoked before MD integration step */
+    schedule on_prepare_;
+    /** slots invoked after MD integration step */
+    schedule on_sample_;
+    /** invoke slots connected with on_poll() and schedule next poll */
+    void poll_(step_type step);
+
+    /** signal emitted periodically in wall-clock time */
+    signal<void ()> on_poll_;
+    /** wall-clock period between polls in seconds */
+    double poll_period_;
+    /** current step interval between polls */
+    step_type poll_interval_;
+    /** step of the previous poll */
+    step_type poll_step_;
+    /** wall-clock time since the previous poll */
+    timer poll_timer_;
     /** signal emitted before starting simulation run */
     signal<void ()> on_start_;
     /** signal emitted after finishing simulation run */
@@ -99,6 +99,12 @@ public:
         return filter_;
     }
 
+    //! returns edge lengths of simulation box
+    vector_type const& box_length() const
+    {
+        return box_length_;
+    }
+
     //! returns list of wavevectors
     wavevector_array_type const& value() const
     {
@@ -0,0 +1,117 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_RANDOM_HOST_PHILOX_HPP
+#define HALMD_RANDOM_HOST_PHILOX_HPP
+
+#include <halmd/random/philox_kernel.hpp>
+
+#include <cstdint>
+#include <limits>
+
+namespace halmd {
+namespace random {
+namespace host {
+
+/**
+ * Stream of random integers from the counter-based generator Philox4x32-10
+ *
+ * A stream is identified by the key, derived from the seed, a 64-bit
+ * sequence number, e.g., the simulation step or the number of the call of a
+ * module, and a 32-bit subsequence number, e.g., the particle identifier.
+ * Streams with different identifiers are statistically independent, and
+ * may be constructed and drawn from in any order and by any thread.
+ *
+ * The class models the UniformRandomBitGenerator concept and may be used
+ * with the random distributions of Boost and of the standard library.
+ *
+ * The counter comprises the 64-bit position within the stream (in units of
+ * four integers), the subsequence, and the sequence number:
+ *
+ *   (position % 2³², subsequence + position / 2³², sequence % 2³², sequence / 2³²)
+ *
+ * The GPU kernels may reproduce the stream with philox_kernel::philox4x32().
+ */
+class philox
+{
+public:
+    typedef std::uint32_t result_type;
+    typedef philox_kernel::counter_type counter_type;
+    typedef philox_kernel::key_type key_type;
+
+    /**
+     * Construct stream.
+     *
+     * @param key key derived from seed
+     * @param sequence sequence number
+     * @param subsequence subsequence number
+     */
+    philox(key_type const& key, std::uint64_t sequence, std::uint32_t subsequence)
+      : key_(key)
+      , index_(4)
+    {
+        counter_[0] = 0;
+        counter_[1] = subsequence;
+        counter_[2] = static_cast<std::uint32_t>(sequence);
+        counter_[3] = static_cast<std::uint32_t>(sequence >> 32);
+    }
+
+    /**
+     * Returns next random integer of stream.
+     */
+    result_type operator()()
+    {
+        if (index_ == 4) {
+            block_ = philox_kernel::philox4x32(counter_, key_);
+            // increment 64-bit position within stream
+            if (++counter_[0] == 0) {
+                ++counter_[1];
+            }
+            index_ = 0;
+        }
+        return block_[index_++];
+    }
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+private:
+    /** key derived from seed */
+    key_type key_;
+    /** counter of next block */
+    counter_type counter_;
+    /** current block of random integers */
+    counter_type block_;
+    /** index of next integer in block */
+    unsigned int index_;
+};
+
+} // namespace host
+} // namespace random
+} // namespace halmd
+
+#endif /* ! HALMD_RANDOM_HOST_PHILOX_HPP */
@@ -32,7 +32,11 @@ namespace host {
 
 std::shared_ptr<logger> const logger_ = std::make_shared<logger>("random (host)");
 
+constexpr std::uint64_t random::sequential;
+
 random::random(unsigned int seed)
+  : key_(0)
+  , rng_(key_, sequential, 0)
 {
     LOG("random number generator type: " << rng_name());
     random::seed(seed);
@@ -41,7 +45,9 @@ random::random(unsigned int seed)
 void random::seed(unsigned int seed)
 {
     LOG("set RNG seed: " << seed);
-    rng_.seed(seed);
+    key_[0] = seed;
+    key_[1] = 0;
+    rng_ = stream(sequential, 0);
 }
 
 /**
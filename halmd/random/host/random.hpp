@@ -23,26 +23,121 @@
 
 #include <algorithm>
 #include <boost/nondet_random.hpp> // boost::random_device
-#include <boost/random/mersenne_twister.hpp>
-#include <boost/random/uniform_01.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <lua.hpp>
+#include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <utility>
 
 #include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/random/host/philox.hpp>
+#include <halmd/random/philox_kernel.hpp>
 
 namespace halmd {
 namespace random {
 namespace host {
 
+namespace detail {
+
+/**
+ * Convert 32-bit random integer to uniform float in (0, 1]
+ */
+template <typename generator_type>
+inline float uniform(generator_type& rng, float)
+{
+    return philox_kernel::uniform_float(rng());
+}
+
+/**
+ * Convert two 32-bit random integers to uniform double in (0, 1]
+ */
+template <typename generator_type>
+inline double uniform(generator_type& rng, double)
+{
+    unsigned int hi = rng();
+    return philox_kernel::uniform_double(hi, rng());
+}
+
+} // namespace detail
+
+/**
+ * Generate uniformly distributed random number in (0, 1]
+ *
+ * The random integers are converted with the transforms of the GPU kernels,
+ * which yields identical numbers on host and GPU for identical streams.
+ */
+template <typename value_type, typename generator_type>
+inline value_type uniform(generator_type& rng)
+{
+    static_assert(
+        generator_type::min() == 0 && generator_type::max() == 0xffffffff
+      , "generator must yield 32-bit random integers"
+    );
+    return detail::uniform(rng, value_type());
+}
+
+/**
+ * Generate two random numbers from normal distribution
+ *
+ * The Box-Muller transformation for generating random numbers
+ * in the normal distribution was originally described in
+ *
+ *   G.E.P. Box and M.E. Muller, A Note on the Generation of
+ *   Random Normal Deviates, The Annals of Mathematical Statistics,
+ *   1958, 29, p. 610-611
+ *
+ * Here, we use instead the faster polar method of the Box-Muller
+ * transformation, see
+ *
+ *   D.E. Knuth, Art of Computer Programming, Volume 2: Seminumerical
+ *   Algorithms, 3rd Edition, 1997, Addison-Wesley, p. 122
+ */
+template <typename value_type, typename generator_type>
+inline std::pair<value_type, value_type> normal(generator_type& rng, value_type sigma)
+{
+    value_type x, y, s;
+    do {
+        x = 2 * uniform<value_type>(rng) - 1;
+        y = 2 * uniform<value_type>(rng) - 1;
+        s = x * x + y * y;
+    } while (s >= 1. || s == 0.);
+
+    s = sigma * std::sqrt(-2. * std::log(s) / s);
+    x *= s;
+    y *= s;
+    return std::make_pair(x, y);
+}
+
+/**
+ * Host random number generator
+ *
+ * The generator is based on the counter-based generator Philox4x32-10. Besides
+ * a sequential stream of random numbers for the member functions, it provides
+ * independent streams keyed by a sequence number and a subsequence number,
+ * which allow parallel and reproducible drawing of random numbers, e.g., one
+ * stream per particle with the particle identifier as subsequence:
+ *
+ *   std::uint64_t seq = random_type::sequence(clock->step(), random_type::stream_id::boltzmann);
+ *   // possibly in parallel
+ *   random::random_generator rng = random->stream(seq, id[i]);
+ *   std::tie(x, y) = random::host::normal(rng, sigma);
+ *
+ * The sequence number combines the simulation step with an identifier of the
+ * drawing module, so the streams depend only on the seed, the step, the
+ * module, and the particle. They neither depend on the order of the particles
+ * in memory nor on the number of threads, and a simulation resumed from a
+ * checkpoint draws the same numbers as the uninterrupted run. A module that
+ * draws more than once within a step, however, draws the same numbers again.
+ */
 class random
 {
 public:
-    typedef boost::mt19937 random_generator; // FIXME template parameter
+    typedef philox random_generator;
+    typedef random_generator::key_type key_type;
 
-    static char const* rng_name() { return "mt19937"; }
+    static char const* rng_name() { return "philox4x32"; }
 
     /**
      * Initialise random number generator.
@@ -55,9 +150,42 @@ public:
 
     /**
      * Seed random number generator.
+     *
+     * This resets the sequential stream.
      */
     void seed(unsigned int seed);
 
+    /**
+     * Identifiers of the modules that draw from keyed streams.
+     *
+     * Each module needs its own identifier, so that modules drawing in the
+     * same step draw from different streams.
+     */
+    enum class stream_id : std::uint16_t
+    {
+        boltzmann = 1
+      , verlet_nvt_andersen = 2
+    };
+
+    /**
+     * Returns sequence number for given simulation step and module.
+     *
+     * The step occupies the lower 48 bits and the module identifier the upper
+     * 16 bits of the sequence number, i.e., the streams repeat after 2⁴⁸ steps.
+     */
+    static std::uint64_t sequence(std::uint64_t step, stream_id id)
+    {
+        return (step & ((std::uint64_t(1) << 48) - 1)) | (std::uint64_t(id) << 48);
+    }
+
+    /**
+     * Returns stream of random numbers for given sequence and subsequence.
+     */
+    random_generator stream(std::uint64_t sequence, std::uint32_t subsequence) const
+    {
+        return random_generator(key_, sequence, subsequence);
+    }
+
     template <typename input_iterator>
     void shuffle(input_iterator first, input_iterator last);
     template <typename value_type>
@@ -77,7 +205,12 @@ public:
     static void luaopen(lua_State* L);
 
 private:
-    /** pseudo-random number generator */
+    /** sequence number reserved for the sequential stream */
+    static constexpr std::uint64_t sequential = ~std::uint64_t(0);
+
+    /** key derived from seed */
+    key_type key_;
+    /** sequential stream of random numbers */
     random_generator rng_;
 };
 
@@ -102,41 +235,16 @@ void random::shuffle(input_iterator first, input_iterator last)
 template <typename value_type>
 value_type random::uniform()
 {
-    boost::uniform_01<random_generator&, value_type> variate(rng_);
-    return variate();
+    return host::uniform<value_type>(rng_);
 }
 
 /**
  * Generate two random numbers from normal distribution
- *
- * The Box-Muller transformation for generating random numbers
- * in the normal distribution was originally described in
- *
- *   G.E.P. Box and M.E. Muller, A Note on the Generation of
- *   Random Normal Deviates, The Annals of Mathematical Statistics,
- *   1958, 29, p. 610-611
- *
- * Here, we use instead the faster polar method of the Box-Muller
- * transformation, see
- *
- *   D.E. Knuth, Art of Computer Programming, Volume 2: Seminumerical
- *   Algorithms, 3rd Edition, 1997, Addison-Wesley, p. 122
  */
 template <typename value_type>
 std::pair<value_type, value_type> random::normal(value_type sigma)
 {
-    boost::uniform_01<random_generator&, value_type> variate(rng_);
-    value_type x, y, s;
-    do {
-        x = 2. * variate() - 1.;
-        y = 2. * variate() - 1.;
-        s = x * x + y * y;
-    } while (s >= 1.);
-
-    s = sigma * std::sqrt(-2. * std::log(s) / s);
-    x *= s;
-    y *= s;
-    return std::make_pair(x, y);
+    return host::normal(rng_, sigma);
 }
 
 /**
@@ -0,0 +1,126 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_RANDOM_PHILOX_KERNEL_HPP
+#define HALMD_RANDOM_PHILOX_KERNEL_HPP
+
+#include <halmd/config.hpp>
+#include <halmd/numeric/blas/fixed_vector.hpp>
+
+namespace halmd {
+namespace random {
+namespace philox_kernel {
+
+/** 128-bit counter */
+typedef fixed_vector<unsigned int, 4> counter_type;
+/** 64-bit key */
+typedef fixed_vector<unsigned int, 2> key_type;
+
+namespace detail {
+
+/** multipliers and Weyl sequence constants of Philox4x32 */
+enum : unsigned int {
+    M0 = 0xD2511F53
+  , M1 = 0xCD9E8D57
+  , W0 = 0x9E3779B9
+  , W1 = 0xBB67AE85
+};
+
+/**
+ * Returns high word of 64-bit product, and stores low word in 'lo'.
+ */
+inline HALMD_GPU_ENABLED unsigned int mulhilo(unsigned int a, unsigned int b, unsigned int& lo)
+{
+#ifdef __CUDACC__
+    lo = a * b;
+    return __umulhi(a, b);
+#else
+    unsigned long long product = static_cast<unsigned long long>(a) * b;
+    lo = static_cast<unsigned int>(product);
+    return static_cast<unsigned int>(product >> 32);
+#endif
+}
+
+/**
+ * Single round of the Philox4x32 bijection
+ */
+inline HALMD_GPU_ENABLED counter_type round(counter_type const& ctr, key_type const& key)
+{
+    unsigned int lo0, lo1;
+    unsigned int hi0 = mulhilo(M0, ctr[0], lo0);
+    unsigned int hi1 = mulhilo(M1, ctr[2], lo1);
+    counter_type result;
+    result[0] = hi1 ^ ctr[1] ^ key[0];
+    result[1] = lo1;
+    result[2] = hi0 ^ ctr[3] ^ key[1];
+    result[3] = lo0;
+    return result;
+}
+
+} // namespace detail
+
+/**
+ * Counter-based pseudo-random number generator Philox4x32-10
+ *
+ * Maps a 128-bit counter and a 64-bit key to 128 random bits, i.e., four
+ * 32-bit random integers, see
+ *
+ *   J. K. Salmon, M. A. Moraes, R. O. Dror, and D. E. Shaw, Parallel random
+ *   numbers: As easy as 1, 2, 3, Proceedings of the International Conference
+ *   for High Performance Computing, Networking, Storage and Analysis (SC11),
+ *   2011, doi:10.1145/2063384.2063405
+ *
+ * The function yields identical results on host and GPU, and the output is
+ * bit-compatible with the reference implementation Random123.
+ */
+inline HALMD_GPU_ENABLED counter_type philox4x32(counter_type ctr, key_type key)
+{
+    for (unsigned int i = 0; i < 9; ++i) {
+        ctr = detail::round(ctr, key);
+        key[0] += detail::W0;
+        key[1] += detail::W1;
+    }
+    return detail::round(ctr, key);
+}
+
+/**
+ * Convert 32-bit random integer to uniform float in (0, 1]
+ */
+inline HALMD_GPU_ENABLED float uniform_float(unsigned int x)
+{
+    // use upper 24 bits, which are exactly representable
+    return ((x >> 8) + 1) * (1.f / 16777216);
+}
+
+/**
+ * Convert two 32-bit random integers to uniform double in (0, 1]
+ */
+inline HALMD_GPU_ENABLED double uniform_double(unsigned int hi, unsigned int lo)
+{
+    // use 53 bits, which are exactly representable
+    unsigned long long x = (static_cast<unsigned long long>(hi) << 21) ^ (lo >> 11);
+    return (x + 1) * (1. / 9007199254740992.);
+}
+
+} // namespace philox_kernel
+} // namespace random
+} // namespace halmd
+
+#endif /* ! HALMD_RANDOM_PHILOX_KERNEL_HPP */
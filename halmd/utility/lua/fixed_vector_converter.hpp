@@ -29,6 +29,7 @@
 
 #include <halmd/config.hpp>
 #include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/numeric/blas/padded_vector.hpp>
 
 #if LUA_VERSION_NUM < 502
 # define luaL_len lua_objlen
@@ -82,6 +83,42 @@ template <typename T, std::size_t N>
 struct default_converter<halmd::fixed_vector<T, N>&&>
   : default_converter<halmd::fixed_vector<T, N> > {};
 
+/**
+ * Luabind converter for padded fixed-size algebraic vector
+ */
+template <typename T, std::size_t N>
+struct default_converter<halmd::padded_vector<T, N> >
+  : native_converter_base<halmd::padded_vector<T, N> >
+{
+    typedef default_converter<halmd::fixed_vector<T, N> > vector_converter;
+
+    //! compute Lua to C++ conversion score
+    static int compute_score(lua_State* L, int index)
+    {
+        return vector_converter::compute_score(L, index);
+    }
+
+    //! convert from Lua to C++
+    halmd::padded_vector<T, N> from(lua_State* L, int index)
+    {
+        return vector_converter().from(L, index);
+    }
+
+    //! convert from C++ to Lua
+    void to(lua_State* L, halmd::padded_vector<T, N> const& v)
+    {
+        vector_converter().to(L, v);
+    }
+};
+
+template <typename T, std::size_t N>
+struct default_converter<halmd::padded_vector<T, N> const&>
+  : default_converter<halmd::padded_vector<T, N> > {};
+
+template <typename T, std::size_t N>
+struct default_converter<halmd::padded_vector<T, N>&&>
+  : default_converter<halmd::padded_vector<T, N> > {};
+
 } // namespace luaponte
 
 #if LUA_VERSION_NUM < 502
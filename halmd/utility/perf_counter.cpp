@@ -0,0 +1,269 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/io/logger.hpp>
+#include <halmd/utility/perf_counter.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+namespace halmd {
+namespace utility {
+
+/**
+ * Group of hardware counters of a single thread
+ *
+ * The cycles counter is the group leader, such that all counters are
+ * scheduled together. If the kernel multiplexes the group with other
+ * events, the counts are scaled by the fraction of time the group was
+ * running.
+ *
+ * The open groups of all threads are registered, such that any thread may
+ * read the sum of the counters. The final counts of a group are retained
+ * when its thread exits.
+ */
+class perf_counter::group
+{
+public:
+    group() : error_(0)
+    {
+        // construct registry before the first group, which it thus outlives
+        registry& reg = registry_();
+        fd_.fill(-1);
+#ifdef __linux__
+        static std::uint64_t const config[nevent] = {
+            PERF_COUNT_HW_CPU_CYCLES
+          , PERF_COUNT_HW_INSTRUCTIONS
+          , PERF_COUNT_HW_CACHE_MISSES
+          , PERF_COUNT_HW_BRANCH_MISSES
+        };
+        for (unsigned int i = 0; i < nevent; ++i) {
+            struct perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config[i];
+            attr.disabled = (i == 0);
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            // count calling thread on any CPU
+            fd_[i] = syscall(__NR_perf_event_open, &attr, 0, -1, fd_[0], 0);
+            if (fd_[i] == -1) {
+                error_ = errno;
+                close_();
+                return;
+            }
+        }
+        ioctl(fd_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fd_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.groups.push_back(this);
+#else
+        (void) reg;
+        error_ = ENOSYS;
+#endif
+    }
+
+    ~group()
+    {
+        if (open()) {
+            registry& reg = registry_();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            value_type value;
+            if (read(value)) {
+                for (unsigned int i = 0; i < nevent; ++i) {
+                    reg.closed[i] += value[i];
+                }
+            }
+            reg.groups.erase(std::find(reg.groups.begin(), reg.groups.end(), this));
+        }
+        close_();
+    }
+
+    /** read sum of counters of all open and closed groups */
+    static void read_all(value_type& value)
+    {
+        registry& reg = registry_();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        value = reg.closed;
+        for (group const* g : reg.groups) {
+            value_type v;
+            if (g->read(v)) {
+                for (unsigned int i = 0; i < nevent; ++i) {
+                    value[i] += v[i];
+                }
+            }
+        }
+    }
+
+    /** returns true if counters are open */
+    bool open() const
+    {
+        return fd_[0] != -1;
+    }
+
+    /** returns error number of failed perf_event_open() */
+    int error() const
+    {
+        return error_;
+    }
+
+    bool read(value_type& value) const
+    {
+#ifdef __linux__
+        // number of counters, time enabled, time running, values
+        std::uint64_t buf[3 + nevent];
+        if (!open() || ::read(fd_[0], buf, sizeof(buf)) != sizeof(buf) || buf[0] != nevent) {
+            return false;
+        }
+        double scale = buf[2] > 0 ? double(buf[1]) / buf[2] : 0;
+        for (unsigned int i = 0; i < nevent; ++i) {
+            value[i] = buf[3 + i] * scale;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    /** open groups of all threads */
+    struct registry
+    {
+        std::mutex mutex;
+        std::vector<group const*> groups;
+        /** final counts of closed groups */
+        value_type closed = value_type();
+    };
+
+    static registry& registry_()
+    {
+        static registry instance;
+        return instance;
+    }
+
+    void close_()
+    {
+#ifdef __linux__
+        for (int& fd : fd_) {
+            if (fd != -1) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+    }
+
+    std::array<int, nevent> fd_;
+    int error_;
+};
+
+std::atomic<bool> perf_counter::enabled_(false);
+
+namespace {
+
+/** accumulated counts per timed scope */
+struct counts_map
+{
+    std::mutex mutex;
+    std::map<void const*, perf_counter::value_type> counts;
+
+    static counts_map& get()
+    {
+        static counts_map instance;
+        return instance;
+    }
+};
+
+} // namespace
+
+perf_counter::group& perf_counter::local_()
+{
+    thread_local group local;
+    return local;
+}
+
+bool perf_counter::enable(bool flag)
+{
+    if (flag && !enabled()) {
+        group const& g = local_();
+        if (!g.open()) {
+            LOG_WARNING("hardware performance counters are not available: " << std::strerror(g.error()));
+            return false;
+        }
+        LOG("enable hardware performance counters");
+    }
+    enabled_.store(flag, std::memory_order_relaxed);
+    return flag;
+}
+
+bool perf_counter::read(value_type& value)
+{
+    if (!local_().open()) {
+        return false;
+    }
+    group::read_all(value);
+    return true;
+}
+
+void perf_counter::add(void const* id, value_type const& begin)
+{
+    value_type end;
+    if (!read(end)) {
+        return;
+    }
+    counts_map& m = counts_map::get();
+    std::lock_guard<std::mutex> lock(m.mutex);
+    auto it = m.counts.emplace(id, value_type()).first;
+    for (unsigned int i = 0; i < nevent; ++i) {
+        it->second[i] += end[i] - begin[i];
+    }
+}
+
+perf_counter::value_type perf_counter::counts(void const* id)
+{
+    counts_map& m = counts_map::get();
+    std::lock_guard<std::mutex> lock(m.mutex);
+    auto it = m.counts.find(id);
+    return it != m.counts.end() ? it->second : value_type();
+}
+
+void perf_counter::reset()
+{
+    counts_map& m = counts_map::get();
+    std::lock_guard<std::mutex> lock(m.mutex);
+    m.counts.clear();
+}
+
+} // namespace utility
+} // namespace halmd
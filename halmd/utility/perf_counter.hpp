@@ -0,0 +1,118 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_UTILITY_PERF_COUNTER_HPP
+#define HALMD_UTILITY_PERF_COUNTER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace halmd {
+namespace utility {
+
+/**
+ * Hardware performance counters of timed scopes
+ *
+ * If enabled, each scoped_timer reads the hardware counters at the begin and
+ * end of its scope, and adds the differences to the counts of its runtime
+ * accumulator, identified by its address. The counters are opened per thread
+ * with the Linux perf_event_open() system call and count user-space events
+ * only. The threads of a thread pool open their counters when they run their
+ * first task after enabling, see attach().
+ *
+ * A reading is the sum over the counters of all threads, including those of
+ * threads that have exited since. Thus, the counts of a scope that spans a
+ * parallel section include the events of the pool threads. Conversely, they
+ * also include the events of any other thread running concurrently with the
+ * scope, e.g., an asynchronous task.
+ *
+ * If the counters cannot be opened, e.g., for lack of permission or if the
+ * hardware events are not supported, enable() fails and scoped timers
+ * measure the wall time only.
+ */
+class perf_counter
+{
+public:
+    /** hardware events */
+    enum event
+    {
+        cycles
+      , instructions
+      , llc_misses
+      , branch_misses
+      , nevent
+    };
+
+    typedef std::array<double, nevent> value_type;
+
+    /** returns true if counters are enabled */
+    static bool enabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * enable or disable counters
+     *
+     * Returns true if the counters are enabled. Enabling fails if the
+     * counters cannot be opened for the calling thread.
+     */
+    static bool enable(bool flag);
+
+    /** open counters of calling thread, if enabled */
+    static void attach()
+    {
+        if (enabled()) {
+            local_();
+        }
+    }
+
+    /**
+     * read counters summed over all threads
+     *
+     * Returns false if the counters are not available for the calling thread.
+     */
+    static bool read(value_type& value);
+
+    /** read counters, and add differences to given counts to those of id */
+    static void add(void const* id, value_type const& begin);
+
+    /** returns accumulated counts of id, which are zero if none were recorded */
+    static value_type counts(void const* id);
+
+    /** discard accumulated counts */
+    static void reset();
+
+private:
+    class group;
+
+    /** returns counter group of calling thread */
+    static group& local_();
+
+    /** counter flag */
+    static std::atomic<bool> enabled_;
+};
+
+} // namespace utility
+} // namespace halmd
+
+#endif /* ! HALMD_UTILITY_PERF_COUNTER_HPP */
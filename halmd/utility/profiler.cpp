@@ -21,7 +21,12 @@
 
 #include <algorithm>
 #include <boost/foreach.hpp>
+#include <fstream>
 #include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include <halmd/io/logger.hpp>
@@ -104,6 +109,7 @@ void profiler::profile()
     for (slots_const_iterator acc = accumulators_.begin(); acc != accumulators_.end(); ++acc) {
         acc->first->reset();
     }
+    perf_counter::reset();
     on_append_profile_();
 }
 
@@ -153,14 +159,141 @@ void profiler::log() const
             log_level = logging::debug;
         }
 
+        counts_type c = counts(acc.first);
+        std::ostringstream hw;
+        if (c.instructions > 0) {
+            hw << std::fixed << std::setprecision(2)
+               << " [IPC " << c.ipc()
+               << ", LLC misses " << c.llc_mpki() << "/kinstr"
+               << ", branch misses " << c.branch_mpki() << "/kinstr]";
+        }
+
         HALMD_LOG(
             log_level
           , "[" << std::setw(5) << std::fixed << std::setprecision(1) << fraction * 100 << "%] "
-                << acc.second << ": " << *acc.first
+                << acc.second << ": " << *acc.first << hw.str()
         );
     }
 }
 
+profiler::counts_type profiler::counts(std::shared_ptr<accumulator_type> acc) const
+{
+    perf_counter::value_type value = perf_counter::counts(acc.get());
+    counts_type c;
+    c.cycles = value[perf_counter::cycles];
+    c.instructions = value[perf_counter::instructions];
+    c.llc_misses = value[perf_counter::llc_misses];
+    c.branch_misses = value[perf_counter::branch_misses];
+    return c;
+}
+
+std::string profiler::describe_(void const* id) const
+{
+    for (accumulator_pair_type const& acc : accumulators_) {
+        if (acc.first.get() == id) {
+            return acc.second;
+        }
+    }
+    return "unregistered timer";
+}
+
+/**
+ * escape string for use in JSON
+ */
+static std::string json_escape(std::string const& str)
+{
+    std::string result;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        if (static_cast<unsigned char>(c) >= 0x20) {
+            result += c;
+        }
+    }
+    return result;
+}
+
+void profiler::write_trace(std::string const& filename) const
+{
+    std::vector<std::vector<trace::event>> events = trace::events();
+
+    std::uint64_t origin = std::numeric_limits<std::uint64_t>::max();
+    for (auto const& thread : events) {
+        for (trace::event const& ev : thread) {
+            origin = std::min(origin, ev.begin);
+        }
+    }
+
+    std::ofstream file(filename);
+    if (!file) {
+        throw std::runtime_error("failed to open trace file " + filename);
+    }
+    std::map<void const*, std::string> name;
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    char const* sep = "\n";
+    for (unsigned int tid = 0; tid < events.size(); ++tid) {
+        for (trace::event const& ev : events[tid]) {
+            auto it = name.find(ev.id);
+            if (it == name.end()) {
+                it = name.emplace(ev.id, json_escape(describe_(ev.id))).first;
+            }
+            // times in µs
+            file << sep << std::fixed << std::setprecision(3)
+                 << "{\"name\":\"" << it->second << "\",\"cat\":\"halmd\",\"ph\":\"X\""
+                 << ",\"ts\":" << 1e-3 * (ev.begin - origin)
+                 << ",\"dur\":" << 1e-3 * (ev.end - ev.begin)
+                 << ",\"pid\":0,\"tid\":" << tid << "}";
+            sep = ",\n";
+        }
+    }
+    file << "\n]}\n";
+    LOG("wrote trace of profiled scopes to " << filename);
+}
+
+void profiler::write_flame_graph(std::string const& filename) const
+{
+    std::map<void const*, std::string> name;
+    std::map<std::string, std::int64_t> self;
+
+    for (std::vector<trace::event> thread : trace::events()) {
+        // order enclosing scopes before nested ones
+        std::stable_sort(thread.begin(), thread.end(), [](trace::event const& a, trace::event const& b) {
+            return a.begin < b.begin || (a.begin == b.begin && a.depth < b.depth);
+        });
+        // stack of enclosing scopes with their depth and folded stack
+        std::vector<std::pair<unsigned int, std::string>> stack;
+        for (trace::event const& ev : thread) {
+            while (!stack.empty() && stack.back().first >= ev.depth) {
+                stack.pop_back();
+            }
+            auto it = name.find(ev.id);
+            if (it == name.end()) {
+                std::string desc = describe_(ev.id);
+                std::replace(desc.begin(), desc.end(), ';', ',');
+                it = name.emplace(ev.id, desc).first;
+            }
+            std::int64_t duration = ev.end - ev.begin;
+            std::string path = it->second;
+            if (!stack.empty()) {
+                self[stack.back().second] -= duration;
+                path = stack.back().second + ";" + path;
+            }
+            self[path] += duration;
+            stack.emplace_back(ev.depth, path);
+        }
+    }
+
+    std::ofstream file(filename);
+    if (!file) {
+        throw std::runtime_error("failed to open flame graph file " + filename);
+    }
+    for (auto const& entry : self) {
+        file << entry.first << " " << std::max(entry.second, std::int64_t(0)) << "\n";
+    }
+    LOG("wrote flame graph of profiled scopes to " << filename);
+}
+
 void profiler::luaopen(lua_State* L)
 {
     using namespace luaponte;
@@ -174,9 +307,24 @@ void profiler::luaopen(lua_State* L)
                 .def("on_prepend_profile", &profiler::on_prepend_profile)
                 .def("on_append_profile", &profiler::on_append_profile)
                 .def("profile", &profiler::profile)
+                .def("write_trace", &profiler::write_trace)
+                .def("write_flame_graph", &profiler::write_flame_graph)
+                .def("clear_trace", &profiler::clear_trace)
+                .property("tracing", &profiler::tracing, &profiler::set_tracing)
+                .property("trace_capacity", &profiler::trace_capacity, &profiler::set_trace_capacity)
+                .property("hardware_counters", &profiler::hardware_counters, &profiler::set_hardware_counters)
+                .def("counts", &profiler::counts)
                 .scope
                 [
                     class_<accumulator_type>("accumulator")
+                  , class_<counts_type>("counts")
+                        .def_readonly("cycles", &counts_type::cycles)
+                        .def_readonly("instructions", &counts_type::instructions)
+                        .def_readonly("llc_misses", &counts_type::llc_misses)
+                        .def_readonly("branch_misses", &counts_type::branch_misses)
+                        .property("ipc", &counts_type::ipc)
+                        .property("llc_mpki", &counts_type::llc_mpki)
+                        .property("branch_mpki", &counts_type::branch_mpki)
                 ]
         ]
     ];
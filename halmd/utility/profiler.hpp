@@ -25,8 +25,12 @@
 
 #include <halmd/numeric/accumulator.hpp>
 #include <halmd/utility/scoped_timer.hpp>
+#include <halmd/utility/perf_counter.hpp>
 #include <halmd/utility/signal.hpp>
 #include <halmd/utility/timer.hpp>
+#include <halmd/utility/trace.hpp>
+
+#include <string>
 
 namespace halmd {
 namespace utility {
@@ -52,6 +56,16 @@ namespace utility {
  * We allow disconnection of accumulators by use of the halmd::slots
  * container, which returns a connection object when an accumulator
  * is connected (i.e. inserted).
+ *
+ * In tracing mode, the scopes timed with the accumulators are recorded
+ * with their nesting, see utility::trace. The events are written either as
+ * a timeline in the Chrome trace format, which is also read by Perfetto,
+ * or as a flame graph summary in the folded stack format. The events are
+ * named by the descriptions of the connected accumulators.
+ *
+ * Optionally, hardware events are counted in the timed scopes, see
+ * utility::perf_counter, and the instructions per cycle and the rates of
+ * cache and branch misses are logged along with the runtimes.
  */
 class profiler
 {
@@ -74,6 +88,95 @@ public:
     connection on_append_profile(slot_function_type const& slot);
     /** log and reset runtime accumulators */
     void profile();
+
+    /** returns true if tracing is enabled */
+    bool tracing() const
+    {
+        return trace::enabled();
+    }
+
+    /** enable or disable tracing */
+    void set_tracing(bool flag)
+    {
+        trace::enable(flag);
+    }
+
+    /** returns maximum number of recorded events per thread */
+    std::size_t trace_capacity() const
+    {
+        return trace::capacity();
+    }
+
+    /** set maximum number of recorded events per thread, and discard events */
+    void set_trace_capacity(std::size_t capacity)
+    {
+        trace::set_capacity(capacity);
+    }
+
+    /** returns true if hardware events are counted */
+    bool hardware_counters() const
+    {
+        return perf_counter::enabled();
+    }
+
+    /**
+     * enable or disable counting of hardware events
+     *
+     * If the counters are not available, a warning is logged and only the
+     * runtimes are profiled.
+     */
+    void set_hardware_counters(bool flag)
+    {
+        perf_counter::enable(flag);
+    }
+
+    /** hardware event counts of a runtime accumulator */
+    struct counts_type
+    {
+        double cycles;
+        double instructions;
+        double llc_misses;
+        double branch_misses;
+
+        /** instructions per cycle */
+        double ipc() const
+        {
+            return cycles > 0 ? instructions / cycles : 0;
+        }
+
+        /** last-level cache misses per 1000 instructions */
+        double llc_mpki() const
+        {
+            return instructions > 0 ? 1e3 * llc_misses / instructions : 0;
+        }
+
+        /** branch misses per 1000 instructions */
+        double branch_mpki() const
+        {
+            return instructions > 0 ? 1e3 * branch_misses / instructions : 0;
+        }
+    };
+
+    /** returns hardware event counts of accumulator since last profile() */
+    counts_type counts(std::shared_ptr<accumulator_type> acc) const;
+
+    /** write recorded events to file in Chrome trace format (JSON) */
+    void write_trace(std::string const& filename) const;
+
+    /**
+     * write summary of recorded events to file in folded stack format
+     *
+     * Each line holds the descriptions of nested scopes separated by
+     * semicolons, followed by the time in ns spent in the innermost scope
+     * outside of traced child scopes, summed over all threads.
+     */
+    void write_flame_graph(std::string const& filename) const;
+
+    /** discard recorded events */
+    void clear_trace()
+    {
+        trace::clear();
+    }
     /** Lua bindings */
     static void luaopen(lua_State* L);
 
@@ -84,6 +187,8 @@ private:
     typedef slots_type::const_iterator slots_const_iterator;
 
     void log() const;
+    /** returns description of accumulator with given address */
+    std::string describe_(void const* id) const;
 
     /** accumulators slots */
     slots_type accumulators_;
@@ -25,7 +25,9 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdlib>
 #include <cstring>
+#include <new>
 #include <type_traits>
 
 namespace halmd {
@@ -37,6 +39,7 @@ namespace halmd {
  * with a fixed number of array elements and without value initialisation.
  *
  * raw_array provides a random-access container with minimal allocation time.
+ * The storage is aligned to cache lines, or to the alignment of T if larger.
  */
 template <typename T>
 class raw_array
@@ -204,16 +207,23 @@ public:
     }
 
 private:
+    /** alignment of storage in bytes */
+    static constexpr size_type alignment = alignof(T) > 64 ? alignof(T) : 64;
+
     /** allocate uninitialised storage */
     static pointer allocate(size_type size)
     {
-        return static_cast<pointer>(::operator new(size * sizeof(value_type)));
+        void* p = nullptr;
+        if (size > 0 && posix_memalign(&p, alignment, size * sizeof(value_type)) != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<pointer>(p);
     }
 
     /** deallocate storage */
     static void deallocate(pointer p)
     {
-        ::operator delete(p);
+        std::free(p);
     }
 
     /** number of array elements memory reserved for */
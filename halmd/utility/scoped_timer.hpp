@@ -22,12 +22,21 @@
 #define HALMD_UTILITY_SCOPED_TIMER_HPP
 
 #include <boost/bind/bind.hpp>
+#include <cstdint>
 #include <functional>
 
+#include <halmd/utility/perf_counter.hpp>
+#include <halmd/utility/trace.hpp>
+
 namespace halmd {
 
 /**
  * Scoped timer
+ *
+ * If tracing is enabled, the scope is recorded as an event identified by the
+ * address of the functor, see utility::trace. Likewise, if hardware counters
+ * are enabled, the counts of the scope are added to those of the functor,
+ * see utility::perf_counter.
  */
 template <typename Timer>
 class scoped_timer
@@ -46,6 +55,14 @@ public:
 
 private:
     std::function<void ()> elapsed_;
+    /** functor address if scope is traced, or nullptr */
+    void const* trace_;
+    /** begin time of traced scope */
+    std::uint64_t begin_;
+    /** functor address if hardware events are counted, or nullptr */
+    void const* count_;
+    /** hardware counters at begin of scope */
+    utility::perf_counter::value_type counter_;
 
     template <typename UnaryFunctor>
     static void elapsed(UnaryFunctor& f, Timer const& t);
@@ -60,12 +77,30 @@ inline scoped_timer<Timer>::scoped_timer(UnaryFunctor& f)
           , boost::ref(f)
           , Timer() // start timer, as late as possible
         )
-    ) {}
+    )
+  , trace_(nullptr)
+  , begin_(0)
+  , count_(nullptr)
+{
+    if (utility::trace::enabled()) {
+        trace_ = &f;
+        begin_ = utility::trace::begin();
+    }
+    if (utility::perf_counter::enabled() && utility::perf_counter::read(counter_)) {
+        count_ = &f;
+    }
+}
 
 template <typename Timer>
 inline scoped_timer<Timer>::~scoped_timer()
 {
     elapsed_();
+    if (trace_) {
+        utility::trace::end(trace_, begin_);
+    }
+    if (count_) {
+        utility::perf_counter::add(count_, counter_);
+    }
 }
 
 template <typename Timer>
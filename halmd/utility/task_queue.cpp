@@ -0,0 +1,107 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/utility/task_queue.hpp>
+
+#include <stdexcept>
+#include <utility>
+
+namespace halmd {
+namespace utility {
+
+task_queue::task_queue(unsigned int capacity)
+  : capacity_(capacity)
+  , shutdown_(false)
+{
+    if (capacity_ < 1) {
+        throw std::invalid_argument("task queue requires a capacity of at least one task");
+    }
+    thread_ = std::thread(&task_queue::work_, this);
+}
+
+task_queue::~task_queue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void task_queue::submit(task_type task)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&]() { return queue_.size() < capacity_ || exception_; });
+        rethrow_();
+        queue_.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void task_queue::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&]() { return queue_.empty(); });
+    rethrow_();
+}
+
+void task_queue::rethrow_()
+{
+    if (exception_) {
+        std::exception_ptr exception = exception_;
+        exception_ = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void task_queue::work_()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&]() { return shutdown_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            // shutdown after all pending tasks have completed
+            return;
+        }
+        // keep task in queue while executing, to account for its slot
+        task_type& task = queue_.front();
+        lock.unlock();
+        std::exception_ptr exception;
+        try {
+            task();
+        }
+        catch (...) {
+            exception = std::current_exception();
+        }
+        lock.lock();
+        queue_.pop_front();
+        if (exception) {
+            // discard the remaining tasks, which may depend on the failed one
+            queue_.clear();
+            exception_ = exception;
+        }
+        done_.notify_all();
+    }
+}
+
+} // namespace utility
+} // namespace halmd
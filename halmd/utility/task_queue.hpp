@@ -0,0 +1,100 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_UTILITY_TASK_QUEUE_HPP
+#define HALMD_UTILITY_TASK_QUEUE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace halmd {
+namespace utility {
+
+/**
+ * Background thread executing tasks in the order of submission
+ *
+ * The queue allows the simulation to proceed while the submitted tasks are
+ * processed. The number of pending tasks is bounded by the capacity of the
+ * queue: submit() blocks until a task has completed if the queue is full.
+ *
+ * An exception thrown by a task is rethrown by the next call of submit() or
+ * wait() in the submitting thread. All subsequent tasks are discarded.
+ */
+class task_queue
+{
+public:
+    typedef std::function<void ()> task_type;
+
+    /** start thread with given maximum number of pending tasks */
+    explicit task_queue(unsigned int capacity = 1);
+    /** complete pending tasks and join thread */
+    ~task_queue();
+
+    task_queue(task_queue const&) = delete;
+    task_queue& operator=(task_queue const&) = delete;
+
+    /**
+     * Enqueue task, and wait for a free slot if the queue is full.
+     */
+    void submit(task_type task);
+
+    /**
+     * Wait for completion of all submitted tasks.
+     */
+    void wait();
+
+    /** returns maximum number of pending tasks */
+    unsigned int capacity() const
+    {
+        return capacity_;
+    }
+
+private:
+    /** main loop of the thread */
+    void work_();
+    /** rethrow and clear exception of a failed task, if any */
+    void rethrow_();
+
+    /** maximum number of pending tasks */
+    unsigned int capacity_;
+    /** guards the following members */
+    std::mutex mutex_;
+    /** notifies the thread of a new task or of shutdown */
+    std::condition_variable wake_;
+    /** notifies the submitting thread of a completed task */
+    std::condition_variable done_;
+    /** queue of pending tasks, the front task is being executed */
+    std::deque<task_type> queue_;
+    /** flag that the thread shall exit */
+    bool shutdown_;
+    /** exception thrown by a task */
+    std::exception_ptr exception_;
+    /** background thread, started last */
+    std::thread thread_;
+};
+
+} // namespace utility
+} // namespace halmd
+
+#endif /* ! HALMD_UTILITY_TASK_QUEUE_HPP */
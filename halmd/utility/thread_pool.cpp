@@ -0,0 +1,185 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/io/logger.hpp>
+#include <halmd/utility/lua/lua.hpp>
+#include <halmd/utility/perf_counter.hpp>
+#include <halmd/utility/thread_pool.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace halmd {
+namespace utility {
+
+thread_pool::thread_pool(unsigned int nthread)
+  : nthread_(1)
+  , task_(nullptr)
+  , generation_(0)
+  , pending_(0)
+  , shutdown_(false)
+  , busy_(false)
+{
+    resize(nthread);
+}
+
+thread_pool::~thread_pool()
+{
+    stop_();
+}
+
+void thread_pool::resize(unsigned int nthread)
+{
+    if (nthread == 0) {
+        nthread = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (busy_) {
+            throw std::logic_error("thread pool must not be resized from within a task");
+        }
+    }
+    if (nthread != nthread_ || worker_.size() + 1 != nthread) {
+        stop_();
+        nthread_ = nthread;
+        start_();
+    }
+    LOG("number of host threads: " << nthread_);
+}
+
+void thread_pool::run(task_type const& task)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (busy_ || nthread_ == 1) {
+        // nested invocation or no workers: process all blocks serially
+        lock.unlock();
+        for (unsigned int thread = 0; thread < nthread_; ++thread) {
+            task(thread);
+        }
+        return;
+    }
+
+    busy_ = true;
+    task_ = &task;
+    exception_ = nullptr;
+    pending_ = nthread_ - 1;
+    ++generation_;
+    lock.unlock();
+    wake_.notify_all();
+
+    // the calling thread takes part as thread 0
+    invoke_(0);
+
+    lock.lock();
+    done_.wait(lock, [&]() { return pending_ == 0; });
+    task_ = nullptr;
+    busy_ = false;
+    std::exception_ptr exception = exception_;
+    exception_ = nullptr;
+    lock.unlock();
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void thread_pool::start_()
+{
+    shutdown_ = false;
+    for (unsigned int thread = 1; thread < nthread_; ++thread) {
+        worker_.emplace_back(&thread_pool::work_, this, thread, generation_);
+    }
+}
+
+void thread_pool::stop_()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : worker_) {
+        worker.join();
+    }
+    worker_.clear();
+}
+
+void thread_pool::work_(unsigned int thread, unsigned long generation)
+{
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&]() { return shutdown_ || generation_ != generation; });
+            if (shutdown_) {
+                return;
+            }
+            generation = generation_;
+        }
+
+        invoke_(thread);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+}
+
+void thread_pool::invoke_(unsigned int thread)
+{
+    // count hardware events of worker threads in scopes of the calling thread
+    if (thread > 0) {
+        perf_counter::attach();
+    }
+    try {
+        (*task_)(thread);
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!exception_) {
+            exception_ = std::current_exception();
+        }
+    }
+}
+
+void thread_pool::luaopen(lua_State* L)
+{
+    using namespace luaponte;
+    module(L, "libhalmd")
+    [
+        namespace_("utility")
+        [
+            class_<thread_pool, std::shared_ptr<thread_pool> >("thread_pool")
+                .def(constructor<unsigned int>())
+                .property("threads", &thread_pool::size, &thread_pool::resize)
+        ]
+    ];
+}
+
+HALMD_LUA_API int luaopen_libhalmd_utility_thread_pool(lua_State* L)
+{
+    thread_pool::luaopen(L);
+    return 0;
+}
+
+} // namespace utility
+} // namespace halmd
@@ -0,0 +1,163 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_UTILITY_THREAD_POOL_HPP
+#define HALMD_UTILITY_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <lua.hpp>
+
+namespace halmd {
+namespace utility {
+
+/**
+ * Pool of worker threads for the host backend
+ *
+ * The pool executes a task on a fixed number of threads and blocks the
+ * calling thread until all threads have finished. The calling thread itself
+ * takes part in the computation as thread 0, so a pool of size 1 does not
+ * spawn any worker threads and runs all tasks serially.
+ *
+ * Work is distributed by static partitioning of index ranges, see
+ * parallel_for(). Thus, for a given number of threads, each thread processes
+ * the same subrange in every call, which allows the modules to reduce
+ * per-thread partial results in a fixed, deterministic order.
+ *
+ * Tasks issued from within a running task are executed serially by the
+ * calling thread, with the same thread indices and subranges.
+ */
+class thread_pool
+{
+public:
+    typedef std::function<void (unsigned int)> task_type;
+
+    /**
+     * Start pool with given number of threads.
+     *
+     * A value of 0 selects the number of hardware threads.
+     */
+    explicit thread_pool(unsigned int nthread = 1);
+    /** stop and join worker threads */
+    ~thread_pool();
+
+    thread_pool(thread_pool const&) = delete;
+    thread_pool& operator=(thread_pool const&) = delete;
+
+    /** returns number of threads including the calling thread */
+    unsigned int size() const
+    {
+        return nthread_;
+    }
+
+    /**
+     * Change number of threads.
+     *
+     * Must not be called from within a task.
+     */
+    void resize(unsigned int nthread);
+
+    /**
+     * Invoke task(thread) for thread = 0, …, size() - 1 and wait for
+     * completion.
+     *
+     * If one or more tasks throw an exception, the first one is rethrown
+     * after all threads have finished.
+     */
+    void run(task_type const& task);
+
+    /**
+     * Returns the subrange of [first, last) assigned to the given thread.
+     */
+    std::pair<std::size_t, std::size_t> block(std::size_t first, std::size_t last, unsigned int thread) const
+    {
+        std::size_t n = last - first;
+        return std::make_pair(first + (n * thread) / nthread_, first + (n * (thread + 1)) / nthread_);
+    }
+
+    /**
+     * Split [first, last) into size() contiguous blocks and invoke
+     * f(thread, begin, end) for each block in parallel.
+     */
+    template <typename Function>
+    void parallel_for(std::size_t first, std::size_t last, Function const& f)
+    {
+        if (nthread_ == 1 || last - first < nthread_) {
+            // not worth waking the workers
+            for (unsigned int thread = 0; thread < nthread_; ++thread) {
+                auto range = block(first, last, thread);
+                f(thread, range.first, range.second);
+            }
+            return;
+        }
+        run([&](unsigned int thread) {
+            auto range = block(first, last, thread);
+            f(thread, range.first, range.second);
+        });
+    }
+
+    /** Lua bindings */
+    static void luaopen(lua_State* L);
+
+private:
+    /** spawn worker threads 1, …, nthread_ - 1 */
+    void start_();
+    /** signal worker threads to exit and join them */
+    void stop_();
+    /** main loop of worker thread, waiting for tasks after the given generation */
+    void work_(unsigned int thread, unsigned long generation);
+    /** invoke task and store exception, if any */
+    void invoke_(unsigned int thread);
+
+    /** number of threads including the calling thread */
+    unsigned int nthread_;
+    /** worker threads */
+    std::vector<std::thread> worker_;
+    /** guards the following members */
+    std::mutex mutex_;
+    /** notifies workers of a new task or of shutdown */
+    std::condition_variable wake_;
+    /** notifies the calling thread of completion */
+    std::condition_variable done_;
+    /** current task */
+    task_type const* task_;
+    /** incremented for each new task */
+    unsigned long generation_;
+    /** number of workers that have not yet finished the current task */
+    unsigned int pending_;
+    /** flag that worker threads shall exit */
+    bool shutdown_;
+    /** flag that a task is being executed */
+    bool busy_;
+    /** first exception thrown by the current task */
+    std::exception_ptr exception_;
+};
+
+} // namespace utility
+} // namespace halmd
+
+#endif /* ! HALMD_UTILITY_THREAD_POOL_HPP */
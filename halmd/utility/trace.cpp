@@ -0,0 +1,190 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/utility/trace.hpp>
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace halmd {
+namespace utility {
+
+/**
+ * Ring buffer of events of a single thread
+ *
+ * The buffer is written by its thread only, and read by events().
+ */
+class trace::buffer
+{
+public:
+    explicit buffer(std::size_t capacity) : event_(capacity), next_(0), size_(0), depth_(0) {}
+
+    void push(event const& ev)
+    {
+        if (event_.empty()) {
+            return;
+        }
+        event_[next_] = ev;
+        if (++next_ == event_.size()) {
+            next_ = 0;
+        }
+        if (size_ < event_.size()) {
+            ++size_;
+        }
+    }
+
+    /** returns events from oldest to newest */
+    std::vector<event> events() const
+    {
+        std::vector<event> result;
+        result.reserve(size_);
+        std::size_t first = size_ < event_.size() ? 0 : next_;
+        for (std::size_t i = 0; i < size_; ++i) {
+            result.push_back(event_[(first + i) % event_.size()]);
+        }
+        return result;
+    }
+
+    void resize(std::size_t capacity)
+    {
+        event_.assign(capacity, event());
+        clear();
+    }
+
+    void clear()
+    {
+        next_ = 0;
+        size_ = 0;
+    }
+
+    /** nesting depth of traced scopes */
+    unsigned int& depth()
+    {
+        return depth_;
+    }
+
+private:
+    std::vector<event> event_;
+    /** position of next event */
+    std::size_t next_;
+    /** number of stored events */
+    std::size_t size_;
+    unsigned int depth_;
+};
+
+std::atomic<bool> trace::enabled_(false);
+
+namespace {
+
+/**
+ * Registry of ring buffers of all threads
+ *
+ * The buffers are kept beyond the lifetime of their threads.
+ */
+struct registry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<void>> buffers;
+    std::size_t capacity = 1 << 16;
+
+    static registry& get()
+    {
+        static registry instance;
+        return instance;
+    }
+};
+
+} // namespace
+
+trace::buffer& trace::local_()
+{
+    thread_local buffer* local = nullptr;
+    if (!local) {
+        registry& r = registry::get();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto buf = std::make_shared<buffer>(r.capacity);
+        r.buffers.push_back(buf);
+        local = buf.get();
+    }
+    return *local;
+}
+
+void trace::enable(bool flag)
+{
+    enabled_.store(flag, std::memory_order_relaxed);
+}
+
+std::uint64_t trace::begin()
+{
+    ++local_().depth();
+    return now();
+}
+
+void trace::end(void const* id, std::uint64_t begin)
+{
+    std::uint64_t end = now();
+    buffer& buf = local_();
+    unsigned int depth = --buf.depth();
+    buf.push(event{id, begin, end, depth});
+}
+
+std::size_t trace::capacity()
+{
+    registry& r = registry::get();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.capacity;
+}
+
+void trace::set_capacity(std::size_t capacity)
+{
+    if (enabled()) {
+        throw std::logic_error("capacity of trace buffers must not be changed while tracing is enabled");
+    }
+    registry& r = registry::get();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.capacity = capacity;
+    for (std::shared_ptr<void> const& buf : r.buffers) {
+        std::static_pointer_cast<buffer>(buf)->resize(capacity);
+    }
+}
+
+void trace::clear()
+{
+    registry& r = registry::get();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (std::shared_ptr<void> const& buf : r.buffers) {
+        std::static_pointer_cast<buffer>(buf)->clear();
+    }
+}
+
+std::vector<std::vector<trace::event>> trace::events()
+{
+    registry& r = registry::get();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::vector<std::vector<event>> result;
+    for (std::shared_ptr<void> const& buf : r.buffers) {
+        result.push_back(std::static_pointer_cast<buffer>(buf)->events());
+    }
+    return result;
+}
+
+} // namespace utility
+} // namespace halmd
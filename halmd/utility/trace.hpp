@@ -0,0 +1,115 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HALMD_UTILITY_TRACE_HPP
+#define HALMD_UTILITY_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace halmd {
+namespace utility {
+
+/**
+ * Tracing of timed scopes
+ *
+ * If tracing is enabled, each scoped_timer records an event with the begin
+ * and end times of its scope and its nesting depth in the calling thread.
+ * The event is identified by the address of the runtime accumulator of the
+ * timer. Events are stored in a ring buffer per thread, which keeps the most
+ * recent events once full.
+ *
+ * If tracing is disabled, a scoped_timer merely tests a flag.
+ *
+ * The events must be read with events() while no timed scope is executed
+ * by any other thread.
+ */
+class trace
+{
+public:
+    /** timed scope */
+    struct event
+    {
+        /** address of runtime accumulator */
+        void const* id;
+        /** begin of scope in ns */
+        std::uint64_t begin;
+        /** end of scope in ns */
+        std::uint64_t end;
+        /** number of enclosing traced scopes in the same thread */
+        unsigned int depth;
+    };
+
+    /** returns true if tracing is enabled */
+    static bool enabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /** enable or disable tracing */
+    static void enable(bool flag);
+
+    /** returns monotonic time in ns */
+    static std::uint64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    /** enter traced scope and return its begin time */
+    static std::uint64_t begin();
+
+    /** leave traced scope, and record event */
+    static void end(void const* id, std::uint64_t begin);
+
+    /** returns capacity of ring buffer per thread */
+    static std::size_t capacity();
+
+    /**
+     * set capacity of ring buffer per thread, which discards all events
+     *
+     * Tracing must be disabled.
+     */
+    static void set_capacity(std::size_t capacity);
+
+    /** discard recorded events of all threads */
+    static void clear();
+
+    /** returns recorded events per thread in order of their completion */
+    static std::vector<std::vector<event>> events();
+
+private:
+    class buffer;
+
+    /** returns ring buffer of calling thread */
+    static buffer& local_();
+
+    /** tracing flag */
+    static std::atomic<bool> enabled_;
+};
+
+} // namespace utility
+} // namespace halmd
+
+#endif /* ! HALMD_UTILITY_TRACE_HPP */
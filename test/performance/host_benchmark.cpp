@@ -0,0 +1,592 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <halmd/io/logger.hpp>
+#include <halmd/io/writers/h5md/append.hpp>
+#include <halmd/io/writers/h5md/file.hpp>
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/mdsim/host/binning.hpp>
+#include <halmd/mdsim/host/forces/pair_trunc.hpp>
+#include <halmd/mdsim/host/integrators/euler.hpp>
+#include <halmd/mdsim/host/integrators/verlet.hpp>
+#include <halmd/mdsim/host/integrators/verlet_nvt_andersen.hpp>
+#include <halmd/mdsim/host/integrators/verlet_nvt_hoover.hpp>
+#include <halmd/mdsim/host/max_displacement.hpp>
+#include <halmd/mdsim/host/neighbours/from_binning.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_groups/all.hpp>
+#include <halmd/mdsim/host/positions/lattice.hpp>
+#include <halmd/mdsim/host/potentials/pair/lennard_jones.hpp>
+#include <halmd/mdsim/host/potentials/pair/mie.hpp>
+#include <halmd/mdsim/host/potentials/pair/morse.hpp>
+#include <halmd/mdsim/host/potentials/pair/power_law.hpp>
+#include <halmd/mdsim/host/potentials/pair/truncations/shifted.hpp>
+#include <halmd/mdsim/host/sorts/hilbert.hpp>
+#include <halmd/mdsim/host/velocities/boltzmann.hpp>
+#include <halmd/numeric/accumulator.hpp>
+#include <halmd/observables/host/density_mode.hpp>
+#include <halmd/observables/host/samples/sample.hpp>
+#include <halmd/observables/utility/wavevector.hpp>
+#include <halmd/random/host/random.hpp>
+#include <halmd/utility/cache.hpp>
+#include <halmd/utility/thread_pool.hpp>
+#include <halmd/utility/timer.hpp>
+
+/**
+ * Benchmark of host modules
+ *
+ * The runtimes of the performance-critical host modules are measured for
+ * a matrix of system sizes, densities and numbers of threads. The system is
+ * a fluid at temperature 1, with particles placed on a lattice and displaced
+ * randomly, in random order in memory.
+ *
+ * The results are written in CSV or JSON format. If the CSV output of an
+ * earlier run is given as baseline, the mean runtimes are compared on the
+ * standard error stream, and the program exits with a non-zero status if a
+ * benchmark is slower than the baseline by more than the given tolerance.
+ */
+
+using namespace halmd;
+
+#ifndef USE_HOST_SINGLE_PRECISION
+typedef double float_type;
+#else
+typedef float float_type;
+#endif
+
+/**
+ * Runtime of a benchmark for one set of parameters
+ */
+struct result
+{
+    std::string benchmark;
+    unsigned int dimension;
+    unsigned int nparticle;
+    double density;
+    unsigned int nthread;
+    unsigned int repeat;
+    /** mean runtime per call in seconds */
+    double mean;
+    /** standard error of mean runtime */
+    double error;
+    /** minimum runtime */
+    double min;
+
+    typedef std::tuple<std::string, unsigned int, unsigned int, double, unsigned int> key_type;
+
+    key_type key() const
+    {
+        return key_type(benchmark, dimension, nparticle, density, nthread);
+    }
+};
+
+/**
+ * Measure runtime of repeated calls of a function, after one call for warm-up
+ */
+template <typename Function>
+static result measure(Function const& f, unsigned int repeat)
+{
+    f();
+    accumulator<double> acc;
+    double min = std::numeric_limits<double>::max();
+    for (unsigned int i = 0; i < repeat; ++i) {
+        halmd::timer t;
+        f();
+        double elapsed = t.elapsed();
+        acc(elapsed);
+        min = std::min(min, elapsed);
+    }
+    result r;
+    r.repeat = repeat;
+    r.mean = mean(acc);
+    r.error = repeat > 1 ? error_of_mean(acc) : 0;
+    r.min = min;
+    return r;
+}
+
+/**
+ * Simulation modules for a given set of parameters
+ */
+template <int dimension>
+class benchmark
+{
+public:
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::binning<dimension, float_type> binning_type;
+    typedef mdsim::host::max_displacement<dimension, float_type> displacement_type;
+    typedef mdsim::host::neighbours::from_binning<dimension, float_type> neighbour_type;
+    typedef mdsim::host::particle_groups::all<particle_type> particle_group_type;
+    typedef halmd::random::host::random random_type;
+    typedef utility::thread_pool thread_pool_type;
+    typedef typename particle_type::vector_type vector_type;
+    typedef boost::numeric::ublas::matrix<float_type> matrix_type;
+    typedef boost::numeric::ublas::matrix<unsigned int> uint_matrix_type;
+
+    /** cutoff radius of the potentials */
+    static constexpr float_type r_cut = 2.5;
+    /** neighbour list skin */
+    static constexpr float_type skin = 0.3;
+    /** integration time step */
+    static constexpr float_type timestep = 0.001;
+
+    benchmark(unsigned int nparticle, double density, unsigned int nthread, unsigned int seed);
+
+    /** run benchmarks with names matching the filter, and append results */
+    void run(std::vector<std::string> const& filter, unsigned int repeat, std::vector<result>& results);
+
+private:
+    /** run single benchmark if its name matches the filter */
+    template <typename Function>
+    void run_(std::string const& name, Function const& f);
+
+    /** benchmark force computation with given potential */
+    template <typename potential_type>
+    void run_force_(std::string const& name, std::shared_ptr<potential_type> potential);
+
+    unsigned int nparticle_;
+    double density_;
+    unsigned int nthread_;
+    std::vector<std::string> const* filter_;
+    unsigned int repeat_;
+    std::vector<result>* results_;
+
+    std::shared_ptr<thread_pool_type> thread_pool_;
+    std::shared_ptr<particle_type> particle_;
+    std::shared_ptr<box_type> box_;
+    std::shared_ptr<random_type> random_;
+    std::shared_ptr<binning_type> binning_;
+    std::shared_ptr<displacement_type> displacement_;
+    std::shared_ptr<neighbour_type> neighbour_;
+};
+
+template <int dimension>
+constexpr float_type benchmark<dimension>::r_cut;
+template <int dimension>
+constexpr float_type benchmark<dimension>::skin;
+template <int dimension>
+constexpr float_type benchmark<dimension>::timestep;
+
+template <int dimension>
+benchmark<dimension>::benchmark(unsigned int nparticle, double density, unsigned int nthread, unsigned int seed)
+  : nparticle_(nparticle)
+  , density_(density)
+  , nthread_(nthread)
+  , thread_pool_(std::make_shared<thread_pool_type>(nthread))
+  , particle_(std::make_shared<particle_type>(nparticle, 1))
+  , random_(std::make_shared<random_type>(seed))
+{
+    // cubic box of given density
+    double length = std::pow(nparticle / density, 1. / dimension);
+    typename box_type::matrix_type edges(dimension, dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+        for (unsigned int j = 0; j < dimension; ++j) {
+            edges(i, j) = (i == j) ? length : 0;
+        }
+    }
+    box_ = std::make_shared<box_type>(edges);
+
+    // place particles on a lattice and displace them randomly
+    mdsim::host::positions::lattice<dimension, float_type>(particle_, box_, vector_type(1)).set();
+    mdsim::host::velocities::boltzmann<dimension, float_type>(
+        particle_, random_, std::make_shared<mdsim::clock>(), 1
+    ).set();
+    std::mt19937 gen(seed);
+    double spacing = std::pow(1 / density, 1. / dimension);
+    std::uniform_real_distribution<double> displace(-0.1 * spacing, 0.1 * spacing);
+    {
+        auto position = make_cache_mutable(particle_->position());
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            for (unsigned int j = 0; j < dimension; ++j) {
+                (*position)[i][j] += displace(gen);
+            }
+        }
+    }
+    // store particles in random order
+    std::vector<unsigned int> index(nparticle);
+    std::iota(index.begin(), index.end(), 0);
+    std::shuffle(index.begin(), index.end(), gen);
+    particle_->rearrange(index, *thread_pool_);
+
+    matrix_type cutoff(1, 1);
+    cutoff(0, 0) = r_cut;
+    binning_ = std::make_shared<binning_type>(particle_, box_, cutoff, skin, thread_pool_);
+    displacement_ = std::make_shared<displacement_type>(particle_, box_);
+    neighbour_ = std::make_shared<neighbour_type>(
+        particle_, particle_
+      , std::make_pair(binning_, binning_)
+      , std::make_pair(displacement_, displacement_)
+      , box_, cutoff, skin, thread_pool_
+    );
+}
+
+template <int dimension>
+template <typename Function>
+void benchmark<dimension>::run_(std::string const& name, Function const& f)
+{
+    if (!filter_->empty() && std::find(filter_->begin(), filter_->end(), name) == filter_->end()) {
+        return;
+    }
+    LOG("benchmark " << name << " for " << nparticle_ << " particles at density " << density_
+        << " with " << nthread_ << " threads"
+    );
+    result r = measure(f, repeat_);
+    r.benchmark = name;
+    r.dimension = dimension;
+    r.nparticle = nparticle_;
+    r.density = density_;
+    r.nthread = nthread_;
+    results_->push_back(r);
+}
+
+template <int dimension>
+template <typename potential_type>
+void benchmark<dimension>::run_force_(std::string const& name, std::shared_ptr<potential_type> potential)
+{
+    typedef mdsim::host::forces::pair_trunc<dimension, float_type, potential_type> force_type;
+    auto force = std::make_shared<force_type>(potential, particle_, particle_, box_, neighbour_, 1, thread_pool_);
+    run_(name, [&]() { force->apply(); });
+}
+
+template <int dimension>
+void benchmark<dimension>::run(std::vector<std::string> const& filter, unsigned int repeat, std::vector<result>& results)
+{
+    filter_ = &filter;
+    repeat_ = repeat;
+    results_ = &results;
+
+    // modifying the positions invalidates the cell lists
+    run_("binning", [&]() {
+        make_cache_mutable(particle_->position());
+        read_cache(binning_->cell());
+    });
+
+    // modifying the reverse particle ids invalidates the neighbour lists only
+    run_("neighbour", [&]() {
+        make_cache_mutable(particle_->reverse_id());
+        read_cache(neighbour_->lists());
+    });
+
+    matrix_type cutoff(1, 1), epsilon(1, 1), sigma(1, 1), r_min(1, 1), distortion(1, 1);
+    uint_matrix_type index_m(1, 1), index_n(1, 1);
+    cutoff(0, 0) = r_cut;
+    epsilon(0, 0) = 1;
+    sigma(0, 0) = 1;
+    r_min(0, 0) = 1;
+    distortion(0, 0) = 0;
+    index_m(0, 0) = 12;
+    index_n(0, 0) = 6;
+
+    using namespace mdsim::host::potentials::pair;
+    run_force_("pair_trunc/lennard_jones", std::make_shared<truncations::shifted<lennard_jones<float_type>>>(
+        cutoff, epsilon, sigma
+    ));
+    run_force_("pair_trunc/mie", std::make_shared<truncations::shifted<mie<float_type>>>(
+        cutoff, epsilon, sigma, index_m, index_n
+    ));
+    run_force_("pair_trunc/morse", std::make_shared<truncations::shifted<morse<float_type>>>(
+        cutoff, epsilon, sigma, r_min, distortion
+    ));
+    run_force_("pair_trunc/power_law", std::make_shared<truncations::shifted<power_law<float_type>>>(
+        cutoff, epsilon, sigma, index_m
+    ));
+
+    // integration steps, no force module is connected to the particle
+    // instance, thus the forces remain unchanged
+    using namespace mdsim::host::integrators;
+    {
+        auto integrator = std::make_shared<euler<dimension, float_type>>(particle_, box_, timestep);
+        run_("euler", [&]() { integrator->integrate(); });
+    }
+    {
+        auto integrator = std::make_shared<verlet<dimension, float_type>>(particle_, box_, timestep);
+        run_("verlet", [&]() { integrator->integrate(); integrator->finalize(); });
+    }
+    {
+        auto clock = std::make_shared<mdsim::clock>();
+        auto integrator = std::make_shared<verlet_nvt_andersen<dimension, float_type>>(
+            particle_, box_, random_, clock, timestep, 1, 1
+        );
+        run_("verlet_nvt_andersen", [&]() { clock->advance(); integrator->integrate(); integrator->finalize(); });
+    }
+    {
+        auto integrator = std::make_shared<verlet_nvt_hoover<dimension, float_type>>(
+            particle_, box_, timestep, 1, 5
+        );
+        run_("verlet_nvt_hoover", [&]() { integrator->integrate(); integrator->finalize(); });
+    }
+
+    {
+        auto sort = std::make_shared<mdsim::host::sorts::hilbert<dimension, float_type>>(particle_, box_, binning_, thread_pool_);
+        run_("hilbert", [&]() { sort->order(); });
+    }
+
+    {
+        typedef observables::host::density_mode<dimension, float_type> density_mode_type;
+        typedef observables::utility::wavevector<dimension> wavevector_type;
+        // up to 100 wavevectors for each wavenumber q σ = 1, …, 10
+        std::vector<double> wavenumber(10);
+        std::iota(wavenumber.begin(), wavenumber.end(), 1);
+        auto wavevector = std::make_shared<wavevector_type>(
+            wavenumber, box_->length(), 0.05, 100, typename wavevector_type::filter_type(1)
+        );
+        auto group = std::make_shared<particle_group_type>(particle_);
+        auto density_mode = std::make_shared<density_mode_type>(particle_, group, wavevector, thread_pool_);
+        run_("density_mode", [&]() {
+            make_cache_mutable(particle_->position());
+            density_mode->acquire();
+        });
+    }
+
+    {
+        typedef observables::host::samples::sample<dimension, float_type> sample_type;
+        std::string filename = "halmd_benchmark_host_" + std::to_string(dimension) + "d.h5";
+        auto clock = std::make_shared<mdsim::clock>();
+        auto sample = std::make_shared<sample_type>(nparticle_);
+        auto const& position = read_cache(particle_->position());
+        std::copy(position.begin(), position.end(), sample->data().begin());
+        {
+            auto file = std::make_shared<io::writers::h5md::file>(filename, "", "", true);
+            auto writer = std::make_shared<io::writers::h5md::append>(
+                file->root(), std::vector<std::string>{"particles"}, clock
+            );
+            typename io::writers::h5md::append::subgroup_type group;
+            typedef typename sample_type::array_type array_type;
+            writer->template on_write<array_type const&>(
+                group
+              , [=]() -> array_type const& { return sample->data(); }
+              , {"all", "position"}
+            );
+            run_("h5md_append", [&]() {
+                clock->advance();
+                writer->write();
+            });
+        }
+        std::remove(filename.c_str());
+    }
+}
+
+/**
+ * Write results in CSV format
+ */
+static void write_csv(std::ostream& os, std::vector<result> const& results)
+{
+    os << "benchmark,dimension,particles,density,threads,repeat,mean,error,min\n";
+    os << std::setprecision(6);
+    for (result const& r : results) {
+        os << r.benchmark << "," << r.dimension << "," << r.nparticle << "," << r.density << ","
+           << r.nthread << "," << r.repeat << "," << r.mean << "," << r.error << "," << r.min << "\n";
+    }
+}
+
+/**
+ * Write results in JSON format
+ */
+static void write_json(std::ostream& os, std::vector<result> const& results)
+{
+    os << "{\n  \"precision\": \"" << (sizeof(float_type) == 8 ? "double" : "single") << "\",\n";
+    os << "  \"results\": [";
+    os << std::setprecision(6);
+    char const* sep = "\n";
+    for (result const& r : results) {
+        os << sep << "    {\"benchmark\": \"" << r.benchmark << "\", \"dimension\": " << r.dimension
+           << ", \"particles\": " << r.nparticle << ", \"density\": " << r.density
+           << ", \"threads\": " << r.nthread << ", \"repeat\": " << r.repeat
+           << ", \"mean\": " << r.mean << ", \"error\": " << r.error << ", \"min\": " << r.min << "}";
+        sep = ",\n";
+    }
+    os << "\n  ]\n}\n";
+}
+
+/**
+ * Read results in CSV format
+ */
+static std::vector<result> read_csv(std::string const& filename)
+{
+    std::ifstream is(filename);
+    if (!is) {
+        throw std::runtime_error("failed to open baseline file " + filename);
+    }
+    std::vector<result> results;
+    std::string line;
+    std::getline(is, line); // header
+    while (std::getline(is, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream ss(line);
+        result r;
+        if (!(ss >> r.benchmark >> r.dimension >> r.nparticle >> r.density >> r.nthread >> r.repeat >> r.mean >> r.error >> r.min)) {
+            throw std::runtime_error("malformed line in baseline file " + filename);
+        }
+        results.push_back(r);
+    }
+    return results;
+}
+
+/**
+ * Compare mean runtimes with baseline, and return number of regressions
+ */
+static unsigned int compare(std::vector<result> const& results, std::vector<result> const& baseline, double tolerance)
+{
+    std::map<result::key_type, result> base;
+    for (result const& r : baseline) {
+        base[r.key()] = r;
+    }
+    unsigned int nregression = 0;
+    std::cerr << std::left << std::setw(28) << "benchmark" << std::right
+              << std::setw(10) << "particles" << std::setw(9) << "density" << std::setw(8) << "threads"
+              << std::setw(14) << "mean [s]" << std::setw(14) << "baseline [s]" << std::setw(8) << "ratio" << "\n";
+    for (result const& r : results) {
+        auto it = base.find(r.key());
+        if (it == base.end()) {
+            continue;
+        }
+        double ratio = r.mean / it->second.mean;
+        // deviation must exceed the statistical errors
+        double error = std::sqrt(r.error * r.error + it->second.error * it->second.error);
+        bool regression = ratio > 1 + tolerance && r.mean - it->second.mean > 2 * error;
+        nregression += regression;
+        std::cerr << std::left << std::setw(28) << r.benchmark << std::right
+                  << std::setw(10) << r.nparticle << std::setw(9) << r.density << std::setw(8) << r.nthread
+                  << std::setw(14) << std::setprecision(4) << r.mean << std::setw(14) << it->second.mean
+                  << std::setw(8) << std::setprecision(3) << ratio << (regression ? "  REGRESSION" : "") << "\n";
+    }
+    return nregression;
+}
+
+int main(int argc, char** argv)
+{
+    namespace po = boost::program_options;
+
+    unsigned int dimension;
+    std::vector<unsigned int> nparticle;
+    std::vector<double> density;
+    std::vector<unsigned int> nthread;
+    std::vector<std::string> filter;
+    unsigned int repeat;
+    unsigned int seed;
+    std::string format;
+    std::string output;
+    std::string baseline;
+    double tolerance;
+
+    po::options_description desc("Benchmark of HALMD host modules");
+    desc.add_options()
+        ("help,h", "print help message")
+        ("dimension,d", po::value(&dimension)->default_value(3), "space dimension (2 or 3)")
+        ("particles,N", po::value(&nparticle)->multitoken()->default_value({4096, 32768}, "4096 32768"), "numbers of particles")
+        ("density,n", po::value(&density)->multitoken()->default_value({0.8}, "0.8"), "number densities")
+        ("threads,t", po::value(&nthread)->multitoken()->default_value({1}, "1"), "numbers of host threads, 0 selects all cores")
+        ("benchmark,b", po::value(&filter)->multitoken(), "names of benchmarks to run (default: all)")
+        ("repeat,r", po::value(&repeat)->default_value(10), "number of timed calls per benchmark")
+        ("seed", po::value(&seed)->default_value(42), "seed of random numbers")
+        ("format,f", po::value(&format)->default_value("csv"), "output format (csv or json)")
+        ("output,o", po::value(&output), "output filename (default: standard output)")
+        ("baseline", po::value(&baseline), "CSV results of an earlier run to compare with")
+        ("tolerance", po::value(&tolerance)->default_value(0.2), "tolerated relative slowdown with respect to baseline")
+        ("verbose,v", "log progress")
+    ;
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    }
+    catch (po::error const& e) {
+        std::cerr << e.what() << "\n" << desc << std::endl;
+        return 2;
+    }
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+    if ((dimension != 2 && dimension != 3) || (format != "csv" && format != "json") || repeat == 0) {
+        std::cerr << "invalid arguments\n" << desc << std::endl;
+        return 2;
+    }
+
+    logging::get().open_console(vm.count("verbose") ? logging::info : logging::warning);
+
+    std::vector<result> results;
+    for (unsigned int threads : nthread) {
+        if (threads == 0) {
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        for (double rho : density) {
+            for (unsigned int n : nparticle) {
+                if (dimension == 3) {
+                    benchmark<3>(n, rho, threads, seed).run(filter, repeat, results);
+                }
+                else {
+                    benchmark<2>(n, rho, threads, seed).run(filter, repeat, results);
+                }
+            }
+        }
+    }
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file) {
+            std::cerr << "failed to open output file " << output << std::endl;
+            return 2;
+        }
+    }
+    std::ostream& os = output.empty() ? std::cout : file;
+    if (format == "json") {
+        write_json(os, results);
+    }
+    else {
+        write_csv(os, results);
+    }
+
+    if (!baseline.empty()) {
+        unsigned int nregression = compare(results, read_csv(baseline), tolerance);
+        if (nregression > 0) {
+            std::cerr << nregression << " benchmarks are slower than the baseline" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE fft
+#include <boost/test/unit_test.hpp>
+
+#include <halmd/algorithm/host/fft.hpp>
+#include <test/tools/ctest.hpp>
+
+#include <cmath>
+#include <complex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace halmd;
+
+/**
+ * Compare with direct evaluation of the discrete Fourier transform.
+ */
+BOOST_AUTO_TEST_CASE( direct_summation )
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> uniform(-1, 1);
+
+    for (std::size_t size = 1; size <= 512; size *= 2) {
+        std::vector<std::complex<double>> x(size);
+        for (auto& value : x) {
+            value = std::complex<double>(uniform(gen), uniform(gen));
+        }
+        std::vector<std::complex<double>> y = x;
+        fft<double> transform(size);
+        BOOST_CHECK_EQUAL( transform.size(), size );
+        transform(y.data());
+
+        for (std::size_t k = 0; k < size; ++k) {
+            std::complex<double> sum = 0;
+            for (std::size_t n = 0; n < size; ++n) {
+                sum += x[n] * std::polar(1., -2 * M_PI * double((k * n) % size) / size);
+            }
+            BOOST_CHECK_SMALL( std::abs(y[k] - sum), 1e-12 * size );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( invalid_size )
+{
+    BOOST_CHECK_THROW( fft<double>(0), std::invalid_argument );
+    BOOST_CHECK_THROW( fft<double>(12), std::invalid_argument );
+}
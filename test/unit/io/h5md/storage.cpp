@@ -0,0 +1,155 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE storage
+#include <boost/test/unit_test.hpp>
+
+#include <boost/filesystem.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <halmd/io/utility/hdf5.hpp>
+#include <halmd/io/writers/h5md/storage.hpp>
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace halmd::io; // avoid ambiguity of io:: between halmd::io and boost::io
+using namespace std;
+
+typedef writers::h5md::storage storage_type;
+
+/** returns position of particle j in sample i */
+static fixed_vector<double, 3> make_position(unsigned int i, unsigned int j)
+{
+    fixed_vector<double, 3> r;
+    r[0] = std::sin(i + j);
+    r[1] = std::cos(i * j);
+    r[2] = 0.001 * j;
+    return r;
+}
+
+/**
+ * Rounding to significant bits of the mantissa
+ */
+BOOST_AUTO_TEST_CASE( truncate_precision )
+{
+    storage_type properties;
+    properties.significant_bits = 4;
+
+    // with a spacing of 1/16, 1 + 1/64 is rounded down, 1 + 7/64 is rounded up to 1 + 1/8
+    vector<fixed_vector<float, 2> > data(2);
+    data[0][0] = 1 + 1.f / 64;
+    data[0][1] = -(1 + 7.f / 64);
+    data[1][0] = 3;
+    data[1][1] = numeric_limits<float>::infinity();
+    writers::h5md::truncate_precision(data, properties);
+    BOOST_CHECK_EQUAL( data[0][0], 1.f );
+    BOOST_CHECK_EQUAL( data[0][1], -(1 + 1.f / 8) );
+    BOOST_CHECK_EQUAL( data[1][0], 3.f );
+    BOOST_CHECK( std::isinf(data[1][1]) );
+
+    // the relative error is bounded by 2^(-bits-1)
+    properties.significant_bits = 10;
+    double value = M_PI;
+    writers::h5md::truncate_precision(value, properties);
+    BOOST_CHECK( value != M_PI );
+    BOOST_CHECK_SMALL( (value - M_PI) / M_PI, std::ldexp(1., -11) );
+
+    // values near the largest finite value do not round to infinity
+    properties.significant_bits = 4;
+    vector<double> large = { numeric_limits<double>::max(), -numeric_limits<double>::max(), std::ldexp(1.9, 1023) };
+    writers::h5md::truncate_precision(large, properties);
+    BOOST_CHECK_EQUAL( large[0], numeric_limits<double>::max() );
+    BOOST_CHECK_EQUAL( large[1], -numeric_limits<double>::max() );
+    BOOST_CHECK_EQUAL( large[2], std::ldexp(1.875, 1023) );
+    float huge = -numeric_limits<float>::max();
+    writers::h5md::truncate_precision(huge, properties);
+    BOOST_CHECK_EQUAL( huge, -numeric_limits<float>::max() );
+
+    // integers are not modified
+    vector<unsigned int> species = { 1, 12345 };
+    writers::h5md::truncate_precision(species, properties);
+    BOOST_CHECK_EQUAL( species[1], 12345u );
+}
+
+/**
+ * Create compressed datasets and read them back.
+ */
+BOOST_AUTO_TEST_CASE( compressed_dataset )
+{
+    unsigned int const nsample = 5;
+    unsigned int const nparticle = 1000;
+    {
+        H5::H5File file("storage.h5", H5F_ACC_TRUNC);
+        H5::Group group = file.openGroup("/");
+
+        storage_type lossless;
+        lossless.chunk = { 4, 100 };
+        lossless.shuffle = true;
+        lossless.deflate = 6;
+
+        storage_type lossy = lossless;
+        lossy.tolerance = 1e-4;
+
+        vector<fixed_vector<double, 3> > position(nparticle);
+        H5::DataSet exact = writers::h5md::create_dataset(group, "exact", position, lossless);
+        H5::DataSet quantised = writers::h5md::create_dataset(group, "quantised", position, lossy);
+
+        // check chunk shape and filters
+        H5::DSetCreatPropList plist = exact.getCreatePlist();
+        vector<hsize_t> chunk(3);
+        BOOST_CHECK_EQUAL( plist.getChunk(3, chunk.data()), 3 );
+        BOOST_CHECK_EQUAL( chunk[0], 4u );
+        BOOST_CHECK_EQUAL( chunk[1], 100u );
+        BOOST_CHECK_EQUAL( chunk[2], 3u );
+        BOOST_CHECK_EQUAL( plist.getNfilters(), 2 );
+        BOOST_CHECK_EQUAL( quantised.getCreatePlist().getNfilters(), 3 );
+
+        for (unsigned int i = 0; i < nsample; ++i) {
+            for (unsigned int j = 0; j < nparticle; ++j) {
+                position[j] = make_position(i, j);
+            }
+            h5xx::write_chunked_dataset(exact, position);
+            h5xx::write_chunked_dataset(quantised, position);
+        }
+    }
+    {
+        H5::H5File file("storage.h5", H5F_ACC_RDONLY);
+        H5::DataSet exact = file.openDataSet("exact");
+        H5::DataSet quantised = file.openDataSet("quantised");
+        for (unsigned int i = 0; i < nsample; ++i) {
+            vector<fixed_vector<double, 3> > position, position_exact;
+            h5xx::read_chunked_dataset(exact, position_exact, i);
+            h5xx::read_chunked_dataset(quantised, position, i);
+            BOOST_REQUIRE_EQUAL( position.size(), nparticle );
+            BOOST_REQUIRE_EQUAL( position_exact.size(), nparticle );
+            for (unsigned int j = 0; j < nparticle; ++j) {
+                fixed_vector<double, 3> r = make_position(i, j);
+                for (unsigned int k = 0; k < 3; ++k) {
+                    BOOST_CHECK_EQUAL( position_exact[j][k], r[k] );
+                    BOOST_CHECK_SMALL( position[j][k] - r[k], 1e-4 );
+                }
+            }
+        }
+    }
+    boost::filesystem::remove("storage.h5");
+}
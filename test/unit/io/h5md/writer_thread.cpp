@@ -0,0 +1,117 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE writer_thread
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <halmd/io/writers/h5md/writer_thread.hpp>
+#include <test/tools/ctest.hpp>
+
+using halmd::io::writers::h5md::writer_thread;
+
+/**
+ * Tasks are executed in order of submission, and staging buffers are
+ * handed out in turn.
+ */
+BOOST_AUTO_TEST_CASE( order )
+{
+    unsigned int const ntask = 100;
+    writer_thread thread(2);
+    BOOST_CHECK_EQUAL( thread.nbuffer(), 2u );
+
+    std::vector<unsigned int> staged(thread.nbuffer());
+    std::vector<unsigned int> written;
+    for (unsigned int i = 0; i < ntask; ++i) {
+        unsigned int buffer = thread.acquire();
+        BOOST_CHECK_EQUAL( buffer, i % thread.nbuffer() );
+        staged[buffer] = i;
+        thread.submit([&, buffer]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            written.push_back(staged[buffer]);
+        });
+    }
+    thread.wait();
+
+    BOOST_REQUIRE_EQUAL( written.size(), ntask );
+    for (unsigned int i = 0; i < ntask; ++i) {
+        BOOST_CHECK_EQUAL( written[i], i );
+    }
+}
+
+/**
+ * The number of pending tasks is bounded by the number of staging buffers.
+ */
+BOOST_AUTO_TEST_CASE( backpressure )
+{
+    writer_thread thread(2);
+    std::atomic<unsigned int> pending(0);
+    unsigned int max_pending = 0;
+    for (unsigned int i = 0; i < 20; ++i) {
+        thread.acquire();
+        max_pending = std::max(max_pending, ++pending);
+        thread.submit([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            --pending;
+        });
+    }
+    thread.wait();
+    BOOST_CHECK_EQUAL( pending, 0u );
+    BOOST_CHECK( max_pending <= thread.nbuffer() );
+
+    // submission without a free buffer is an error
+    thread.acquire();
+    thread.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(10)); });
+    thread.submit([]() {});
+    BOOST_CHECK_THROW( thread.submit([]() {}), std::logic_error );
+    thread.wait();
+}
+
+/**
+ * An exception thrown by a task is rethrown in the submitting thread, and
+ * subsequent tasks are discarded.
+ */
+BOOST_AUTO_TEST_CASE( exception )
+{
+    writer_thread thread(1);
+    bool executed = false;
+    thread.acquire();
+    thread.submit([]() { throw std::runtime_error("write failed"); });
+    BOOST_CHECK_THROW( thread.wait(), std::runtime_error );
+    BOOST_CHECK_NO_THROW( thread.wait() );
+
+    thread.acquire();
+    thread.submit([]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        throw std::runtime_error("write failed");
+    });
+    BOOST_CHECK_THROW( thread.acquire(), std::runtime_error );
+    thread.submit([&]() { executed = true; });
+    thread.wait();
+    BOOST_CHECK( executed );
+
+    BOOST_CHECK_THROW( writer_thread(0), std::invalid_argument );
+}
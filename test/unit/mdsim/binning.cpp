@@ -38,6 +38,8 @@
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <cmath>
+#include <memory>
+#include <utility>
 
 #include <halmd/mdsim/host/binning.hpp>
 #include <halmd/mdsim/positions/lattice_primitive.hpp>
@@ -206,6 +208,7 @@ test_binning(binning_type& binning, particle_type const& particle, box_type cons
  * @param shape number of lattice unit cells per dimension
  * @param length lower bound for edge length of cells
  * @param scale scaling parameter for sinoidal transform
+ * @param args further arguments passed to the binning constructor
  *
  * This fixture creates a lattice of the given shape, a simulation domain
  * with edge lengths equal to the extents of the lattice with unit lattice
@@ -213,9 +216,9 @@ test_binning(binning_type& binning, particle_type const& particle, box_type cons
  * instance with given lower bound for edge length of cells, and places the
  * particle on the lattice.
  */
-template <typename binning_type>
+template <typename binning_type, typename... Args>
 static void
-test_non_uniform_density(typename binning_type::cell_size_type const& shape, float length, float scale)
+test_non_uniform_density(typename binning_type::cell_size_type const& shape, float length, float scale, Args&&... args)
 {
     typedef typename binning_type::particle_type particle_type;
     typedef typename binning_type::matrix_type matrix_type;
@@ -240,7 +243,7 @@ test_non_uniform_density(typename binning_type::cell_size_type const& shape, flo
     // create system of particles of number of lattice points
     std::shared_ptr<particle_type> particle(new particle_type(lattice.size(), 1));
     // create particle binning
-    binning_type binning(particle, box, matrix_type(1, 1, length), 0);
+    binning_type binning(particle, box, matrix_type(1, 1, length), 0, std::forward<Args>(args)...);
 
     BOOST_TEST_MESSAGE( "number density " << particle->nparticle() / box->volume() );
 
@@ -291,6 +294,19 @@ BOOST_AUTO_TEST_SUITE( host )
           , compression
         );
     }
+    BOOST_DATA_TEST_CASE( three_threads, dataset, unit, compression ) {
+#ifdef USE_HOST_SINGLE_PRECISION
+        typedef halmd::mdsim::host::binning<3, float> binning_type;
+#else
+        typedef halmd::mdsim::host::binning<3, double> binning_type;
+#endif
+        test_non_uniform_density<binning_type>(
+            {2 * unit, 5 * unit, 3 * unit} // non-cubic box with coprime edge lengths
+          , cell_length
+          , compression
+          , std::make_shared<halmd::utility::thread_pool>(4)
+        );
+    }
 BOOST_AUTO_TEST_SUITE_END()
 
 #ifdef HALMD_WITH_GPU
@@ -0,0 +1,252 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE pair_trunc
+#include <boost/test/unit_test.hpp>
+
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/host/binning.hpp>
+#include <halmd/mdsim/host/forces/pair_trunc.hpp>
+#include <halmd/mdsim/host/max_displacement.hpp>
+#include <halmd/mdsim/host/neighbours/from_binning.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/positions/lattice.hpp>
+#include <halmd/mdsim/host/potentials/pair/lennard_jones.hpp>
+#include <halmd/mdsim/host/potentials/pair/truncations/shifted.hpp>
+#include <halmd/mdsim/host/sorts/hilbert.hpp>
+#include <halmd/utility/thread_pool.hpp>
+#include <test/tools/ctest.hpp>
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace halmd;
+
+#ifndef USE_HOST_SINGLE_PRECISION
+typedef double float_type;
+#else
+typedef float float_type;
+#endif
+
+/**
+ * Lennard-Jones fluid in a cubic box, with particles on a lattice that are
+ * displaced randomly
+ *
+ * The particles are either in random order in memory, or sorted along a
+ * Hilbert curve before each neighbour list update, which yields index
+ * windows of the threads that span the whole system or barely more than the
+ * blocks of the threads, respectively.
+ */
+template <int dimension>
+struct lennard_jones_fluid
+{
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::binning<dimension, float_type> binning_type;
+    typedef mdsim::host::max_displacement<dimension, float_type> displacement_type;
+    typedef mdsim::host::neighbours::from_binning<dimension, float_type> neighbour_type;
+    typedef mdsim::host::sorts::hilbert<dimension, float_type> sort_type;
+    typedef mdsim::host::potentials::pair::truncations::shifted<
+        mdsim::host::potentials::pair::lennard_jones<float_type>
+    > potential_type;
+    typedef mdsim::host::forces::pair_trunc<dimension, float_type, potential_type> force_type;
+    typedef utility::thread_pool thread_pool_type;
+    typedef typename particle_type::vector_type vector_type;
+    typedef typename particle_type::force_type force_value_type;
+    typedef typename particle_type::en_pot_type en_pot_type;
+    typedef typename particle_type::stress_pot_type stress_pot_type;
+    typedef boost::numeric::ublas::matrix<float_type> matrix_type;
+
+    static unsigned int const nparticle = 4000;
+
+    std::shared_ptr<particle_type> particle;
+    std::shared_ptr<force_type> force;
+    std::shared_ptr<sort_type> sort;
+
+    lennard_jones_fluid(unsigned int nthread, bool sorted);
+
+    /** displace particles randomly by at most the given distance */
+    void displace(float_type distance, unsigned int seed);
+    /** returns forces and auxiliary variables */
+    void get(std::vector<force_value_type>& f, std::vector<en_pot_type>& en_pot, std::vector<stress_pot_type>& stress_pot);
+};
+
+template <int dimension>
+lennard_jones_fluid<dimension>::lennard_jones_fluid(unsigned int nthread, bool sorted)
+{
+    float_type const r_cut = 2.5;
+    float_type const skin = 0.5;
+    double const density = 0.8;
+
+    auto thread_pool = std::make_shared<thread_pool_type>(nthread);
+    particle = std::make_shared<particle_type>(nparticle, 1);
+
+    double length = std::pow(nparticle / density, 1. / dimension);
+    typename box_type::matrix_type edges(dimension, dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+        for (unsigned int j = 0; j < dimension; ++j) {
+            edges(i, j) = (i == j) ? length : 0;
+        }
+    }
+    auto box = std::make_shared<box_type>(edges);
+
+    mdsim::host::positions::lattice<dimension, float_type>(particle, box, vector_type(1)).set();
+    displace(0.1, 42);
+
+    // store particles in random order
+    std::vector<unsigned int> index(nparticle);
+    std::iota(index.begin(), index.end(), 0);
+    std::shuffle(index.begin(), index.end(), std::mt19937(42));
+    particle->rearrange(index);
+
+    matrix_type cutoff(1, 1), epsilon(1, 1), sigma(1, 1);
+    cutoff(0, 0) = r_cut;
+    epsilon(0, 0) = 1;
+    sigma(0, 0) = 1;
+    auto potential = std::make_shared<potential_type>(cutoff, epsilon, sigma);
+
+    auto binning = std::make_shared<binning_type>(particle, box, cutoff, skin, thread_pool);
+    auto displacement = std::make_shared<displacement_type>(particle, box);
+    auto neighbour = std::make_shared<neighbour_type>(
+        particle, particle
+      , std::make_pair(binning, binning)
+      , std::make_pair(displacement, displacement)
+      , box, cutoff, skin, thread_pool
+    );
+    if (sorted) {
+        sort = std::make_shared<sort_type>(particle, box, binning, thread_pool);
+        std::shared_ptr<sort_type> sort_ = sort;
+        neighbour->on_prepend_update([=]() { sort_->order(); });
+    }
+
+    force = std::make_shared<force_type>(potential, particle, particle, box, neighbour, 1, thread_pool);
+    std::shared_ptr<force_type> force_ = force;
+    particle->on_prepend_force([=]() { force_->check_cache(); });
+    particle->on_force([=]() { force_->apply(); });
+}
+
+template <int dimension>
+void lennard_jones_fluid<dimension>::displace(float_type distance, unsigned int seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float_type> uniform(-distance, distance);
+    auto position = make_cache_mutable(particle->position());
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        for (unsigned int j = 0; j < dimension; ++j) {
+            (*position)[i][j] += uniform(gen);
+        }
+    }
+}
+
+template <int dimension>
+void lennard_jones_fluid<dimension>::get(
+    std::vector<force_value_type>& f
+  , std::vector<en_pot_type>& en_pot
+  , std::vector<stress_pot_type>& stress_pot
+)
+{
+    f.resize(nparticle);
+    en_pot.resize(nparticle);
+    stress_pot.resize(nparticle);
+    // request the auxiliary variables with the force
+    particle->aux_enable();
+    get_force(*particle, f.begin());
+    get_potential_energy(*particle, en_pot.begin());
+    get_stress_pot(*particle, stress_pot.begin());
+}
+
+/**
+ * Compare forces, potential energies and potential part of the stress tensor
+ * computed with several threads to the results of a single thread.
+ *
+ * After the first evaluation, the particles are displaced by less than half
+ * of the skin, so that the second evaluation reuses the neighbour lists and
+ * the index windows of the threads.
+ */
+template <int dimension>
+static void test_threads(bool sorted)
+{
+    typedef lennard_jones_fluid<dimension> fluid_type;
+    typedef typename fluid_type::force_value_type force_value_type;
+    typedef typename fluid_type::en_pot_type en_pot_type;
+    typedef typename fluid_type::stress_pot_type stress_pot_type;
+
+    float_type const tolerance = 100 * std::numeric_limits<float_type>::epsilon();
+
+    fluid_type reference(1, sorted);
+    std::vector<force_value_type> f_ref[2];
+    std::vector<en_pot_type> en_pot_ref[2];
+    std::vector<stress_pot_type> stress_pot_ref[2];
+    reference.get(f_ref[0], en_pot_ref[0], stress_pot_ref[0]);
+    reference.displace(0.05, 1);
+    reference.get(f_ref[1], en_pot_ref[1], stress_pot_ref[1]);
+
+    for (unsigned int nthread : {2, 3, 4}) {
+        BOOST_TEST_MESSAGE("compare " << nthread << " threads to serial result");
+        fluid_type fluid(nthread, sorted);
+        for (unsigned int k = 0; k < 2; ++k) {
+            if (k > 0) {
+                fluid.displace(0.05, 1);
+            }
+            std::vector<force_value_type> f;
+            std::vector<en_pot_type> en_pot;
+            std::vector<stress_pot_type> stress_pot;
+            fluid.get(f, en_pot, stress_pot);
+
+            // the particles are ordered identically for any number of threads
+            for (unsigned int i = 0; i < fluid_type::nparticle; ++i) {
+                float_type scale = std::max(norm_inf(f_ref[k][i]), float_type(1));
+                BOOST_CHECK_SMALL( norm_inf(f[i] - f_ref[k][i]) / scale, tolerance );
+                BOOST_CHECK_SMALL( (en_pot[i] - en_pot_ref[k][i]) / std::max(std::abs(en_pot_ref[k][i]), en_pot_type(1)), tolerance );
+                scale = std::max(norm_inf(stress_pot_ref[k][i]), float_type(1));
+                BOOST_CHECK_SMALL( norm_inf(stress_pot[i] - stress_pot_ref[k][i]) / scale, tolerance );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( threads_random_order_2d )
+{
+    test_threads<2>(false);
+}
+
+BOOST_AUTO_TEST_CASE( threads_random_order_3d )
+{
+    test_threads<3>(false);
+}
+
+BOOST_AUTO_TEST_CASE( threads_hilbert_order_2d )
+{
+    test_threads<2>(true);
+}
+
+BOOST_AUTO_TEST_CASE( threads_hilbert_order_3d )
+{
+    test_threads<3>(true);
+}
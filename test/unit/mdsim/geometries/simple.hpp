@@ -41,6 +41,16 @@ public:
     simple_geometry(vector_type lowest_corner) : lowest_corner_(lowest_corner) {}
 
     void log(std::shared_ptr<halmd::logger> logger_ = std::make_shared<halmd::logger>()) const {}
+
+    bool contains(vector_type const& lower, vector_type const& upper) const
+    {
+        return (*this)(upper);
+    }
+
+    bool overlaps(vector_type const& lower, vector_type const& upper) const
+    {
+        return (*this)(lower);
+    }
 #endif
     HALMD_GPU_ENABLED bool operator()(vector_type const& r) const
     {
@@ -30,6 +30,7 @@
 #include <numeric>
 
 #include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
 #include <halmd/mdsim/host/integrators/euler.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/particle_groups/all.hpp>
@@ -234,7 +235,7 @@ test_euler<modules_type>::test_euler()
     integrator = std::make_shared<integrator_type>(particle, box, timestep);
     random = std::make_shared<random_type>();
     position = std::make_shared<position_type>(particle, box, slab);
-    velocity = std::make_shared<velocity_type>(particle, random, temp);
+    velocity = modules_type::make_velocity(particle, random, std::make_shared<mdsim::clock>(), temp);
     std::shared_ptr<particle_group_type> particle_group = std::make_shared<particle_group_type>(particle);
     phase_space = std::make_shared<phase_space_type>(particle, particle_group, box);
 
@@ -268,6 +269,16 @@ struct host_modules
 
     static bool const gpu = false;
 
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const> clock
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, clock, temperature);
+    }
+
     static void set_velocity(std::shared_ptr<particle_type> particle);
 };
 
@@ -338,6 +349,17 @@ struct gpu_modules
 
     static bool const gpu = true;
 
+    /** the GPU generator does not key its streams by the simulation step */
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const>
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, temperature);
+    }
+
     typedef dsfloat_aware_numeric_limits<float_type> numeric_limits;
 
     static void set_velocity(std::shared_ptr<particle_type> particle);
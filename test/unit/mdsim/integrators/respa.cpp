@@ -0,0 +1,279 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE respa
+#include <boost/test/unit_test.hpp>
+
+#include <boost/numeric/ublas/banded.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/mdsim/host/forces/pair_full.hpp>
+#include <halmd/mdsim/host/integrators/respa.hpp>
+#include <halmd/mdsim/host/integrators/verlet.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_groups/all.hpp>
+#include <halmd/mdsim/host/positions/lattice.hpp>
+#include <halmd/mdsim/host/velocities/boltzmann.hpp>
+#include <halmd/observables/host/thermodynamics.hpp>
+#include <halmd/random/host/random.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+
+/**
+ * Gaussian core potential U(r) = ε exp(-r² / 2σ²), which is smooth and
+ * negligible at half the box length.
+ */
+template <typename float_type>
+class gaussian
+{
+public:
+    gaussian(float_type epsilon, float_type sigma)
+      : epsilon_(epsilon), rri_sigma_(1 / (sigma * sigma)) {}
+
+    std::tuple<float_type, float_type> operator()(float_type rr, unsigned, unsigned) const
+    {
+        float_type en_pot = epsilon_ * std::exp(-rr * rri_sigma_ / 2);
+        float_type fval = en_pot * rri_sigma_;
+        return std::make_tuple(fval, en_pot);
+    }
+
+    unsigned int size1() const
+    {
+        return 1;
+    }
+
+    unsigned int size2() const
+    {
+        return 1;
+    }
+
+private:
+    float_type epsilon_;
+    float_type rri_sigma_;
+};
+
+/**
+ * system of particles interacting with a stiff, short-ranged and a soft,
+ * longer-ranged Gaussian core potential
+ */
+template <int dimension, typename float_type>
+struct gaussian_core
+{
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::host::particle_groups::all<particle_type> particle_group_type;
+    typedef gaussian<float_type> potential_type;
+    typedef mdsim::host::forces::pair_full<dimension, float_type, potential_type> force_type;
+    typedef mdsim::host::integrators::respa<dimension, float_type> respa_type;
+    typedef mdsim::host::integrators::verlet<dimension, float_type> verlet_type;
+    typedef mdsim::host::positions::lattice<dimension, float_type> position_type;
+    typedef halmd::random::host::random random_type;
+    typedef mdsim::host::velocities::boltzmann<dimension, float_type> velocity_type;
+    typedef observables::host::thermodynamics<dimension, float_type> thermodynamics_type;
+    typedef typename particle_type::vector_type vector_type;
+
+    static unsigned int const npart = (dimension == 3) ? 125 : 100;
+    static constexpr double density = 0.2;
+
+    std::shared_ptr<particle_type> particle;
+    std::shared_ptr<box_type> box;
+    std::shared_ptr<force_type> fast;
+    std::shared_ptr<force_type> slow;
+    std::shared_ptr<thermodynamics_type> thermodynamics;
+
+    gaussian_core()
+    {
+        double edge_length = std::pow(npart / density, 1. / dimension);
+        boost::numeric::ublas::diagonal_matrix<typename box_type::matrix_type::value_type> edges(dimension);
+        for (unsigned int i = 0; i < dimension; ++i) {
+            edges(i, i) = edge_length;
+        }
+        particle = std::make_shared<particle_type>(npart, 1);
+        box = std::make_shared<box_type>(edges);
+        fast = std::make_shared<force_type>(std::make_shared<potential_type>(10, 0.4), particle, particle, box);
+        slow = std::make_shared<force_type>(std::make_shared<potential_type>(1, 0.8), particle, particle, box);
+        thermodynamics = std::make_shared<thermodynamics_type>(particle, std::make_shared<particle_group_type>(particle), box);
+
+        position_type(particle, box, vector_type(1)).set();
+        velocity_type(particle, std::make_shared<random_type>(), std::make_shared<mdsim::clock>(), 1).set();
+
+        particle->on_prepend_force([=]() { fast->check_cache(); });
+        particle->on_force([=]() { fast->apply(); });
+    }
+
+    /** connect slow force to particle as well */
+    void connect_slow()
+    {
+        particle->on_prepend_force([=]() { slow->check_cache(); });
+        particle->on_force([=]() { slow->apply(); });
+    }
+
+    /** construct r-RESPA integrator with the slow force as second level */
+    std::shared_ptr<respa_type> make_respa(double timestep, unsigned int substep)
+    {
+        auto integrator = std::make_shared<respa_type>(particle, box, timestep, std::vector<unsigned int>{substep});
+        integrator->on_force(1, [=]() { slow->apply(); });
+        particle->on_force([=]() { integrator->apply(); });
+        return integrator;
+    }
+
+    /** copy phase space state of other system */
+    void assign(gaussian_core const& other)
+    {
+        auto const& position = read_cache(other.particle->position());
+        auto const& velocity = read_cache(other.particle->velocity());
+        std::copy(position.begin(), position.end(), make_cache_mutable(particle->position())->begin());
+        std::copy(velocity.begin(), velocity.end(), make_cache_mutable(particle->velocity())->begin());
+    }
+
+    /** returns maximum deviation of positions and velocities from other system */
+    double deviation(gaussian_core const& other) const
+    {
+        auto const& position1 = read_cache(particle->position());
+        auto const& position2 = read_cache(other.particle->position());
+        auto const& velocity1 = read_cache(particle->velocity());
+        auto const& velocity2 = read_cache(other.particle->velocity());
+        double result = 0;
+        for (unsigned int i = 0; i < npart; ++i) {
+            result = std::max(result, double(norm_inf(position1[i] - position2[i])));
+            result = std::max(result, double(norm_inf(velocity1[i] - velocity2[i])));
+        }
+        return result;
+    }
+};
+
+template <int dimension, typename float_type>
+constexpr double gaussian_core<dimension, float_type>::density;
+
+/**
+ * For a single substep, r-RESPA reduces to velocity-Verlet with the sum of
+ * both forces.
+ */
+template <int dimension, typename float_type>
+void test_verlet()
+{
+    typedef gaussian_core<dimension, float_type> system_type;
+    double const timestep = 0.01;
+    unsigned int const steps = 200;
+
+    system_type verlet_system;
+    verlet_system.connect_slow();
+    auto verlet = std::make_shared<typename system_type::verlet_type>(verlet_system.particle, verlet_system.box, timestep);
+
+    system_type respa_system;
+    respa_system.assign(verlet_system);
+    auto respa = respa_system.make_respa(timestep, 1);
+    BOOST_CHECK_EQUAL(respa->levels(), 2u);
+
+    for (unsigned int i = 0; i < steps; ++i) {
+        verlet->integrate();
+        verlet->finalize();
+        respa->integrate();
+        respa->finalize();
+    }
+    BOOST_CHECK_SMALL(respa_system.deviation(verlet_system), 1e3 * std::numeric_limits<float_type>::epsilon());
+}
+
+/**
+ * Conservation of total energy, which includes the potential energy of the
+ * slow force level.
+ */
+template <int dimension, typename float_type>
+void test_energy()
+{
+    typedef gaussian_core<dimension, float_type> system_type;
+    double const timestep = 0.02;
+    unsigned int const substep = 4;
+    unsigned int const steps = 1000;
+    unsigned int const period = 10;
+
+    system_type system;
+    auto respa = system.make_respa(timestep, substep);
+    BOOST_CHECK_CLOSE_FRACTION(respa->timestep(0), timestep / substep, 1e-12);
+    BOOST_CHECK_CLOSE_FRACTION(respa->timestep(1), timestep, 1e-12);
+
+    // potential energy of both levels
+    system_type reference;
+    reference.assign(system);
+    reference.connect_slow();
+    double en_pot = reference.thermodynamics->en_pot();
+    BOOST_CHECK_CLOSE_FRACTION(system.thermodynamics->en_pot(), en_pot, 1e3 * std::numeric_limits<float_type>::epsilon());
+
+    double en_tot = system.thermodynamics->en_tot();
+
+    // the slow force is computed once per step, also if the auxiliary
+    // variables are requested, which are computed at the end of the step
+    unsigned int nslow = 0;
+    respa->on_force(1, [&]() { ++nslow; });
+
+    double max_en_diff = 0;
+    for (unsigned int i = 0; i < steps; ++i) {
+        // request auxiliary variables before the step as the sampler does
+        if (i % period == 0) {
+            system.particle->aux_enable();
+        }
+        respa->integrate();
+        respa->finalize();
+        if (i % period == 0) {
+            max_en_diff = std::max(max_en_diff, std::abs(system.thermodynamics->en_tot() - en_tot));
+        }
+    }
+    BOOST_TEST_MESSAGE("maximum deviation of total energy: " << max_en_diff);
+    BOOST_CHECK_SMALL(max_en_diff / std::abs(en_tot), 1e-4);
+    BOOST_CHECK_EQUAL(nslow, steps);
+}
+
+#ifndef USE_HOST_SINGLE_PRECISION
+BOOST_AUTO_TEST_CASE( verlet_host_2d ) {
+    test_verlet<2, double>();
+}
+BOOST_AUTO_TEST_CASE( verlet_host_3d ) {
+    test_verlet<3, double>();
+}
+BOOST_AUTO_TEST_CASE( energy_host_2d ) {
+    test_energy<2, double>();
+}
+BOOST_AUTO_TEST_CASE( energy_host_3d ) {
+    test_energy<3, double>();
+}
+#else
+BOOST_AUTO_TEST_CASE( verlet_host_2d ) {
+    test_verlet<2, float>();
+}
+BOOST_AUTO_TEST_CASE( verlet_host_3d ) {
+    test_verlet<3, float>();
+}
+BOOST_AUTO_TEST_CASE( energy_host_2d ) {
+    test_energy<2, float>();
+}
+BOOST_AUTO_TEST_CASE( energy_host_3d ) {
+    test_energy<3, float>();
+}
+#endif
@@ -30,6 +30,8 @@
 #include <numeric>
 
 #include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/mdsim/core.hpp>
 #include <halmd/mdsim/host/integrators/verlet.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/particle_groups/all.hpp>
@@ -164,7 +166,7 @@ ideal_gas<modules_type>::ideal_gas()
     box = std::make_shared<box_type>(edges);
     random = std::make_shared<random_type>();
     position = std::make_shared<position_type>(particle, box, slab);
-    velocity = std::make_shared<velocity_type>(particle, random, temp);
+    velocity = modules_type::make_velocity(particle, random, std::make_shared<mdsim::clock>(), temp);
     integrator = std::make_shared<integrator_type>(particle, box, timestep);
     std::shared_ptr<particle_group_type> group = std::make_shared<particle_group_type>(particle);
     thermodynamics = std::make_shared<thermodynamics_type>(particle, group, box);
@@ -267,9 +269,138 @@ struct host_modules
     typedef mdsim::host::velocities::boltzmann<dimension, float_type> velocity_type;
     typedef observables::host::thermodynamics<dimension, float_type> thermodynamics_type;
     static bool const gpu = false;
+
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const> clock
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, clock, temperature);
+    }
     typedef host_tolerance<float_type> tolerance;
 };
 
+/** Verlet integrator with a smooth, position-dependent mock force */
+
+template <typename modules_type>
+struct periodic_force
+{
+    typedef typename modules_type::box_type box_type;
+    typedef typename modules_type::integrator_type integrator_type;
+    typedef typename modules_type::particle_type particle_type;
+    typedef typename particle_type::vector_type vector_type;
+    static unsigned int const dimension = vector_type::static_size;
+
+    std::shared_ptr<particle_type> particle;
+    std::shared_ptr<box_type> box;
+    std::shared_ptr<integrator_type> integrator;
+    cache<> position_cache;
+
+    periodic_force(unsigned int npart, double length, double timestep);
+};
+
+template <typename modules_type>
+periodic_force<modules_type>::periodic_force(unsigned int npart, double length, double timestep)
+{
+    boost::numeric::ublas::diagonal_matrix<typename box_type::matrix_type::value_type> edges(dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+        edges(i, i) = length;
+    }
+    particle = std::make_shared<particle_type>(npart, 1);
+    box = std::make_shared<box_type>(edges);
+    integrator = std::make_shared<integrator_type>(particle, box, timestep);
+
+    // restoring force towards the lattice planes at the box faces
+    particle->on_prepend_force([this]() {
+        if (position_cache != particle->position()) {
+            particle->mark_force_dirty();
+            particle->mark_aux_dirty();
+        }
+    });
+    particle->on_force([this, length]() {
+        auto const& position = read_cache(particle->position());
+        auto force = make_cache_mutable(particle->mutable_force());
+        double const k = 2 * M_PI / length;
+        for (unsigned int i = 0; i < particle->nparticle(); ++i) {
+            for (unsigned int j = 0; j < dimension; ++j) {
+                (*force)[i][j] = -100 * std::sin(k * position[i][j]) / k;
+            }
+        }
+        position_cache = particle->position();
+    });
+}
+
+/**
+ * test fused mode: deferring the second half-step within batches of steps of
+ * the core must reproduce the trajectory of the plain integrator
+ */
+template <typename modules_type>
+void test_fused()
+{
+    typedef periodic_force<modules_type> system_type;
+    typedef typename modules_type::position_type position_type;
+    typedef typename modules_type::random_type random_type;
+    typedef typename modules_type::velocity_type velocity_type;
+    typedef typename system_type::vector_type vector_type;
+
+    unsigned int constexpr steps = 200;
+    unsigned int constexpr batch = 10;
+    unsigned int const npart = 1000;
+    double const length = 10;
+    double const timestep = 0.001;
+    // rounding errors scale with the magnitude of the coordinates
+    double const tolerance = 100 * modules_type::tolerance::value * length;
+
+    system_type plain(npart, length, timestep);
+    system_type fused(npart, length, timestep);
+
+    BOOST_TEST_MESSAGE("prepare identical systems");
+    {
+        auto random = std::make_shared<random_type>();
+        std::make_shared<position_type>(plain.particle, plain.box, vector_type(1))->set();
+        modules_type::make_velocity(plain.particle, random, std::make_shared<mdsim::clock>(), 1)->set();
+        std::make_shared<position_type>(fused.particle, fused.box, vector_type(1))->set();
+        auto const& velocity = read_cache(plain.particle->velocity());
+        auto fused_velocity = make_cache_mutable(fused.particle->velocity());
+        std::copy(velocity.begin(), velocity.end(), fused_velocity->begin());
+    }
+
+    // the fused integrator is driven by the core, which reports the
+    // remaining steps of each batch
+    auto core = std::make_shared<mdsim::core>();
+    unsigned int ndefer = 0;
+    core->on_integrate([&]() { fused.integrator->integrate(); });
+    core->on_finalize([&]() {
+        ndefer += core->remaining_steps() > 0;
+        fused.integrator->fused_finalize(*core);
+    });
+
+    BOOST_TEST_MESSAGE("run " << steps << " steps in batches of " << batch << " steps");
+    for (unsigned int i = 0; i < steps; i += batch) {
+        for (unsigned int j = 0; j < batch; ++j) {
+            plain.integrator->integrate();
+            plain.integrator->finalize();
+        }
+        core->mdstep(batch, []() {});
+        BOOST_CHECK_EQUAL( core->remaining_steps(), 0u );
+
+        // compare at the end of each batch
+        auto const& position = read_cache(plain.particle->position());
+        auto const& fused_position = read_cache(fused.particle->position());
+        auto const& velocity = read_cache(plain.particle->velocity());
+        auto const& fused_velocity = read_cache(fused.particle->velocity());
+        double max_diff = 0;
+        for (unsigned int j = 0; j < npart; ++j) {
+            max_diff = max(max_diff, double(norm_inf(position[j] - fused_position[j])));
+            max_diff = max(max_diff, double(norm_inf(velocity[j] - fused_velocity[j])));
+        }
+        BOOST_CHECK_SMALL( max_diff, tolerance );
+    }
+    BOOST_CHECK_EQUAL( ndefer, steps - steps / batch );
+}
+
 #ifndef USE_HOST_SINGLE_PRECISION
 BOOST_AUTO_TEST_CASE( ideal_gas_host_2d ) {
     ideal_gas<host_modules<2, double> >().test();
@@ -277,6 +408,12 @@ BOOST_AUTO_TEST_CASE( ideal_gas_host_2d ) {
 BOOST_AUTO_TEST_CASE( ideal_gas_host_3d ) {
     ideal_gas<host_modules<3, double> >().test();
 }
+BOOST_AUTO_TEST_CASE( fused_host_2d ) {
+    test_fused<host_modules<2, double> >();
+}
+BOOST_AUTO_TEST_CASE( fused_host_3d ) {
+    test_fused<host_modules<3, double> >();
+}
 #else
 BOOST_AUTO_TEST_CASE( ideal_gas_host_2d ) {
     ideal_gas<host_modules<2, float> >().test();
@@ -284,6 +421,12 @@ BOOST_AUTO_TEST_CASE( ideal_gas_host_2d ) {
 BOOST_AUTO_TEST_CASE( ideal_gas_host_3d ) {
     ideal_gas<host_modules<3, float> >().test();
 }
+BOOST_AUTO_TEST_CASE( fused_host_2d ) {
+    test_fused<host_modules<2, float> >();
+}
+BOOST_AUTO_TEST_CASE( fused_host_3d ) {
+    test_fused<host_modules<3, float> >();
+}
 #endif
 
 #ifdef HALMD_WITH_GPU
@@ -313,6 +456,17 @@ struct gpu_modules
     typedef mdsim::gpu::velocities::boltzmann<dimension, float_type, halmd::random::gpu::rand48> velocity_type;
     typedef gpu_tolerance<float_type> tolerance;
     static bool const gpu = true;
+
+    /** the GPU generator does not key its streams by the simulation step */
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const>
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, temperature);
+    }
 };
 
 # ifdef USE_GPU_SINGLE_PRECISION
@@ -30,6 +30,7 @@
 #include <numeric>
 
 #include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
 #include <halmd/mdsim/host/integrators/verlet_nvt_andersen.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/particle_groups/all.hpp>
@@ -62,6 +63,7 @@ template <typename modules_type>
 struct verlet_nvt_andersen
 {
     typedef typename modules_type::box_type box_type;
+    typedef mdsim::clock clock_type;
     typedef typename modules_type::integrator_type integrator_type;
     typedef typename modules_type::particle_type particle_type;
     typedef typename modules_type::particle_group_type particle_group_type;
@@ -84,6 +86,7 @@ struct verlet_nvt_andersen
     typename modules_type::slab_type slab;
 
     std::shared_ptr<box_type> box;
+    std::shared_ptr<clock_type> clock;
     std::shared_ptr<integrator_type> integrator;
     std::shared_ptr<particle_type> particle;
     std::shared_ptr<position_type> position;
@@ -112,6 +115,7 @@ void verlet_nvt_andersen<modules_type>::test()
 
     BOOST_TEST_MESSAGE("run NVT integrator over " << steps << " steps");
     for (unsigned int i = 0; i < steps; ++i) {
+        clock->advance();
         integrator->integrate();
         integrator->finalize();
         if (i % period == 0) {
@@ -199,10 +203,12 @@ verlet_nvt_andersen<modules_type>::verlet_nvt_andersen()
     // create modules
     particle = std::make_shared<particle_type>(npart, 1);
     box = std::make_shared<box_type>(edges);
+    clock = std::make_shared<clock_type>();
+    clock->set_timestep(timestep);
     random = std::make_shared<random_type>();
     position = std::make_shared<position_type>(particle, box, slab);
-    velocity = std::make_shared<velocity_type>(particle, random, temp);
-    integrator = std::make_shared<integrator_type>(particle, box, random, timestep, temp, coll_rate);
+    velocity = modules_type::make_velocity(particle, random, clock, temp);
+    integrator = modules_type::make_integrator(particle, box, random, clock, timestep, temp, coll_rate);
     std::shared_ptr<particle_group_type> group = std::make_shared<particle_group_type>(particle);
     thermodynamics = std::make_shared<thermodynamics_type>(particle, group, box);
 }
@@ -298,6 +304,29 @@ struct host_modules
     typedef mdsim::host::velocities::boltzmann<dimension, float_type> velocity_type;
     typedef observables::host::thermodynamics<dimension, float_type> thermodynamics_type;
     static bool const gpu = false;
+
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const> clock
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, clock, temperature);
+    }
+
+    static std::shared_ptr<integrator_type> make_integrator(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<box_type const> box
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const> clock
+      , double timestep
+      , double temperature
+      , double coll_rate
+    )
+    {
+        return std::make_shared<integrator_type>(particle, box, random, clock, timestep, temperature, coll_rate);
+    }
 };
 
 #ifndef USE_HOST_SINGLE_PRECISION
@@ -331,6 +360,30 @@ struct gpu_modules
     typedef observables::gpu::thermodynamics<dimension, float_type> thermodynamics_type;
     typedef mdsim::gpu::velocities::boltzmann<dimension, float_type, halmd::random::gpu::rand48> velocity_type;
     static bool const gpu = true;
+
+    /** the GPU generator does not key its streams by the simulation step */
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const>
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, temperature);
+    }
+
+    static std::shared_ptr<integrator_type> make_integrator(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<box_type const> box
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const>
+      , double timestep
+      , double temperature
+      , double coll_rate
+    )
+    {
+        return std::make_shared<integrator_type>(particle, box, random, timestep, temperature, coll_rate);
+    }
 };
 
 # ifdef USE_GPU_SINGLE_PRECISION
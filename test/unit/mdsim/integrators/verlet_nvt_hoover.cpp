@@ -31,6 +31,7 @@
 #include <iomanip>
 
 #include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
 #include <halmd/mdsim/host/forces/pair_trunc.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/particle_groups/all.hpp>
@@ -306,7 +307,7 @@ verlet_nvt_hoover<modules_type>::verlet_nvt_hoover()
     particle->on_force([=](){force->apply();});
     integrator = std::make_shared<integrator_type>(particle, box, timestep, temp, resonance_frequency);
     position = std::make_shared<position_type>(particle, box, 1);
-    velocity = std::make_shared<velocity_type>(particle, random, start_temp);
+    velocity = modules_type::make_velocity(particle, random, std::make_shared<mdsim::clock>(), start_temp);
     std::shared_ptr<particle_group_type> group = std::make_shared<particle_group_type>(particle);
     thermodynamics = std::make_shared<thermodynamics_type>(particle, group, box);
 }
@@ -353,10 +354,77 @@ struct host_modules
     typedef mdsim::host::velocities::boltzmann<dimension, float_type> velocity_type;
     typedef observables::host::thermodynamics<dimension, float_type> thermodynamics_type;
     static bool const gpu = false;
+
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const> clock
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, clock, temperature);
+    }
     typedef host_tolerance<float_type> tolerance;
     typedef host_en_tolerance<float_type> en_tolerance;
 };
 
+/**
+ * test fused mode: deferring the second half-step to the next integration
+ * step must reproduce the trajectory of the plain integrator
+ */
+template <typename modules_type>
+void test_fused()
+{
+    typedef verlet_nvt_hoover<modules_type> system_type;
+    unsigned int constexpr steps = 200;
+    unsigned int constexpr batch = 10;
+    double const tolerance = 100 * modules_type::tolerance::value;
+
+    system_type plain;
+    system_type fused;
+
+    BOOST_TEST_MESSAGE("prepare identical systems");
+    plain.position->set();
+    plain.velocity->set();
+    fused.position->set();
+    {
+        auto const& velocity = read_cache(plain.particle->velocity());
+        auto fused_velocity = make_cache_mutable(fused.particle->velocity());
+        std::copy(velocity.begin(), velocity.end(), fused_velocity->begin());
+    }
+
+    BOOST_TEST_MESSAGE("run " << steps << " steps in batches of " << batch << " steps");
+    for (unsigned int i = 0; i < steps; ++i) {
+        plain.integrator->integrate();
+        plain.integrator->finalize();
+
+        fused.integrator->integrate();
+        if ((i + 1) % batch > 0) {
+            fused.integrator->defer_finalize();
+            continue;
+        }
+        fused.integrator->finalize();
+
+        // compare at the end of each batch
+        auto const& position = read_cache(plain.particle->position());
+        auto const& fused_position = read_cache(fused.particle->position());
+        auto const& velocity = read_cache(plain.particle->velocity());
+        auto const& fused_velocity = read_cache(fused.particle->velocity());
+        double max_diff = 0;
+        for (unsigned int j = 0; j < plain.npart; ++j) {
+            max_diff = max(max_diff, double(norm_inf(position[j] - fused_position[j])));
+            max_diff = max(max_diff, double(norm_inf(velocity[j] - fused_velocity[j])));
+        }
+        BOOST_CHECK_SMALL(max_diff, tolerance);
+        // chain variables may be large, compare relative deviations
+        auto const& xi = plain.integrator->xi;
+        auto const& v_xi = plain.integrator->v_xi;
+        BOOST_CHECK_SMALL(double(norm_inf(xi - fused.integrator->xi) / norm_inf(xi)), tolerance);
+        BOOST_CHECK_SMALL(double(norm_inf(v_xi - fused.integrator->v_xi) / norm_inf(v_xi)), tolerance);
+        BOOST_CHECK_CLOSE_FRACTION(plain.integrator->en_nhc(), fused.integrator->en_nhc(), tolerance);
+    }
+}
+
 #ifndef USE_HOST_SINGLE_PRECISION
 BOOST_AUTO_TEST_CASE( verlet_nvt_hoover_host_2d ) {
     verlet_nvt_hoover<host_modules<2, double> >().test();
@@ -364,6 +432,12 @@ BOOST_AUTO_TEST_CASE( verlet_nvt_hoover_host_2d ) {
 BOOST_AUTO_TEST_CASE( verlet_nvt_hoover_host_3d ) {
     verlet_nvt_hoover<host_modules<3, double> >().test();
 }
+BOOST_AUTO_TEST_CASE( fused_host_2d ) {
+    test_fused<host_modules<2, double> >();
+}
+BOOST_AUTO_TEST_CASE( fused_host_3d ) {
+    test_fused<host_modules<3, double> >();
+}
 #else
 BOOST_AUTO_TEST_CASE( verlet_nvt_hoover_host_2d ) {
     verlet_nvt_hoover<host_modules<2, float> >().test();
@@ -371,6 +445,12 @@ BOOST_AUTO_TEST_CASE( verlet_nvt_hoover_host_2d ) {
 BOOST_AUTO_TEST_CASE( verlet_nvt_hoover_host_3d ) {
     verlet_nvt_hoover<host_modules<3, float> >().test();
 }
+BOOST_AUTO_TEST_CASE( fused_host_2d ) {
+    test_fused<host_modules<2, float> >();
+}
+BOOST_AUTO_TEST_CASE( fused_host_3d ) {
+    test_fused<host_modules<3, float> >();
+}
 #endif
 
 #ifdef HALMD_WITH_GPU
@@ -419,6 +499,17 @@ struct gpu_modules
     typedef observables::gpu::thermodynamics<dimension, float_type> thermodynamics_type;
     typedef mdsim::gpu::velocities::boltzmann<dimension, float_type, halmd::random::gpu::rand48> velocity_type;
     static bool const gpu = true;
+
+    /** the GPU generator does not key its streams by the simulation step */
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<mdsim::clock const>
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, temperature);
+    }
     typedef gpu_tolerance<float_type> tolerance;
     typedef gpu_en_tolerance<float_type> en_tolerance;
 };
@@ -0,0 +1,118 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE neighbour_array
+#include <boost/test/unit_test.hpp>
+
+#include <halmd/mdsim/host/neighbour_array.hpp>
+#include <halmd/utility/thread_pool.hpp>
+#include <test/tools/ctest.hpp>
+
+#include <vector>
+
+using halmd::mdsim::host::neighbour_array;
+
+/**
+ * fill lists in reversed particle order and compare with reference lists
+ */
+BOOST_AUTO_TEST_CASE( fill )
+{
+    unsigned int const nparticle = 100;
+    neighbour_array lists(nparticle);
+    BOOST_CHECK_EQUAL( lists.size(), nparticle );
+    BOOST_CHECK_EQUAL( lists.nneighbour(), 0u );
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        BOOST_CHECK( lists[i].empty() );
+    }
+
+    std::vector<std::vector<unsigned int>> reference(nparticle);
+    for (unsigned int i = nparticle; i > 0; --i) {
+        lists.open(i - 1);
+        // leave every third list empty
+        for (unsigned int j = 0; j < (i - 1) % 3 * 5; ++j) {
+            unsigned int k = (i * 7 + j * 13) % nparticle;
+            lists.push_back(k);
+            reference[i - 1].push_back(k);
+        }
+        lists.close();
+    }
+
+    std::size_t nneighbour = 0;
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            lists[i].begin(), lists[i].end()
+          , reference[i].begin(), reference[i].end()
+        );
+        nneighbour += reference[i].size();
+    }
+    BOOST_CHECK_EQUAL( lists.nneighbour(), nneighbour );
+
+    // refill after clear, with a single non-empty list
+    lists.clear();
+    BOOST_CHECK_EQUAL( lists.nneighbour(), 0u );
+    lists.open(42);
+    lists.push_back(1);
+    lists.push_back(2);
+    lists.close();
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        BOOST_CHECK_EQUAL( lists[i].size(), i == 42 ? 2 : 0 );
+    }
+    BOOST_CHECK_EQUAL( lists[42].front(), 1u );
+    BOOST_CHECK_EQUAL( lists[42].back(), 2u );
+
+    lists.resize(10);
+    BOOST_CHECK_EQUAL( lists.size(), 10u );
+    BOOST_CHECK_EQUAL( lists.nneighbour(), 0u );
+}
+
+/**
+ * fill lists of interleaved particles into separate partitions concurrently
+ */
+BOOST_AUTO_TEST_CASE( partition )
+{
+    unsigned int const nparticle = 1000;
+    unsigned int const npartition = 4;
+    neighbour_array lists(nparticle);
+    lists.partition(npartition);
+    BOOST_CHECK_EQUAL( lists.npartition(), npartition );
+
+    halmd::utility::thread_pool pool(npartition);
+    pool.run([&](unsigned int partition) {
+        for (unsigned int i = partition; i < nparticle; i += npartition) {
+            lists.open(i, partition);
+            for (unsigned int j = 0; j < i % 7; ++j) {
+                lists.push_back(i + j, partition);
+            }
+            lists.close(partition);
+        }
+    });
+
+    std::size_t nneighbour = 0;
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        BOOST_CHECK_EQUAL( lists[i].size(), i % 7 );
+        for (unsigned int j = 0; j < lists[i].size(); ++j) {
+            BOOST_CHECK_EQUAL( lists[i][j], i + j );
+        }
+        nneighbour += i % 7;
+    }
+    BOOST_CHECK_EQUAL( lists.nneighbour(), nneighbour );
+}
@@ -28,6 +28,7 @@
 
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/positions/lattice_primitive.hpp>
+#include <halmd/utility/thread_pool.hpp>
 #include <test/tools/constant_iterator.hpp>
 #include <test/tools/ctest.hpp>
 #ifdef HALMD_WITH_GPU
@@ -40,6 +41,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <random>
 
 /**
  * Primitive lattice with equal number of lattice points per dimension.
@@ -662,6 +665,66 @@ static void test_stress_pot(particle_type& particle)
     );
 }
 
+/**
+ * Test parallel rearrangement of particle arrays, including user-registered arrays.
+ */
+template <typename particle_type>
+static void test_rearrange(particle_type& particle, unsigned int nthread)
+{
+    typedef typename particle_type::position_type position_type;
+    typedef typename particle_type::id_type id_type;
+    typedef typename particle_type::reverse_id_type reverse_id_type;
+    typedef typename particle_type::force_type force_type;
+
+    unsigned int const nparticle = particle.nparticle();
+
+    // assign square/four-dimensional cubic lattice vectors
+    equilateral_lattice<position_type> lattice(nparticle);
+    set_position(particle, make_lattice_iterator(lattice, 0));
+    // user-registered particle array
+    auto tag = particle.template register_data<double>("tag");
+    tag->set_data(boost::counting_iterator<double>(1));
+    // forces are not permuted
+    set_force(
+        particle
+      , make_lattice_iterator(lattice, 0)
+      , make_lattice_iterator(lattice, nparticle)
+    );
+
+    // random permutation
+    std::vector<unsigned int> index(nparticle);
+    std::iota(index.begin(), index.end(), 0);
+    std::shuffle(index.begin(), index.end(), std::mt19937(42));
+
+    halmd::utility::thread_pool pool(nthread);
+    // rearrange twice to make use of the scratch buffers
+    particle.rearrange(index, pool);
+    particle.rearrange(index, pool);
+
+    std::vector<position_type> position(nparticle);
+    std::vector<id_type> id(nparticle);
+    std::vector<reverse_id_type> reverse_id(nparticle);
+    std::vector<double> tag_data(nparticle);
+    std::vector<force_type> force(nparticle);
+    get_position(particle, position.begin());
+    get_id(particle, id.begin());
+    get_reverse_id(particle, reverse_id.begin());
+    tag->get_data(tag_data.begin());
+    get_force(particle, force.begin());
+
+    for (unsigned int i = 0; i < nparticle; ++i) {
+        unsigned int j = index[index[i]];
+        BOOST_CHECK_EQUAL( id[i], j );
+        BOOST_CHECK_EQUAL( reverse_id[j], i );
+        BOOST_CHECK_EQUAL( tag_data[i], j + 1 );
+        BOOST_CHECK_EQUAL( position[i], lattice(j) );
+        BOOST_CHECK_EQUAL( force[i], lattice(i) );
+    }
+    // padding of the particle arrays is preserved
+    auto const& id_array = read_cache(particle.id());
+    BOOST_CHECK( std::all_of(id_array.begin() + nparticle, id_array.end(), [](id_type i) { return i == -1U; }) );
+}
+
 /**
  * BOOST_AUTO_TEST_SUITE only allows test cases to be registered inside it, no function calls.
  * For this reason the old test_suite_{host,gpu} function had to be replaced with these macros.
@@ -708,6 +771,10 @@ static void test_stress_pot(particle_type& particle)
     BOOST_DATA_TEST_CASE( stress_pot, dataset, nparticle ) {\
         particle_type particle(nparticle, nspecies);        \
         test_stress_pot(particle);                          \
+    }                                                       \
+    BOOST_DATA_TEST_CASE( rearrange, dataset, nparticle ) { \
+        particle_type particle(nparticle, nspecies);        \
+        test_rearrange(particle, 4);                        \
     }
 
 #ifdef HALMD_WITH_GPU
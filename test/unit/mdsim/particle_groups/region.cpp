@@ -34,6 +34,7 @@
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <cmath>
+#include <random>
 
 // include definition file to generate template instantiations of region with 'simple' geometry
 #include <halmd/mdsim/host/particle_groups/region.cpp>
@@ -123,6 +124,104 @@ test_uniform_density(shape_type const& shape, std::shared_ptr<geometry_type> geo
     test_region<region_type>(particle, geometry);
 }
 
+/**
+ * Compare region selection by cells with the selection by testing all
+ * particles, for random positions within the simulation box that are
+ * displaced between rebuilds of the cell lists.
+ */
+template <typename region_type, typename geometry_type>
+static void test_binning(
+    typename region_type::vector_type const& length
+  , std::shared_ptr<geometry_type> geometry
+)
+{
+    enum { dimension = region_type::vector_type::static_size };
+    typedef typename region_type::particle_type particle_type;
+    typedef typename region_type::binning_type binning_type;
+    typedef typename region_type::displacement_type displacement_type;
+    typedef typename region_type::vector_type vector_type;
+    typedef halmd::mdsim::box<dimension> box_type;
+
+    unsigned int const nparticle = 10000;
+    auto particle = std::make_shared<particle_type>(nparticle, 1);
+    typename box_type::matrix_type edges = boost::numeric::ublas::zero_matrix<double>(dimension, dimension);
+    for (int i = 0; i < dimension; ++i) {
+        edges(i, i) = length[i];
+    }
+    auto box = std::make_shared<box_type>(edges);
+    typename binning_type::matrix_type r_cut(1, 1);
+    r_cut(0, 0) = 1;
+    auto binning = std::make_shared<binning_type>(particle, box, r_cut, 0.5);
+    auto displacement = std::make_shared<displacement_type>(particle, box);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> uniform(-0.5, 0.5);
+    auto shuffle = [&]() {
+        auto position = make_cache_mutable(particle->position());
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            for (int j = 0; j < dimension; ++j) {
+                (*position)[i][j] = uniform(gen) * length[j];
+            }
+        }
+        // place some particles at the edges of the box
+        for (int j = 0; j < dimension; ++j) {
+            (*position)[j][j] = length[j] / 2;
+            (*position)[dimension + j][j] = -length[j] / 2;
+        }
+    };
+    // displace particles by less than a quarter of the skin, and fold them
+    // into the periodic box, which may move them across the box edges
+    auto move = [&]() {
+        auto position = make_cache_mutable(particle->position());
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            vector_type dr;
+            for (int j = 0; j < dimension; ++j) {
+                dr[j] = uniform(gen) * 0.2 / std::sqrt(double(dimension));
+            }
+            (*position)[i] += dr;
+            box->reduce_periodic((*position)[i]);
+        }
+    };
+    // update of the neighbour lists
+    auto rebuild = [&]() {
+        read_cache(binning->cell());
+        displacement->zero();
+    };
+
+    for (auto selection : {region_type::included, region_type::excluded}) {
+        region_type region(particle, geometry, selection);
+        region_type region_cells(particle, geometry, selection, binning, displacement);
+
+        for (unsigned int step = 0; step < 8; ++step) {
+            // rebuild the cell lists every third step, and move the particles
+            // by more than half of the skin without rebuild in the last step
+            if (step == 7) {
+                shuffle();
+            }
+            else if (step % 3 == 0) {
+                shuffle();
+                rebuild();
+            }
+            else {
+                move();
+            }
+            halmd::cache<> cell_cache = binning->last_cell();
+
+            auto const& expected = read_cache(region.selection());
+            auto const& result = read_cache(region_cells.selection());
+            BOOST_CHECK_EQUAL( expected.size(), result.size() );
+            // the selection is ordered by particle index in both cases
+            BOOST_CHECK_EQUAL_COLLECTIONS( expected.begin(), expected.end(), result.begin(), result.end() );
+            // the region does not update the cell lists
+            BOOST_CHECK( cell_cache == binning->last_cell() );
+
+            auto const& mask = read_cache(region.mask());
+            auto const& mask_cells = read_cache(region_cells.mask());
+            BOOST_CHECK_EQUAL_COLLECTIONS( mask.begin(), mask.end(), mask_cells.begin(), mask_cells.end() );
+        }
+    }
+}
+
 /**
  * Manual test case registration.
  */
@@ -158,6 +257,9 @@ HALMD_TEST_INIT( region )
         typedef float float_type;
 #endif
         typedef simple_geometry<dimension, float_type> geometry_type;
+        typedef halmd::mdsim::geometries::cuboid<dimension, float_type> cuboid_type;
+        typedef halmd::mdsim::geometries::cylinder<dimension, float_type> cylinder_type;
+        typedef halmd::mdsim::geometries::sphere<dimension, float_type> sphere_type;
         typedef geometry_type::vector_type vector_type;
         typedef halmd::mdsim::host::particle_groups::region<dimension, float_type, geometry_type> region_type;
         typedef halmd::fixed_vector<size_t, dimension> shape_type;
@@ -170,6 +272,21 @@ HALMD_TEST_INIT( region )
             );
         };
         ts_host_two->add(BOOST_TEST_CASE( uniform_density ));
+
+        auto binning = [=]() {
+            vector_type length = {10, 14};
+            test_binning<region_type>(length, std::make_shared<geometry_type>(vector_type{1.5, -2.}));
+            test_binning<halmd::mdsim::host::particle_groups::region<dimension, float_type, cuboid_type>>(
+                length, std::make_shared<cuboid_type>(vector_type{-3., -8.}, vector_type{4.2, 5.})
+            );
+            test_binning<halmd::mdsim::host::particle_groups::region<dimension, float_type, sphere_type>>(
+                length, std::make_shared<sphere_type>(vector_type{1, 2}, 3.3)
+            );
+            test_binning<halmd::mdsim::host::particle_groups::region<dimension, float_type, cylinder_type>>(
+                length, std::make_shared<cylinder_type>(vector_type{1, 1}, vector_type{-1, 0}, 2.5, 8)
+            );
+        };
+        ts_host_two->add(BOOST_TEST_CASE( binning ));
     }
     {
         int constexpr dimension = 3;
@@ -179,6 +296,9 @@ HALMD_TEST_INIT( region )
         typedef float float_type;
 #endif
         typedef simple_geometry<dimension, float_type> geometry_type;
+        typedef halmd::mdsim::geometries::cuboid<dimension, float_type> cuboid_type;
+        typedef halmd::mdsim::geometries::cylinder<dimension, float_type> cylinder_type;
+        typedef halmd::mdsim::geometries::sphere<dimension, float_type> sphere_type;
         typedef geometry_type::vector_type vector_type;
         typedef halmd::mdsim::host::particle_groups::region<dimension, float_type, geometry_type> region_type;
         typedef halmd::fixed_vector<size_t, dimension> shape_type;
@@ -191,6 +311,21 @@ HALMD_TEST_INIT( region )
             );
         };
         ts_host_three->add(BOOST_TEST_CASE( uniform_density ));
+
+        auto binning = [=]() {
+            vector_type length = {10, 14, 9};
+            test_binning<region_type>(length, std::make_shared<geometry_type>(vector_type{1.5, -2., 0.}));
+            test_binning<halmd::mdsim::host::particle_groups::region<dimension, float_type, cuboid_type>>(
+                length, std::make_shared<cuboid_type>(vector_type{-3., -8., -2.}, vector_type{4.2, 5., 6.})
+            );
+            test_binning<halmd::mdsim::host::particle_groups::region<dimension, float_type, sphere_type>>(
+                length, std::make_shared<sphere_type>(vector_type{1, 2, -1}, 3.3)
+            );
+            test_binning<halmd::mdsim::host::particle_groups::region<dimension, float_type, cylinder_type>>(
+                length, std::make_shared<cylinder_type>(vector_type{1, 1, 0}, vector_type{-1., 0., 0.5}, 2.5, 8)
+            );
+        };
+        ts_host_three->add(BOOST_TEST_CASE( binning ));
     }
 #ifdef HALMD_WITH_GPU
     {
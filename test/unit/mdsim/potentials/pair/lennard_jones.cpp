@@ -353,6 +353,38 @@ BOOST_AUTO_TEST_CASE( lennard_jones_host )
         BOOST_CHECK_CLOSE_FRACTION(fval, a[1], tolerance);
         BOOST_CHECK_CLOSE_FRACTION(en_pot, a[2], tolerance);
     };
+
+    // evaluate interactions AA and AB in a single batch of pairs
+    potential_type::batch_type pairs;
+    pairs.a = 0;
+    pairs.size = 0;
+    for (array_type const& a : results_aa) {
+        pairs.b[pairs.size] = 0;
+        pairs.rr[pairs.size++] = std::pow(a[0], 2);
+    }
+    for (array_type const& a : results_ab) {
+        pairs.b[pairs.size] = 1;
+        pairs.rr[pairs.size++] = std::pow(a[0], 2);
+    }
+    potential(pairs);
+    for (unsigned int k = 0; k < pairs.size; ++k) {
+        array_type const& a = (k < results_aa.size()) ? results_aa[k] : results_ab[k - results_aa.size()];
+        BOOST_CHECK_CLOSE_FRACTION(pairs.fval[k], a[1], tolerance);
+        BOOST_CHECK_CLOSE_FRACTION(pairs.en_pot[k], a[2], tolerance);
+    }
+
+    // evaluate interaction BB in a batch of pairs
+    pairs.a = 1;
+    pairs.size = 0;
+    for (array_type const& a : results_bb) {
+        pairs.b[pairs.size] = 1;
+        pairs.rr[pairs.size++] = std::pow(a[0], 2);
+    }
+    potential(pairs);
+    for (unsigned int k = 0; k < pairs.size; ++k) {
+        BOOST_CHECK_CLOSE_FRACTION(pairs.fval[k], results_bb[k][1], tolerance);
+        BOOST_CHECK_CLOSE_FRACTION(pairs.en_pot[k], results_bb[k][2], tolerance);
+    }
 }
 
 #ifdef HALMD_WITH_GPU
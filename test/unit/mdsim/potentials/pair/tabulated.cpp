@@ -0,0 +1,213 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE tabulated
+#include <boost/test/unit_test.hpp>
+
+#include <boost/numeric/ublas/assignment.hpp> // <<=
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <halmd/mdsim/host/potentials/pair/adapters/hard_core.hpp>
+#include <halmd/mdsim/host/potentials/pair/lennard_jones.hpp>
+#include <halmd/mdsim/host/potentials/pair/tabulated.hpp>
+#include <halmd/mdsim/host/potentials/pair/truncations/shifted.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+using namespace std;
+
+#ifndef USE_HOST_SINGLE_PRECISION
+typedef double float_type;
+#else
+typedef float float_type;
+#endif
+typedef mdsim::host::potentials::pair::tabulated<float_type> tabulated_type;
+typedef tabulated_type::matrix_type matrix_type;
+typedef tabulated_type::table_type table_type;
+
+/**
+ * A cubic polynomial in r² is reproduced exactly from tabulated potential and
+ * forces, a linear function in r² from the potential values alone.
+ */
+BOOST_AUTO_TEST_CASE( polynomial )
+{
+    unsigned int const npoint = 11;
+    matrix_type sigma(1, 1), r_min(1, 1), r_max(1, 1);
+    sigma <<= 1;
+    r_min <<= 1;
+    r_max <<= 3;
+
+    // U(r) = 1 - r² + r⁴/2 - r⁶/10
+    auto energy = [](float_type rr) { return 1 - rr + rr * rr / 2 - rr * rr * rr / 10; };
+    auto fval = [](float_type rr) { return -2 * (-1 + rr - 3 * rr * rr / 10); };
+
+    table_type en(1), f(1), en_linear(1);
+    for (unsigned int i = 0; i < npoint; ++i) {
+        float_type rr = 1 + i * (9 - 1) / float_type(npoint - 1);
+        en[0].push_back(energy(rr));
+        f[0].push_back(fval(rr));
+        en_linear[0].push_back(2 - rr / 4);
+    }
+    tabulated_type potential(sigma, r_min, r_max, en, f);
+    tabulated_type linear(sigma, r_min, r_max, en_linear, table_type());
+
+    BOOST_CHECK_EQUAL( potential.npoint()(0, 0), npoint );
+    BOOST_CHECK_EQUAL( potential.size1(), 1u );
+    BOOST_CHECK_EQUAL( potential.r_max()(0, 0), 3 );
+
+    float_type const tolerance = 100 * numeric_limits<float_type>::epsilon();
+    for (float_type rr = 1.03; rr < 9; rr += 0.37) {
+        float_type fval_, en_pot_;
+        tie(fval_, en_pot_) = potential(rr, 0, 0);
+        BOOST_CHECK_CLOSE_FRACTION( en_pot_, energy(rr), tolerance );
+        BOOST_CHECK_CLOSE_FRACTION( fval_, fval(rr), tolerance );
+
+        tie(fval_, en_pot_) = linear(rr, 0, 0);
+        BOOST_CHECK_CLOSE_FRACTION( en_pot_, 2 - rr / 4, tolerance );
+        BOOST_CHECK_CLOSE_FRACTION( fval_, float_type(0.5), tolerance );
+    }
+
+    // the first interval is extrapolated below the table
+    float_type fval_, en_pot_;
+    tie(fval_, en_pot_) = potential(0.5, 0, 0);
+    BOOST_CHECK_CLOSE_FRACTION( en_pot_, energy(0.5), tolerance );
+    BOOST_CHECK_CLOSE_FRACTION( fval_, fval(0.5), tolerance );
+
+    // the potential vanishes beyond the table
+    tie(fval_, en_pot_) = potential(9.5, 0, 0);
+    BOOST_CHECK_EQUAL( fval_, 0 );
+    BOOST_CHECK_EQUAL( en_pot_, 0 );
+
+    // invalid tables
+    BOOST_CHECK_THROW( tabulated_type(sigma, r_min, r_max, table_type(2, en[0]), table_type()), invalid_argument );
+    BOOST_CHECK_THROW( tabulated_type(sigma, r_min, r_max, table_type(1, {1}), table_type()), invalid_argument );
+    BOOST_CHECK_THROW( tabulated_type(sigma, r_max, r_min, en, f), invalid_argument );
+}
+
+/**
+ * Tabulate the Lennard-Jones potential for a binary mixture and compare
+ * scalar and batched evaluation against the analytic potential.
+ */
+BOOST_AUTO_TEST_CASE( lennard_jones )
+{
+    typedef mdsim::host::potentials::pair::lennard_jones<float_type> lennard_jones_type;
+    typedef mdsim::host::potentials::pair::truncations::shifted<tabulated_type> potential_type;
+
+    unsigned int const ntype = 2;
+    matrix_type epsilon(ntype, ntype), sigma(ntype, ntype), r_min(ntype, ntype), r_max(ntype, ntype);
+    epsilon <<=
+        1., .5
+      , .5, .25;
+    sigma <<=
+        1., 2.
+      , 2., 4.;
+    r_min = 0.8 * sigma;
+    r_max = 3 * sigma;
+    matrix_type cutoff(ntype, ntype);
+    cutoff <<=
+        2.5, 2.5
+      , 2.5, 2.5;
+
+    lennard_jones_type lennard_jones(epsilon, sigma);
+    unsigned int const npoint = 4000;
+    auto table = tabulated_type::sample(lennard_jones, r_min, r_max, npoint, make_shared<halmd::logger>());
+    BOOST_CHECK_EQUAL( table->sigma()(0, 1), sigma(0, 1) );
+    BOOST_CHECK_EQUAL( table->r_min()(1, 1), r_min(1, 1) );
+
+    potential_type potential(cutoff, *table);
+    mdsim::host::potentials::pair::truncations::shifted<lennard_jones_type> reference(cutoff, lennard_jones);
+
+    // interpolation error is of order h⁴ for the potential and of order h³
+    // for the force with grid spacing h, in single precision the error is
+    // dominated by round-off in the position within the table
+    float_type const tolerance = max(float_type(1e-6), 1000 * numeric_limits<float_type>::epsilon());
+    float_type const tolerance_force = 100 * tolerance;
+    tabulated_type::batch_type pairs;
+    for (unsigned int a = 0; a < ntype; ++a) {
+        pairs.a = a;
+        pairs.size = 0;
+        for (float_type r = 0.85; r < 2.5; r += 0.0173) {
+            for (unsigned int b = 0; b < ntype; ++b) {
+                float_type rr = pow(r * sigma(a, b), 2);
+                float_type fval, en_pot, fval_ref, en_pot_ref;
+                tie(fval, en_pot) = potential(rr, a, b);
+                tie(fval_ref, en_pot_ref) = reference(rr, a, b);
+                BOOST_CHECK_SMALL( (fval - fval_ref) * rr / epsilon(a, b), tolerance_force );
+                BOOST_CHECK_SMALL( (en_pot - en_pot_ref) / epsilon(a, b), tolerance );
+
+                if (pairs.size == tabulated_type::batch_type::capacity) {
+                    pairs.size = 0;
+                }
+                pairs.b[pairs.size] = b;
+                pairs.rr[pairs.size] = rr;
+                ++pairs.size;
+                if (pairs.size == tabulated_type::batch_type::capacity) {
+                    potential(pairs);
+                    for (unsigned int k = 0; k < pairs.size; ++k) {
+                        tie(fval, en_pot) = potential(pairs.rr[k], a, pairs.b[k]);
+                        BOOST_CHECK_CLOSE_FRACTION( pairs.fval[k], fval, numeric_limits<float_type>::epsilon() );
+                        BOOST_CHECK_CLOSE_FRACTION( pairs.en_pot[k], en_pot, numeric_limits<float_type>::epsilon() );
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * The hard core adapter shifts the tabulated potential by the core radius.
+ */
+BOOST_AUTO_TEST_CASE( hard_core )
+{
+    typedef mdsim::host::potentials::pair::adapters::hard_core<tabulated_type> potential_type;
+
+    unsigned int const npoint = 11;
+    matrix_type sigma(1, 1), r_min(1, 1), r_max(1, 1), core(1, 1);
+    sigma <<= 2;
+    r_min <<= 1;
+    r_max <<= 3;
+    core <<= 0.25;
+
+    table_type en(1), f(1);
+    for (unsigned int i = 0; i < npoint; ++i) {
+        float_type rr = 1 + i * (9 - 1) / float_type(npoint - 1);
+        en[0].push_back(2 - rr / 4);
+        f[0].push_back(0.5);
+    }
+    tabulated_type table(sigma, r_min, r_max, en, f);
+    potential_type potential(core, table);
+    BOOST_CHECK_EQUAL( potential.r_core_sigma()(0, 0), core(0, 0) );
+
+    float_type const tolerance = 100 * numeric_limits<float_type>::epsilon();
+    float_type const r_core = core(0, 0) * sigma(0, 0);
+    for (float_type r = 1.6; r < 3.2; r += 0.13) {
+        float_type r_s = r - r_core;
+        float_type fval, en_pot, fval_ref, en_pot_ref;
+        tie(fval, en_pot) = potential(r * r, 0, 0);
+        tie(fval_ref, en_pot_ref) = table(r_s * r_s, 0, 0);
+        BOOST_CHECK_CLOSE_FRACTION( en_pot, en_pot_ref, tolerance );
+        BOOST_CHECK_CLOSE_FRACTION( fval, fval_ref * r_s / r, tolerance );
+    }
+}
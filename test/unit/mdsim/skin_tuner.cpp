@@ -0,0 +1,93 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE skin_tuner
+#include <boost/test/unit_test.hpp>
+
+#include <halmd/mdsim/host/neighbours/skin_tuner.hpp>
+#include <test/tools/ctest.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+using halmd::mdsim::host::neighbours::skin_tuner;
+
+/**
+ * Model of the cost per step: the update cost is distributed over a number
+ * of steps proportional to the skin, and the force cost grows with the
+ * volume of the shell of neighbours.
+ */
+static double cost_per_step(double skin)
+{
+    double const r_cut = 2.5;
+    return 5 / skin + std::pow(r_cut + skin, 3) / std::pow(r_cut, 3);
+}
+
+/**
+ * Run tuner until the search has ended, and return the number of intervals.
+ */
+static unsigned int run(skin_tuner& tuner, double skin_min, double skin_max)
+{
+    unsigned int const nstep = 20;
+    unsigned int ninterval = 0;
+    double skin = tuner.skin();
+    while (tuner.active() && ninterval < 10000) {
+        BOOST_CHECK( skin >= skin_min && skin <= skin_max );
+        skin = tuner.sample(nstep * cost_per_step(skin), nstep);
+        ++ninterval;
+    }
+    return ninterval;
+}
+
+BOOST_AUTO_TEST_CASE( minimum )
+{
+    // the minimum of the cost function is at skin ≈ 1.33
+    double const skin_min = 0.1;
+    double const skin_max = 3;
+    unsigned int const window = 5;
+    skin_tuner tuner(0.3, skin_min, skin_max, window);
+    BOOST_CHECK( tuner.active() );
+    BOOST_CHECK_EQUAL( tuner.skin(), 0.3 );
+
+    unsigned int ninterval = run(tuner, skin_min, skin_max);
+    BOOST_CHECK( !tuner.active() );
+    BOOST_CHECK_EQUAL( ninterval % window, 0u );
+    BOOST_CHECK_EQUAL( tuner.skin(), tuner.best_skin() );
+    BOOST_CHECK_CLOSE_FRACTION( tuner.skin(), 1.33, 0.05 );
+    BOOST_CHECK_CLOSE_FRACTION( tuner.best_cost(), cost_per_step(tuner.skin()), 1e-12 );
+
+    // the skin is fixed after the search
+    BOOST_CHECK_EQUAL( tuner.sample(1, 1), tuner.best_skin() );
+}
+
+BOOST_AUTO_TEST_CASE( bounds )
+{
+    // the minimum lies above the upper bound
+    skin_tuner tuner(0.2, 0.1, 0.5, 1);
+    run(tuner, 0.1, 0.5);
+    BOOST_CHECK( !tuner.active() );
+    BOOST_CHECK_CLOSE_FRACTION( tuner.skin(), 0.5, 1e-12 );
+
+    BOOST_CHECK_THROW( skin_tuner(0.05, 0.1, 0.5, 1), std::invalid_argument );
+    BOOST_CHECK_THROW( skin_tuner(0.2, 0, 0.5, 1), std::invalid_argument );
+    BOOST_CHECK_THROW( skin_tuner(0.2, 0.1, 0.5, 0), std::invalid_argument );
+}
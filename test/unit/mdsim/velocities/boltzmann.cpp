@@ -25,6 +25,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/clock.hpp>
 #include <halmd/mdsim/host/particle.hpp>
 #include <halmd/mdsim/host/particle_groups/all.hpp>
 #include <halmd/mdsim/host/velocities/boltzmann.hpp>
@@ -48,7 +49,9 @@
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/numeric/ublas/banded.hpp>
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 /**
  * test initialisation of particle velocities: boltzmann module
@@ -62,6 +65,7 @@ struct boltzmann
     typedef typename modules_type::particle_group_type particle_group_type;
     typedef typename modules_type::random_type random_type;
     typedef typename modules_type::velocity_type velocity_type;
+    typedef halmd::mdsim::clock clock_type;
     typedef typename particle_type::vector_type vector_type;
     typedef typename vector_type::value_type float_type;
     static unsigned int const dimension = vector_type::static_size;
@@ -76,6 +80,7 @@ struct boltzmann
     std::shared_ptr<box_type> box;
     std::shared_ptr<particle_type> particle;
     std::shared_ptr<random_type> random;
+    std::shared_ptr<clock_type> clock;
     std::shared_ptr<velocity_type> velocity;
 
     void test();
@@ -160,7 +165,8 @@ boltzmann<modules_type>::boltzmann()
     particle = std::make_shared<particle_type>(npart, 1);
     box = std::make_shared<box_type>(edges);
     random = std::make_shared<random_type>();
-    velocity = std::make_shared<velocity_type>(particle, random, temp);
+    clock = std::make_shared<clock_type>();
+    velocity = modules_type::make_velocity(particle, random, clock, temp);
 }
 
 template<typename float_type>
@@ -179,8 +185,53 @@ struct host_modules
     typedef halmd::mdsim::host::velocities::boltzmann<dimension, float_type> velocity_type;
     static bool const gpu = false;
     typedef host_tolerance<float_type> tolerance;
+
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<halmd::mdsim::clock const> clock
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, clock, temperature);
+    }
 };
 
+/**
+ * The host velocities depend on the simulation step, but not on the number
+ * of previous calls.
+ */
+template <typename modules_type>
+static void test_step()
+{
+    typedef typename modules_type::particle_type particle_type;
+    typedef typename modules_type::random_type random_type;
+    typedef typename particle_type::vector_type vector_type;
+
+    auto particle = std::make_shared<particle_type>(100, 1);
+    auto random = std::make_shared<random_type>(42);
+    auto clock = std::make_shared<halmd::mdsim::clock>();
+    clock->set_timestep(0.001);
+    auto velocity = modules_type::make_velocity(particle, random, clock, 1);
+
+    velocity->set();
+    auto const& v = read_cache(particle->velocity());
+    std::vector<vector_type> v0(v.begin(), v.end());
+    velocity->set();
+    BOOST_CHECK( std::equal(v.begin(), v.end(), v0.begin()) );
+
+    clock->advance();
+    velocity->set();
+    std::vector<vector_type> v1(v.begin(), v.end());
+    BOOST_CHECK( !std::equal(v1.begin(), v1.end(), v0.begin()) );
+
+    // a new generator with the same seed reproduces the velocities of a step
+    random = std::make_shared<random_type>(42);
+    modules_type::make_velocity(particle, random, clock, 1)->set();
+    auto const& v2 = read_cache(particle->velocity());
+    BOOST_CHECK( std::equal(v2.begin(), v2.end(), v1.begin()) );
+}
+
 #ifndef USE_HOST_SINGLE_PRECISION
 BOOST_AUTO_TEST_CASE( boltzmann_host_2d ) {
     boltzmann<host_modules<2, double> >().test();
@@ -188,6 +239,9 @@ BOOST_AUTO_TEST_CASE( boltzmann_host_2d ) {
 BOOST_AUTO_TEST_CASE( boltzmann_host_3d ) {
     boltzmann<host_modules<3, double> >().test();
 }
+BOOST_AUTO_TEST_CASE( boltzmann_host_step ) {
+    test_step<host_modules<3, double> >();
+}
 #else
 BOOST_AUTO_TEST_CASE( boltzmann_host_2d ) {
     boltzmann<host_modules<2, float> >().test();
@@ -195,6 +249,9 @@ BOOST_AUTO_TEST_CASE( boltzmann_host_2d ) {
 BOOST_AUTO_TEST_CASE( boltzmann_host_3d ) {
     boltzmann<host_modules<3, float> >().test();
 }
+BOOST_AUTO_TEST_CASE( boltzmann_host_step ) {
+    test_step<host_modules<3, float> >();
+}
 #endif
 
 #ifdef HALMD_WITH_GPU
@@ -222,6 +279,17 @@ struct gpu_modules
     typedef halmd::mdsim::gpu::velocities::boltzmann<dimension, float_type, halmd::random::gpu::rand48> velocity_type;
     static bool const gpu = true;
     typedef gpu_tolerance<float_type> tolerance;
+
+    /** the GPU generator does not key its streams by the simulation step */
+    static std::shared_ptr<velocity_type> make_velocity(
+        std::shared_ptr<particle_type> particle
+      , std::shared_ptr<random_type> random
+      , std::shared_ptr<halmd::mdsim::clock const>
+      , double temperature
+    )
+    {
+        return std::make_shared<velocity_type>(particle, random, temperature);
+    }
 };
 
 # ifdef USE_GPU_SINGLE_PRECISION
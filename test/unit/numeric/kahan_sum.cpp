@@ -0,0 +1,97 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE kahan_sum
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+
+#include <halmd/numeric/blas/fixed_vector.hpp>
+#include <halmd/numeric/kahan_sum.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+
+/**
+ * sum many small values onto a large one, which are lost entirely by
+ * naive summation in single precision
+ */
+BOOST_AUTO_TEST_CASE( scalar )
+{
+    unsigned int const count = 1000000;
+    float const small = std::numeric_limits<float>::epsilon() / 4;
+
+    float naive = 1;
+    kahan_sum<float> sum;
+    sum += 1.f;
+    for (unsigned int i = 0; i < count; ++i) {
+        naive += small;
+        sum += small;
+    }
+    double const exact = 1 + double(count) * small;
+    BOOST_CHECK_EQUAL( naive, 1.f );
+    BOOST_CHECK_CLOSE_FRACTION( sum(), exact, std::numeric_limits<float>::epsilon() );
+}
+
+/**
+ * combine partial sums, including their errors
+ */
+BOOST_AUTO_TEST_CASE( partial_sums )
+{
+    unsigned int const count = 100000;
+    unsigned int const nblock = 7;
+    double const value = 0.1;
+
+    kahan_sum<double> total;
+    for (unsigned int j = 0; j < nblock; ++j) {
+        kahan_sum<double> partial;
+        for (unsigned int i = 0; i < count; ++i) {
+            partial += value;
+        }
+        total += partial;
+    }
+    BOOST_CHECK_CLOSE_FRACTION( total(), nblock * count * value, 2 * std::numeric_limits<double>::epsilon() );
+}
+
+/**
+ * element-wise summation of vectors
+ */
+BOOST_AUTO_TEST_CASE( vector )
+{
+    typedef fixed_vector<float, 3> vector_type;
+    unsigned int const count = 1000000;
+    float const eps = std::numeric_limits<float>::epsilon();
+
+    vector_type small;
+    small[0] = eps / 4;
+    small[1] = -eps / 8;
+    small[2] = 0;
+
+    kahan_sum<vector_type> sum;
+    sum += vector_type(1);
+    for (unsigned int i = 0; i < count; ++i) {
+        sum += small;
+    }
+    vector_type result = sum();
+    BOOST_CHECK_CLOSE_FRACTION( result[0], 1 + double(count) * small[0], eps );
+    BOOST_CHECK_CLOSE_FRACTION( result[1], 1 + double(count) * small[1], eps );
+    BOOST_CHECK_EQUAL( result[2], 1.f );
+}
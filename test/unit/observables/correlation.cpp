@@ -0,0 +1,206 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE correlation
+#include <boost/test/unit_test.hpp>
+
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/observables/dynamics/blocking_scheme.hpp>
+#include <halmd/observables/dynamics/correlation.hpp>
+#include <halmd/observables/host/dynamics/mean_square_displacement.hpp>
+#include <halmd/observables/samples/blocking_scheme.hpp>
+#include <test/tools/ctest.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+using namespace halmd;
+
+typedef observables::host::dynamics::mean_square_displacement<3, double> tcf_type;
+typedef observables::dynamics::correlation<tcf_type> correlation_type;
+typedef tcf_type::sample_type sample_type;
+
+/**
+ * Random walk of particles, sampled by a blocking scheme that computes the
+ * mean-square displacement with the given number of worker threads.
+ */
+static std::shared_ptr<correlation_type> random_walk(unsigned int nthread)
+{
+    unsigned int const nparticle = 100;
+    unsigned int const nstep = 5000;
+    double const timestep = 0.01;
+
+    auto clock = std::make_shared<mdsim::clock>();
+    clock->set_timestep(timestep);
+    auto blocking = std::make_shared<observables::dynamics::blocking_scheme>(
+        clock, 1000 * timestep, timestep, 10, 3, 5, nthread
+    );
+
+    // identical random walks for all numbers of threads
+    std::mt19937 gen(42);
+    std::normal_distribution<double> dist;
+    std::vector<sample_type::data_type> position(nparticle, sample_type::data_type(0));
+    auto acquire = [&]() {
+        auto sample = std::make_shared<sample_type>(std::size_t(nparticle));
+        std::copy(position.begin(), position.end(), sample->data().begin());
+        return std::shared_ptr<sample_type const>(sample);
+    };
+
+    auto block_sample = std::make_shared<observables::samples::blocking_scheme<sample_type>>(
+        acquire, blocking->count(), blocking->block_size()
+    );
+    auto tcf = std::make_shared<correlation_type>(std::make_shared<tcf_type>(), block_sample, block_sample);
+    blocking->on_sample(block_sample);
+    blocking->on_correlate(tcf);
+
+    for (unsigned int step = 0; step < nstep; ++step) {
+        blocking->sample();
+        for (auto& r : position) {
+            for (unsigned int j = 0; j < r.size(); ++j) {
+                r[j] += dist(gen);
+            }
+        }
+        clock->advance();
+    }
+    blocking->finalise();
+    return tcf;
+}
+
+/**
+ * The correlations computed concurrently to the simulation are identical to
+ * those computed in the calling thread.
+ */
+BOOST_AUTO_TEST_CASE( concurrent )
+{
+    auto serial = random_walk(0);
+    auto const& reference = serial->result();
+    for (unsigned int nthread : {1, 2, 4}) {
+        BOOST_TEST_MESSAGE("compute correlations using " << nthread << " thread(s)");
+        auto concurrent = random_walk(nthread);
+        auto const& mean_value = correlation_type::get_mean(concurrent)();
+        auto const& result = concurrent->result();
+        BOOST_REQUIRE( result.num_elements() == reference.num_elements() );
+        for (unsigned int i = 0; i < result.shape()[0]; ++i) {
+            for (unsigned int j = 0; j < result.shape()[1]; ++j) {
+                BOOST_CHECK_EQUAL( count(result[i][j]), count(reference[i][j]) );
+                // skip lag times beyond the simulation length
+                if (count(reference[i][j]) > 0) {
+                    BOOST_CHECK_EQUAL( mean_value[i][j], mean(reference[i][j]) );
+                    BOOST_CHECK_EQUAL( variance(result[i][j]), variance(reference[i][j]) );
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Correlation function whose first task waits for the first task of the
+ * other probes to start.
+ */
+class probe
+  : public observables::dynamics::correlation_base
+{
+public:
+    struct rendezvous
+    {
+        std::mutex mutex;
+        std::condition_variable arrived;
+        unsigned int count = 0;
+    };
+
+    probe(std::shared_ptr<rendezvous> meet, unsigned int nprobe)
+      : meet_(meet), nprobe_(nprobe), first_(true), met_(false) {}
+
+    virtual void compute(unsigned int) {}
+
+    virtual task_type task(unsigned int)
+    {
+        if (!first_) {
+            return task_type{0, nullptr};
+        }
+        first_ = false;
+        return task_type{1, [this](std::size_t) {
+            std::unique_lock<std::mutex> lock(meet_->mutex);
+            ++meet_->count;
+            meet_->arrived.notify_all();
+            met_ = meet_->arrived.wait_for(lock, std::chrono::seconds(10), [&]() {
+                return meet_->count == nprobe_;
+            });
+        }};
+    }
+
+    /** returns true if the other probes were running at the same time */
+    bool met() const
+    {
+        return met_;
+    }
+
+private:
+    std::shared_ptr<rendezvous> meet_;
+    unsigned int nprobe_;
+    bool first_;
+    bool met_;
+};
+
+/**
+ * The correlation functions are computed concurrently to each other.
+ */
+BOOST_AUTO_TEST_CASE( concurrent_functions )
+{
+    unsigned int const nprobe = 2;
+    double const timestep = 0.01;
+
+    auto clock = std::make_shared<mdsim::clock>();
+    clock->set_timestep(timestep);
+    auto blocking = std::make_shared<observables::dynamics::blocking_scheme>(
+        clock, 100 * timestep, timestep, 10, 3, 5, nprobe
+    );
+    auto acquire = []() {
+        return std::shared_ptr<sample_type const>(std::make_shared<sample_type>(std::size_t(1)));
+    };
+    auto block_sample = std::make_shared<observables::samples::blocking_scheme<sample_type>>(
+        acquire, blocking->count(), blocking->block_size()
+    );
+    blocking->on_sample(block_sample);
+
+    auto meet = std::make_shared<probe::rendezvous>();
+    std::vector<std::shared_ptr<probe>> probes;
+    for (unsigned int i = 0; i < nprobe; ++i) {
+        probes.push_back(std::make_shared<probe>(meet, nprobe));
+        blocking->on_correlate(probes.back());
+    }
+
+    // fill the first block, which submits the tasks of all probes
+    for (unsigned int step = 0; step < blocking->block_size(); ++step) {
+        blocking->sample();
+        clock->advance();
+    }
+    blocking->finalise();
+
+    for (auto const& p : probes) {
+        BOOST_CHECK( p->met() );
+    }
+}
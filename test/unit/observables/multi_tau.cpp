@@ -0,0 +1,151 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE multi_tau
+#include <boost/test/unit_test.hpp>
+
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/observables/host/dynamics/mean_square_displacement.hpp>
+#include <halmd/observables/host/dynamics/multi_tau.hpp>
+#include <halmd/observables/host/samples/sample.hpp>
+#include <test/tools/ctest.hpp>
+
+#include <memory>
+#include <stdexcept>
+
+using namespace halmd;
+
+typedef observables::host::dynamics::mean_square_displacement<3, double> tcf_type;
+typedef observables::host::dynamics::multi_tau<tcf_type> multi_tau_type;
+typedef tcf_type::sample_type sample_type;
+
+/**
+ * Ballistic motion of particles with distinct velocities, for which the
+ * mean-square displacement is ⟨v²⟩ t², both for decimated and for block
+ * averaged positions.
+ */
+struct ballistic
+{
+    static unsigned int const nparticle = 10;
+    static constexpr double timestep = 0.01;
+
+    std::shared_ptr<mdsim::clock> clock;
+    double mean_v2;
+
+    ballistic()
+      : clock(std::make_shared<mdsim::clock>())
+      , mean_v2(0)
+    {
+        clock->set_timestep(timestep);
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            mean_v2 += inner_prod(velocity(i), velocity(i)) / nparticle;
+        }
+    }
+
+    static sample_type::data_type velocity(unsigned int i)
+    {
+        sample_type::data_type v;
+        v[0] = i;
+        v[1] = 1 - 0.5 * i;
+        v[2] = 0.25;
+        return v;
+    }
+
+    std::shared_ptr<sample_type const> acquire() const
+    {
+        auto sample = std::make_shared<sample_type>(std::size_t(nparticle));
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            sample->data()[i] = velocity(i) * clock->time();
+            sample->data()[i][0] += i;
+        }
+        return sample;
+    }
+
+    /** sample every step, and return the number of entries per level */
+    std::vector<unsigned int> run(multi_tau_type& tcf, unsigned int nsample, bool average)
+    {
+        for (unsigned int i = 0; i < nsample; ++i) {
+            tcf.sample();
+            clock->advance();
+        }
+        std::vector<unsigned int> nentry(tcf.count());
+        nentry[0] = nsample;
+        for (unsigned int l = 1; l < tcf.count(); ++l) {
+            unsigned int B = tcf.block_size();
+            nentry[l] = average ? nentry[l - 1] / B : (nentry[l - 1] + B - 1) / B;
+        }
+        return nentry;
+    }
+};
+
+static void check_ballistic(bool average)
+{
+    ballistic sys;
+    unsigned int const block_size = 4;
+    unsigned int const nsample = 1000;
+    multi_tau_type tcf(
+        [&]() { return sys.acquire(); }
+      , sys.clock
+      , 64 * ballistic::timestep
+      , ballistic::timestep
+      , block_size
+      , average
+    );
+    // intervals 1, 4, 16, 64
+    BOOST_CHECK_EQUAL( tcf.count(), 4u );
+    BOOST_CHECK_EQUAL( tcf.block_size(), block_size );
+
+    std::vector<unsigned int> nentry = sys.run(tcf, nsample, average);
+    auto const& time = tcf.time();
+    auto const& result = tcf.result();
+    for (unsigned int l = 0; l < tcf.count(); ++l) {
+        for (unsigned int j = 0; j < block_size; ++j) {
+            double t = time[l][j];
+            BOOST_CHECK_CLOSE_FRACTION( t, std::pow(block_size, l) * j * ballistic::timestep, 1e-12 );
+            // each entry serves as time origin for all particles
+            BOOST_CHECK_EQUAL( count(result[l][j]), ballistic::nparticle * (nentry[l] - j) );
+            BOOST_CHECK_SMALL( mean(result[l][j]) - sys.mean_v2 * t * t, 1e-10 * (1 + t * t) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( decimation )
+{
+    check_ballistic(false);
+}
+
+BOOST_AUTO_TEST_CASE( block_average )
+{
+    check_ballistic(true);
+}
+
+BOOST_AUTO_TEST_CASE( invalid_arguments )
+{
+    ballistic sys;
+    auto acquire = [&]() { return sys.acquire(); };
+    // block size too small
+    BOOST_CHECK_THROW( multi_tau_type(acquire, sys.clock, 1, 0.01, 1, false), std::invalid_argument );
+    // resolution below time step
+    BOOST_CHECK_THROW( multi_tau_type(acquire, sys.clock, 1, 0.001, 4, false), std::invalid_argument );
+    // maximum lag time below resolution
+    BOOST_CHECK_THROW( multi_tau_type(acquire, sys.clock, 0.01, 0.1, 4, false), std::invalid_argument );
+}
@@ -0,0 +1,283 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE radial_distribution_function
+#include <boost/test/unit_test.hpp>
+
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/host/binning.hpp>
+#include <halmd/mdsim/host/max_displacement.hpp>
+#include <halmd/mdsim/host/neighbours/from_particle.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/observables/host/radial_distribution_function.hpp>
+#include <halmd/utility/thread_pool.hpp>
+#include <test/tools/ctest.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace halmd;
+
+/**
+ * Binary mixture of particles at random positions
+ */
+template <int dimension>
+struct random_mixture
+{
+#ifndef USE_HOST_SINGLE_PRECISION
+    typedef double float_type;
+#else
+    typedef float float_type;
+#endif
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef typename particle_type::vector_type vector_type;
+    typedef mdsim::host::binning<dimension, float_type> binning_type;
+    typedef mdsim::host::max_displacement<dimension, float_type> displacement_type;
+    typedef mdsim::host::neighbours::from_particle<dimension, float_type> neighbour_type;
+    typedef observables::host::radial_distribution_function<dimension, float_type> rdf_type;
+    typedef typename binning_type::matrix_type matrix_type;
+    typedef utility::thread_pool thread_pool_type;
+
+    static double constexpr r_max = 2.5;
+    static unsigned int const nbin = 25;
+
+    std::shared_ptr<box_type> box;
+    std::shared_ptr<particle_type> particle;
+    std::shared_ptr<thread_pool_type> thread_pool;
+    std::mt19937 gen;
+
+    random_mixture(unsigned int nparticle)
+      : thread_pool(std::make_shared<thread_pool_type>(3))
+      , gen(42)
+    {
+        typename box_type::matrix_type edges = boost::numeric::ublas::zero_matrix<double>(dimension, dimension);
+        for (int i = 0; i < dimension; ++i) {
+            edges(i, i) = 10 + 2 * i;
+        }
+        box = std::make_shared<box_type>(edges);
+        particle = std::make_shared<particle_type>(nparticle, 2);
+
+        auto species = make_cache_mutable(particle->species());
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            (*species)[i] = (i % 5 == 0) ? 1 : 0;
+        }
+    }
+
+    /** place particles uniformly within the periodic box */
+    void shuffle()
+    {
+        std::uniform_real_distribution<double> uniform(-0.5, 0.5);
+        auto position = make_cache_mutable(particle->position());
+        for (auto& r : *position) {
+            for (int j = 0; j < dimension; ++j) {
+                r[j] = uniform(gen) * box->length()[j];
+            }
+        }
+    }
+
+    /** histogram all pairs of particles by direct summation */
+    boost::multi_array<double, 2> histogram() const
+    {
+        auto const& position = read_cache(particle->position());
+        auto const& species = read_cache(particle->species());
+        boost::multi_array<double, 2> result(boost::extents[3][nbin]);
+        std::fill(result.data(), result.data() + result.num_elements(), 0);
+        for (unsigned int i = 0; i < particle->nparticle(); ++i) {
+            for (unsigned int j = i + 1; j < particle->nparticle(); ++j) {
+                vector_type r = position[i] - position[j];
+                box->reduce_periodic(r);
+                float_type rr = inner_prod(r, r);
+                if (rr < r_max * r_max) {
+                    unsigned int bin = static_cast<unsigned int>(std::sqrt(rr) * (nbin / r_max));
+                    if (bin < nbin) {
+                        result[species[i] + species[j]][bin] += 1;
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    /** returns number of particles of species a */
+    double count(unsigned int a) const
+    {
+        auto const& species = read_cache(particle->species());
+        return std::count(species.begin(), species.end(), a);
+    }
+
+    /** convert histogram of pair counts to radial distribution function */
+    void normalise(boost::multi_array<double, 2>& hist) const
+    {
+        double N0 = count(0);
+        double N1 = count(1);
+        double npair[3] = { N0 * (N0 - 1) / 2, N0 * N1, N1 * (N1 - 1) / 2 };
+        double unit_volume = (dimension == 3) ? 4 * M_PI / 3 : M_PI;
+        double dr = r_max / nbin;
+        for (unsigned int pair = 0; pair < 3; ++pair) {
+            for (unsigned int k = 0; k < nbin; ++k) {
+                double shell = unit_volume * (std::pow((k + 1) * dr, dimension) - std::pow(k * dr, dimension));
+                hist[pair][k] *= box->volume() / npair[pair] / shell;
+            }
+        }
+    }
+};
+
+template <int dimension>
+double constexpr random_mixture<dimension>::r_max;
+
+/**
+ * Compare results from neighbour lists and from cell lists with direct
+ * summation over all pairs.
+ */
+template <int dimension>
+static void test_pair_enumeration()
+{
+    typedef random_mixture<dimension> fixture_type;
+    typedef typename fixture_type::rdf_type rdf_type;
+    typedef typename fixture_type::matrix_type matrix_type;
+
+    fixture_type sys(1000);
+    auto particle = sys.particle;
+    auto box = sys.box;
+    unsigned int nbin = fixture_type::nbin;
+    double r_max = fixture_type::r_max;
+
+    // neighbour lists with cutoff radius r_max
+    matrix_type r_cut(2, 2);
+    std::fill(r_cut.data().begin(), r_cut.data().end(), r_max);
+    auto displacement = std::make_shared<typename fixture_type::displacement_type>(particle, box);
+    auto neighbour = std::make_shared<typename fixture_type::neighbour_type>(
+        particle, particle, std::make_pair(displacement, displacement), box, r_cut, 0.3
+    );
+    // cell lists with sufficiently large cells
+    auto binning = std::make_shared<typename fixture_type::binning_type>(particle, box, r_cut, 0.3, sys.thread_pool);
+    // cell lists with too small cells, which are discarded
+    matrix_type r_small(1, 1);
+    r_small(0, 0) = 1;
+    auto small_binning = std::make_shared<typename fixture_type::binning_type>(particle, box, r_small, 0, sys.thread_pool);
+
+    std::vector<std::shared_ptr<rdf_type>> rdf = {
+        std::make_shared<rdf_type>(particle, box, r_max, nbin, neighbour, nullptr, sys.thread_pool)
+      , std::make_shared<rdf_type>(particle, box, r_max, nbin, nullptr, binning, sys.thread_pool)
+      , std::make_shared<rdf_type>(particle, box, r_max, nbin, nullptr, small_binning, sys.thread_pool)
+      , std::make_shared<rdf_type>(particle, box, r_max, nbin, nullptr, nullptr, sys.thread_pool)
+    };
+    BOOST_CHECK_EQUAL( rdf[0]->npair(), 3u );
+    BOOST_CHECK_CLOSE_FRACTION( rdf[0]->position()[0], r_max / nbin / 2, 1e-12 );
+
+    unsigned int const nsample = 3;
+    boost::multi_array<double, 2> mean(boost::extents[3][nbin]);
+    std::fill(mean.data(), mean.data() + mean.num_elements(), 0);
+    for (unsigned int n = 0; n < nsample; ++n) {
+        sys.shuffle();
+        boost::multi_array<double, 2> hist = sys.histogram();
+        sys.normalise(hist);
+        for (unsigned int pair = 0; pair < 3; ++pair) {
+            for (unsigned int k = 0; k < nbin; ++k) {
+                mean[pair][k] += hist[pair][k] / nsample;
+            }
+        }
+        for (auto const& g : rdf) {
+            g->sample();
+        }
+    }
+
+    for (auto const& g : rdf) {
+        BOOST_CHECK_EQUAL( g->count(), nsample );
+        auto const& value = g->value();
+        for (unsigned int pair = 0; pair < 3; ++pair) {
+            for (unsigned int k = 0; k < nbin; ++k) {
+                BOOST_CHECK_CLOSE_FRACTION( value[pair][k], mean[pair][k], 1e-12 );
+            }
+        }
+    }
+
+    rdf[0]->reset();
+    BOOST_CHECK_EQUAL( rdf[0]->count(), 0u );
+}
+
+/**
+ * Uniformly distributed particles have g(r) = 1.
+ */
+template <int dimension>
+static void test_ideal_gas()
+{
+    typedef random_mixture<dimension> fixture_type;
+    typedef typename fixture_type::rdf_type rdf_type;
+
+    fixture_type sys(1000);
+    rdf_type rdf(sys.particle, sys.box, fixture_type::r_max, fixture_type::nbin, nullptr, nullptr, sys.thread_pool);
+
+    unsigned int const nsample = 20;
+    for (unsigned int n = 0; n < nsample; ++n) {
+        sys.shuffle();
+        rdf.sample();
+    }
+    auto const& value = rdf.value();
+    auto const& error = rdf.error();
+    for (unsigned int pair = 0; pair < 3; ++pair) {
+        // skip the innermost bins with few pairs
+        for (unsigned int k = fixture_type::nbin / 2; k < fixture_type::nbin; ++k) {
+            BOOST_CHECK_GT( error[pair][k], 0 );
+            BOOST_CHECK_SMALL( value[pair][k] - 1, 5 * error[pair][k] );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( pair_enumeration_2d )
+{
+    test_pair_enumeration<2>();
+}
+
+BOOST_AUTO_TEST_CASE( pair_enumeration_3d )
+{
+    test_pair_enumeration<3>();
+}
+
+BOOST_AUTO_TEST_CASE( ideal_gas_2d )
+{
+    test_ideal_gas<2>();
+}
+
+BOOST_AUTO_TEST_CASE( ideal_gas_3d )
+{
+    test_ideal_gas<3>();
+}
+
+BOOST_AUTO_TEST_CASE( invalid_arguments )
+{
+    typedef random_mixture<3> fixture_type;
+    typedef fixture_type::rdf_type rdf_type;
+
+    fixture_type sys(10);
+    // no bins
+    BOOST_CHECK_THROW( rdf_type(sys.particle, sys.box, 2, 0), std::invalid_argument );
+    // non-positive maximum distance
+    BOOST_CHECK_THROW( rdf_type(sys.particle, sys.box, 0, 10), std::invalid_argument );
+    // maximum distance exceeds half the box
+    BOOST_CHECK_THROW( rdf_type(sys.particle, sys.box, 5.5, 10), std::invalid_argument );
+}
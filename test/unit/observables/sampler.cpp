@@ -0,0 +1,260 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE sampler
+#include <boost/test/unit_test.hpp>
+
+#include <halmd/mdsim/clock.hpp>
+#include <halmd/mdsim/core.hpp>
+#include <halmd/observables/sampler.hpp>
+#include <test/tools/ctest.hpp>
+
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace halmd;
+
+typedef observables::sampler::step_type step_type;
+
+/**
+ * Sampler with slots that record the steps at which they are invoked.
+ */
+struct fixture
+{
+    std::shared_ptr<mdsim::clock> clock;
+    std::shared_ptr<mdsim::core> core;
+    std::shared_ptr<observables::sampler> sampler;
+    /** number of MD integration steps */
+    step_type nstep;
+
+    fixture()
+      : clock(std::make_shared<mdsim::clock>())
+      , core(std::make_shared<mdsim::core>())
+      , sampler(std::make_shared<observables::sampler>(clock, core))
+      , nstep(0)
+    {
+        clock->set_timestep(0.001);
+        core->on_integrate([&]() { ++nstep; });
+    }
+
+    /** connect slot that records the current step to the given array */
+    std::function<void ()> record(std::vector<step_type>& steps)
+    {
+        return [&]() { steps.push_back(clock->step()); };
+    }
+
+    /** returns steps in (first, last] at which a slot with given interval and start is due */
+    static std::vector<step_type> due(step_type first, step_type last, step_type interval, step_type start)
+    {
+        std::vector<step_type> steps;
+        for (step_type step = first + 1; step <= last; ++step) {
+            if (step >= start && (step - start) % interval == 0) {
+                steps.push_back(step);
+            }
+        }
+        return steps;
+    }
+};
+
+/**
+ * Compare slots invoked by run() with a test of every step.
+ */
+BOOST_FIXTURE_TEST_CASE( periodic, fixture )
+{
+    std::vector<step_type> const interval = {1, 3, 7, 10, 1000};
+    std::vector<step_type> const start = {0, 5, 2, 20, 100};
+    std::vector<std::vector<step_type>> prepare(interval.size());
+    std::vector<std::vector<step_type>> sample(interval.size());
+
+    for (unsigned int i = 1; i < interval.size(); ++i) {
+        sampler->on_prepare(record(prepare[i]), interval[i], start[i]);
+        sampler->on_sample(record(sample[i]), interval[i], start[i]);
+    }
+    BOOST_CHECK_EQUAL( sampler->next_event_step(), 2u );
+
+    sampler->run(50);
+    sampler->run(73);
+    BOOST_CHECK_EQUAL( nstep, 123u );
+    BOOST_CHECK_EQUAL( clock->step(), 123u );
+    BOOST_CHECK_EQUAL( sampler->next_event_step(), 125u );
+
+    for (unsigned int i = 1; i < interval.size(); ++i) {
+        std::vector<step_type> steps = due(0, 123, interval[i], start[i]);
+        BOOST_CHECK_EQUAL_COLLECTIONS( prepare[i].begin(), prepare[i].end(), steps.begin(), steps.end() );
+        BOOST_CHECK_EQUAL_COLLECTIONS( sample[i].begin(), sample[i].end(), steps.begin(), steps.end() );
+    }
+
+    // a slot connected for every step is due at each step
+    sampler->on_sample(record(sample[0]), interval[0], start[0]);
+    BOOST_CHECK_EQUAL( sampler->next_event_step(), 124u );
+    sampler->run(10);
+    std::vector<step_type> steps = due(123, 133, interval[0], start[0]);
+    BOOST_CHECK_EQUAL_COLLECTIONS( sample[0].begin(), sample[0].end(), steps.begin(), steps.end() );
+}
+
+/**
+ * Slots due at the same step are invoked in the order of connection.
+ */
+BOOST_FIXTURE_TEST_CASE( order, fixture )
+{
+    std::vector<unsigned int> order;
+    for (unsigned int i = 0; i < 5; ++i) {
+        sampler->on_sample([&, i]() { order.push_back(i); }, i % 2 ? 4 : 2, 0);
+    }
+    sampler->run(4);
+    std::vector<unsigned int> expected = {0, 2, 4, 0, 1, 2, 3, 4};
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), expected.begin(), expected.end() );
+}
+
+/**
+ * sample() invokes the slots due at the current step, which does not affect
+ * the schedule of run().
+ */
+BOOST_FIXTURE_TEST_CASE( sample, fixture )
+{
+    std::vector<step_type> prepare, sample;
+    sampler->on_prepare(record(prepare), 5, 0);
+    sampler->on_sample(record(sample), 5, 0);
+    sampler->on_sample([]() { BOOST_FAIL("slot must not be invoked"); }, 5, 11);
+
+    sampler->sample();
+    sampler->run(10);
+    sampler->sample();
+    BOOST_CHECK_EQUAL( nstep, 10u );
+
+    std::vector<step_type> steps = {0, 5, 10, 10};
+    BOOST_CHECK_EQUAL_COLLECTIONS( prepare.begin(), prepare.end(), steps.begin(), steps.end() );
+    BOOST_CHECK_EQUAL_COLLECTIONS( sample.begin(), sample.end(), steps.begin(), steps.end() );
+}
+
+/**
+ * Disconnected slots are no longer invoked, and slots remain scheduled
+ * correctly if the clock was advanced outside of run().
+ */
+BOOST_FIXTURE_TEST_CASE( disconnect, fixture )
+{
+    std::vector<step_type> first, second;
+    connection conn = sampler->on_sample(record(first), 4, 0);
+    sampler->on_sample(record(second), 6, 0);
+
+    sampler->run(8);
+    conn.disconnect();
+    BOOST_CHECK( !conn.connected() );
+    sampler->run(8);
+
+    // advance clock without sampler
+    for (unsigned int i = 0; i < 7; ++i) {
+        clock->advance();
+    }
+    sampler->run(7);
+    BOOST_CHECK_EQUAL( clock->step(), 30u );
+    BOOST_CHECK_EQUAL( nstep, 23u );
+
+    std::vector<step_type> steps = {4, 8};
+    BOOST_CHECK_EQUAL_COLLECTIONS( first.begin(), first.end(), steps.begin(), steps.end() );
+    steps = {6, 12, 24, 30};
+    BOOST_CHECK_EQUAL_COLLECTIONS( second.begin(), second.end(), steps.begin(), steps.end() );
+}
+
+/**
+ * In compiled mode, the stages of the MD step are invoked in the same order
+ * and at the same steps as by signal dispatch.
+ */
+static std::vector<std::pair<unsigned int, step_type>> record_stages(bool compiled)
+{
+    fixture f;
+    f.core->set_compiled(compiled);
+    BOOST_CHECK_EQUAL( f.core->compiled(), compiled );
+
+    std::vector<std::pair<unsigned int, step_type>> stages;
+    auto record = [&](unsigned int stage) {
+        return [&, stage]() { stages.emplace_back(stage, f.clock->step()); };
+    };
+    f.core->on_prepend_integrate(record(0));
+    f.core->on_integrate(record(1));
+    f.core->on_append_integrate(record(2));
+    f.core->on_prepend_finalize(record(3));
+    f.core->on_finalize(record(4));
+    f.core->on_append_finalize(record(5));
+    f.core->on_finalize(record(6));
+    f.sampler->on_prepare([&]() { stages.emplace_back(7, f.clock->step()); }, 10, 5);
+    f.sampler->on_sample([&]() { stages.emplace_back(8, f.clock->step()); }, 7, 0);
+
+    f.sampler->run(20);
+    f.sampler->run(25);
+    BOOST_CHECK_EQUAL( f.nstep, 45u );
+    return stages;
+}
+
+BOOST_AUTO_TEST_CASE( compiled )
+{
+    std::vector<std::pair<unsigned int, step_type>> signals = record_stages(false);
+    std::vector<std::pair<unsigned int, step_type>> compiled = record_stages(true);
+    BOOST_CHECK_EQUAL( signals.size(), 45u * 7 + 5 + 6 );
+    BOOST_CHECK( compiled == signals );
+}
+
+/**
+ * Without periodic slots, run() performs the integration steps only.
+ */
+BOOST_FIXTURE_TEST_CASE( empty, fixture )
+{
+    BOOST_CHECK_EQUAL( sampler->next_event_step(), std::numeric_limits<step_type>::max() );
+    sampler->run(100);
+    BOOST_CHECK_EQUAL( nstep, 100u );
+    BOOST_CHECK_EQUAL( clock->step(), 100u );
+    BOOST_CHECK_THROW( sampler->on_sample([]() {}, 0, 0), std::logic_error );
+    BOOST_CHECK_THROW( sampler->on_prepare([]() {}, 0, 0), std::logic_error );
+}
+
+/**
+ * Slots connected with on_poll() are invoked after a wall-clock period.
+ */
+BOOST_FIXTURE_TEST_CASE( poll, fixture )
+{
+    BOOST_CHECK_THROW( sampler->set_poll_period(0), std::logic_error );
+    sampler->set_poll_period(0.01);
+    BOOST_CHECK_EQUAL( sampler->poll_period(), 0.01 );
+
+    // each step takes at least 1 ms, thus polls are at most 10 steps apart
+    core->on_integrate([]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); });
+    std::vector<step_type> steps;
+    sampler->on_poll(record(steps));
+    sampler->run(200);
+    BOOST_CHECK_EQUAL( nstep, 200u );
+
+    BOOST_REQUIRE( steps.size() >= 20u );
+    BOOST_CHECK_EQUAL( steps[0], 1u );
+    for (unsigned int i = 1; i < steps.size(); ++i) {
+        step_type interval = steps[i] - steps[i - 1];
+        BOOST_CHECK( interval >= 1u && interval <= 10u );
+        if (i > 1) {
+            BOOST_CHECK( interval <= 2 * (steps[i - 1] - steps[i - 2]) );
+        }
+    }
+    BOOST_TEST_MESSAGE( steps.size() << " polls within " << nstep << " steps" );
+}
@@ -32,6 +32,8 @@
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <random>
+#include <tuple>
 
 #include <halmd/mdsim/box.hpp>
 #include <halmd/mdsim/host/particle.hpp>
@@ -39,8 +41,10 @@
 #include <halmd/mdsim/host/positions/lattice.hpp>
 #include <halmd/numeric/accumulator.hpp>
 #include <halmd/observables/host/density_mode.hpp>
+#include <halmd/observables/host/density_mode_mesh.hpp>
 #include <halmd/observables/ssf.hpp>
 #include <halmd/observables/utility/wavevector.hpp>
+#include <halmd/utility/thread_pool.hpp>
 #ifdef HALMD_WITH_GPU
 # include <halmd/mdsim/gpu/particle.hpp>
 # include <halmd/mdsim/gpu/particle_groups/all.hpp>
@@ -375,6 +379,167 @@ BOOST_AUTO_TEST_CASE( ssf_host_3d ) {
 }
 #endif
 
+/**
+ * compare density modes of the host module, computed by complex recurrences
+ * and with several threads, to the direct summation of exponentials
+ */
+template <int dimension, typename float_type>
+void density_mode_threads()
+{
+    typedef host_modules<dimension, float_type> modules_type;
+    typedef typename modules_type::particle_type particle_type;
+    typedef typename modules_type::particle_group_type particle_group_type;
+    typedef typename modules_type::density_mode_type density_mode_type;
+    typedef typename particle_type::vector_type vector_type;
+    typedef observables::utility::wavevector<dimension> wavevector_type;
+
+    unsigned int const npart = 1000;
+    fixed_vector<double, dimension> length;
+    for (unsigned int i = 0; i < dimension; ++i) {
+        length[i] = 10 + 3 * i;
+    }
+
+    // quasi-random positions, partially outside of the periodic box
+    std::vector<vector_type> r_list(npart);
+    for (unsigned int j = 0; j < npart; ++j) {
+        for (unsigned int i = 0; i < dimension; ++i) {
+            double x = fmod(j * (0.6180339887 + 0.1 * i), 1.);
+            r_list[j][i] = (1.5 * x - 0.25) * length[i];
+        }
+    }
+    auto particle = std::make_shared<particle_type>(npart, 1);
+    BOOST_CHECK( set_position(*particle, r_list.begin()) == r_list.end() );
+
+    // dense grid of wavevectors, including negative Miller indices
+    auto wavevector = std::make_shared<wavevector_type>(
+        std::vector<double>{1., 2., 4.}
+      , length
+      , typename wavevector_type::filter_type(1)
+    );
+    auto const& q = wavevector->value();
+    BOOST_TEST_MESSAGE("#wavevectors: " << q.size());
+
+    for (unsigned int nthread : {1, 3, 4}) {
+        auto density_mode = std::make_shared<density_mode_type>(
+            particle
+          , std::make_shared<particle_group_type>(particle)
+          , wavevector
+          , std::make_shared<utility::thread_pool>(nthread)
+        );
+        auto rho = density_mode->acquire();
+        BOOST_CHECK_EQUAL( rho->size(), q.size() );
+
+        for (unsigned int k = 0; k < q.size(); ++k) {
+            complex<double> rho_ref = 0;
+            for (auto const& r : r_list) {
+                double q_r = inner_prod(static_cast<fixed_vector<double, dimension>>(r), q[k]);
+                rho_ref += complex<double>(cos(q_r), -sin(q_r));
+            }
+            double tolerance = 1e-12 * npart * (1 + norm_2(q[k]) * norm_2(length));
+            BOOST_CHECK_SMALL( (*rho)[k][0] - rho_ref.real(), tolerance );
+            BOOST_CHECK_SMALL( (*rho)[k][1] - rho_ref.imag(), tolerance );
+        }
+    }
+}
+
+#ifndef USE_HOST_SINGLE_PRECISION
+BOOST_AUTO_TEST_CASE( density_mode_host_2d ) {
+    density_mode_threads<2, double>();
+}
+BOOST_AUTO_TEST_CASE( density_mode_host_3d ) {
+    density_mode_threads<3, double>();
+}
+#endif
+
+/**
+ * compare density modes from the mesh assignment with those from direct
+ * summation, the deviations are due to aliasing
+ */
+template <int dimension, typename float_type>
+void density_mode_mesh()
+{
+    typedef host_modules<dimension, float_type> modules_type;
+    typedef typename modules_type::particle_type particle_type;
+    typedef typename modules_type::particle_group_type particle_group_type;
+    typedef typename modules_type::density_mode_type density_mode_type;
+    typedef observables::host::density_mode_mesh<dimension, float_type> density_mode_mesh_type;
+    typedef typename particle_type::vector_type vector_type;
+    typedef observables::utility::wavevector<dimension> wavevector_type;
+
+    unsigned int const npart = 10000;
+    fixed_vector<double, dimension> length;
+    for (unsigned int i = 0; i < dimension; ++i) {
+        length[i] = 10 + 3 * i;
+    }
+
+    // random positions in the periodic box
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> uniform(-0.5, 0.5);
+    std::vector<vector_type> r_list(npart);
+    for (auto& r : r_list) {
+        for (unsigned int i = 0; i < dimension; ++i) {
+            r[i] = uniform(gen) * length[i];
+        }
+    }
+    auto particle = std::make_shared<particle_type>(npart, 1);
+    BOOST_CHECK( set_position(*particle, r_list.begin()) == r_list.end() );
+    auto group = std::make_shared<particle_group_type>(particle);
+
+    // dense grid of wavevectors, including negative Miller indices
+    auto wavevector = std::make_shared<wavevector_type>(
+        std::vector<double>{1., 2., 4.}
+      , length
+      , typename wavevector_type::filter_type(1)
+    );
+    auto const& q = wavevector->value();
+    auto rho_ref = std::make_shared<density_mode_type>(particle, group, wavevector)->acquire();
+
+    // typical magnitude of a density mode is √N, and the aliasing error
+    // decreases with the oversampling factor and the order of assignment
+    std::vector<std::tuple<unsigned int, unsigned int, double>> params = {
+        std::make_tuple(2, 2, 0.3)
+      , std::make_tuple(3, 2, 0.06)
+      , std::make_tuple(2, 4, 0.06)
+      , std::make_tuple(3, 4, 0.008)
+    };
+    for (auto const& param : params) {
+        auto density_mode = std::make_shared<density_mode_mesh_type>(
+            particle, group, wavevector, std::get<0>(param), std::get<1>(param)
+          , std::make_shared<utility::thread_pool>(3)
+        );
+        auto rho = density_mode->acquire();
+        BOOST_CHECK_EQUAL( rho->size(), q.size() );
+
+        double max_error = 0;
+        for (unsigned int k = 0; k < q.size(); ++k) {
+            max_error = max(max_error, norm_2((*rho)[k] - (*rho_ref)[k]) / sqrt(npart));
+        }
+        BOOST_TEST_MESSAGE("order " << std::get<0>(param) << ", oversampling " << std::get<1>(param)
+            << ", mesh " << density_mode->mesh_size() << ": maximum error " << max_error
+        );
+        BOOST_CHECK_SMALL( max_error, std::get<2>(param) );
+
+        // the assignment order does not depend on the number of threads
+        auto rho_serial = std::make_shared<density_mode_mesh_type>(
+            particle, group, wavevector, std::get<0>(param), std::get<1>(param)
+          , std::make_shared<utility::thread_pool>(1)
+        )->acquire();
+        for (unsigned int k = 0; k < q.size(); ++k) {
+            BOOST_CHECK_EQUAL( (*rho)[k][0], (*rho_serial)[k][0] );
+            BOOST_CHECK_EQUAL( (*rho)[k][1], (*rho_serial)[k][1] );
+        }
+    }
+}
+
+#ifndef USE_HOST_SINGLE_PRECISION
+BOOST_AUTO_TEST_CASE( density_mode_mesh_host_2d ) {
+    density_mode_mesh<2, double>();
+}
+BOOST_AUTO_TEST_CASE( density_mode_mesh_host_3d ) {
+    density_mode_mesh<3, double>();
+}
+#endif
+
 #ifdef HALMD_WITH_GPU
 template <int dimension, typename float_type>
 struct gpu_modules
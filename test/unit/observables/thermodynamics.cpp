@@ -0,0 +1,168 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE thermodynamics
+#include <boost/test/unit_test.hpp>
+
+#include <halmd/mdsim/box.hpp>
+#include <halmd/mdsim/host/particle.hpp>
+#include <halmd/mdsim/host/particle_group.hpp>
+#include <halmd/mdsim/host/particle_groups/all.hpp>
+#include <halmd/observables/host/thermodynamics.hpp>
+#include <halmd/utility/thread_pool.hpp>
+#include <test/tools/ctest.hpp>
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+#include <memory>
+#include <random>
+
+using namespace halmd;
+
+#ifndef USE_HOST_SINGLE_PRECISION
+typedef double float_type;
+#else
+typedef float float_type;
+#endif
+
+/**
+ * Compare the quantities of the fused reduction with the reference functions
+ * in particle_group.hpp, for random particle data and a mock force module.
+ *
+ * The quantities are requested in a different combination at each step, so
+ * that a pass includes the quantities requested during the previous step.
+ */
+template <int dimension>
+static void test_fused_reduction(unsigned int nthread)
+{
+    typedef mdsim::box<dimension> box_type;
+    typedef mdsim::host::particle<dimension, float_type> particle_type;
+    typedef mdsim::host::particle_groups::all<particle_type> particle_group_type;
+    typedef observables::host::thermodynamics<dimension, float_type> thermodynamics_type;
+    typedef typename particle_type::vector_type vector_type;
+
+    unsigned int const nparticle = 1000;
+    unsigned int const nstep = 9;
+    double const length = 10;
+    double const tolerance = 1e-10;
+
+    auto particle = std::make_shared<particle_type>(nparticle, 1);
+    typename box_type::matrix_type edges(dimension, dimension);
+    for (unsigned int i = 0; i < dimension; ++i) {
+        for (unsigned int j = 0; j < dimension; ++j) {
+            edges(i, j) = (i == j) ? length : 0;
+        }
+    }
+    auto box = std::make_shared<box_type>(edges);
+    auto group = std::make_shared<particle_group_type>(particle);
+    auto thermodynamics = std::make_shared<thermodynamics_type>(
+        particle, group, box, nullptr, std::make_shared<utility::thread_pool>(nthread)
+    );
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> uniform;
+
+    // mock force module, which depends on the positions only
+    cache<> position_cache;
+    unsigned int nforce = 0;
+    particle->on_prepend_force([&]() {
+        if (position_cache != particle->position()) {
+            particle->mark_force_dirty();
+            particle->mark_aux_dirty();
+        }
+    });
+    particle->on_force([&]() {
+        auto const& position = read_cache(particle->position());
+        auto force = make_cache_mutable(particle->mutable_force());
+        auto en_pot = make_cache_mutable(particle->mutable_potential_energy());
+        auto stress_pot = make_cache_mutable(particle->mutable_stress_pot());
+        for (unsigned int i = 0; i < nparticle; ++i) {
+            vector_type const& r = position[i];
+            (*force)[i] = element_prod(r, r) - vector_type(1);
+            (*en_pot)[i] = inner_prod(r, r);
+            for (unsigned int j = 0; j < (*stress_pot)[i].size(); ++j) {
+                (*stress_pot)[i][j] = r[j % dimension] + j;
+            }
+        }
+        position_cache = particle->position();
+        ++nforce;
+    });
+
+    for (unsigned int step = 0; step < nstep; ++step) {
+        {
+            auto position = make_cache_mutable(particle->position());
+            auto image = make_cache_mutable(particle->image());
+            auto velocity = make_cache_mutable(particle->velocity());
+            auto mass = make_cache_mutable(particle->mass());
+            for (unsigned int i = 0; i < nparticle; ++i) {
+                for (unsigned int j = 0; j < dimension; ++j) {
+                    (*position)[i][j] = length * (uniform(gen) - 0.5);
+                    (*image)[i][j] = std::floor(4 * uniform(gen) - 2);
+                    (*velocity)[i][j] = uniform(gen) - 0.25;
+                }
+                (*mass)[i] = 1 + uniform(gen);
+            }
+        }
+        BOOST_TEST_MESSAGE("step " << step);
+
+        if (step % 3 != 1) {
+            BOOST_CHECK_CLOSE_FRACTION( thermodynamics->en_kin(), get_mean_en_kin(*particle, *group), tolerance );
+        }
+        if (step % 3 != 2) {
+            auto r_cm = get_r_cm(*particle, *group, *box);
+            auto v_cm = get_v_cm(*particle, *group);
+            for (unsigned int j = 0; j < dimension; ++j) {
+                BOOST_CHECK_CLOSE_FRACTION( thermodynamics->r_cm()[j], r_cm[j], tolerance );
+                BOOST_CHECK_CLOSE_FRACTION( thermodynamics->v_cm()[j], v_cm[j], tolerance );
+            }
+            BOOST_CHECK_CLOSE_FRACTION( thermodynamics->mean_mass(), std::get<1>(get_v_cm_and_mean_mass(*particle, *group)), tolerance );
+        }
+        if (step % 3 != 0) {
+            BOOST_CHECK_CLOSE_FRACTION( thermodynamics->en_pot(), get_mean_en_pot(*particle, *group), tolerance );
+            BOOST_CHECK_CLOSE_FRACTION( thermodynamics->virial(), get_mean_virial(*particle, *group), tolerance );
+            auto force = get_total_force(*particle, *group);
+            auto stress_tensor = get_stress_tensor(*particle, *group);
+            for (unsigned int j = 0; j < dimension; ++j) {
+                BOOST_CHECK_CLOSE_FRACTION( thermodynamics->total_force()[j], force[j], tolerance );
+            }
+            for (unsigned int j = 0; j < stress_tensor.size(); ++j) {
+                BOOST_CHECK_CLOSE_FRACTION( thermodynamics->stress_tensor()[j], stress_tensor[j], tolerance );
+            }
+        }
+    }
+    // the forces are computed once per step in which they are requested
+    BOOST_CHECK_EQUAL( nforce, 2 * nstep / 3 );
+}
+
+BOOST_AUTO_TEST_CASE( fused_reduction_2d )
+{
+    for (unsigned int nthread : {1, 3}) {
+        test_fused_reduction<2>(nthread);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( fused_reduction_3d )
+{
+    for (unsigned int nthread : {1, 3}) {
+        test_fused_reduction<3>(nthread);
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <halmd/config.hpp>
+
+#define BOOST_TEST_MODULE philox
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <halmd/random/host/philox.hpp>
+#include <halmd/random/host/random.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd::random;
+
+/**
+ * Compare with known-answer tests of the reference implementation Random123.
+ */
+BOOST_AUTO_TEST_CASE( known_answer )
+{
+    struct {
+        unsigned int ctr[4];
+        unsigned int key[2];
+        unsigned int result[4];
+    } const kat[] = {
+        { { 0, 0, 0, 0 }, { 0, 0 }
+        , { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } }
+      , { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }
+        , { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } }
+      , { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 }
+        , { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } }
+    };
+    for (auto const& k : kat) {
+        philox_kernel::counter_type ctr;
+        philox_kernel::key_type key;
+        std::copy(k.ctr, k.ctr + 4, ctr.begin());
+        std::copy(k.key, k.key + 2, key.begin());
+        philox_kernel::counter_type result = philox_kernel::philox4x32(ctr, key);
+        for (unsigned int i = 0; i < 4; ++i) {
+            BOOST_CHECK_EQUAL( result[i], k.result[i] );
+        }
+    }
+}
+
+/**
+ * The stream of a particle depends only on the seed, the sequence and the
+ * subsequence, not on the order in which streams are drawn from, and the
+ * sequence depends only on the simulation step and the drawing module.
+ */
+BOOST_AUTO_TEST_CASE( streams )
+{
+    unsigned int const nsubsequence = 100;
+    unsigned int const count = 10;
+
+    typedef host::random::stream_id stream_id;
+
+    host::random random(42);
+    std::uint64_t sequence = host::random::sequence(1000, stream_id::boltzmann);
+    BOOST_CHECK_EQUAL( host::random::sequence(1000, stream_id::boltzmann), sequence );
+    BOOST_CHECK( host::random::sequence(1001, stream_id::boltzmann) != sequence );
+    BOOST_CHECK( host::random::sequence(1000, stream_id::verlet_nvt_andersen) != sequence );
+
+    // draw from streams in ascending order
+    std::vector<std::uint32_t> forward;
+    for (unsigned int i = 0; i < nsubsequence; ++i) {
+        host::philox rng = random.stream(sequence, i);
+        for (unsigned int j = 0; j < count; ++j) {
+            forward.push_back(rng());
+        }
+    }
+    // draw from streams in descending order, and compare
+    for (unsigned int i = nsubsequence; i-- > 0; ) {
+        host::philox rng = random.stream(sequence, i);
+        for (unsigned int j = 0; j < count; ++j) {
+            BOOST_CHECK_EQUAL( rng(), forward[i * count + j] );
+        }
+    }
+
+    // different sequences and seeds yield different streams
+    host::philox rng = random.stream(sequence + 1, 0);
+    BOOST_CHECK( rng() != forward[0] );
+    host::random other(43);
+    rng = other.stream(sequence, 0);
+    BOOST_CHECK( rng() != forward[0] );
+
+    // reseeding reproduces the streams
+    other.seed(42);
+    rng = other.stream(sequence, 0);
+    BOOST_CHECK_EQUAL( rng(), forward[0] );
+}
+
+/**
+ * The uniform variates lie in the interval (0, 1].
+ */
+BOOST_AUTO_TEST_CASE( uniform )
+{
+    using namespace philox_kernel;
+    BOOST_CHECK_EQUAL( uniform_float(0), 1.f / 16777216 );
+    BOOST_CHECK_EQUAL( uniform_float(0xffffffff), 1.f );
+    BOOST_CHECK_EQUAL( uniform_double(0, 0), 1. / 9007199254740992. );
+    BOOST_CHECK_EQUAL( uniform_double(0xffffffff, 0xffffffff), 1. );
+
+    // the host variates use the transforms of the GPU kernels
+    host::random random(42);
+    host::philox rng = random.stream(0, 0), ref = random.stream(0, 0);
+    for (unsigned int i = 0; i < 100; ++i) {
+        BOOST_CHECK_EQUAL( host::uniform<float>(rng), uniform_float(ref()) );
+        unsigned int hi = ref();
+        BOOST_CHECK_EQUAL( host::uniform<double>(rng), uniform_double(hi, ref()) );
+    }
+}
@@ -21,9 +21,15 @@
 #define BOOST_TEST_MODULE profiler
 #include <boost/test/unit_test.hpp>
 
+#include <fstream>
+#include <map>
 #include <memory>
+#include <string>
+#include <thread>
 
 #include <halmd/utility/profiler.hpp>
+#include <halmd/utility/thread_pool.hpp>
+#include <halmd/utility/trace.hpp>
 #include <test/tools/ctest.hpp>
 
 using namespace boost;
@@ -73,3 +79,153 @@ BOOST_AUTO_TEST_CASE( test_profiler )
 
     // FIXME add some tests here (e.g. line counting of log file)
 }
+
+/**
+ * time nested scopes of given depth
+ */
+static void nested_scopes(std::vector<std::shared_ptr<timer_map::accumulator_type>> const& acc, unsigned int depth)
+{
+    utility::profiler::scoped_timer_type timer(*acc[depth]);
+    if (depth + 1 < acc.size()) {
+        nested_scopes(acc, depth + 1);
+        nested_scopes(acc, depth + 1);
+    }
+}
+
+//
+// test tracing of timed scopes
+//
+
+BOOST_AUTO_TEST_CASE( test_trace )
+{
+    auto profiler = std::make_shared<utility::profiler>();
+    std::vector<std::shared_ptr<timer_map::accumulator_type>> acc;
+    for (std::string desc : {"outer", "middle", "inner"}) {
+        acc.push_back(std::make_shared<timer_map::accumulator_type>());
+        profiler->on_profile(acc.back(), desc);
+    }
+    profiler->set_trace_capacity(64);
+    BOOST_CHECK_EQUAL( profiler->trace_capacity(), 64u );
+
+    // tracing is disabled by default
+    BOOST_CHECK( !profiler->tracing() );
+    nested_scopes(acc, 0);
+    for (auto const& thread : utility::trace::events()) {
+        BOOST_CHECK( thread.empty() );
+    }
+
+    profiler->set_tracing(true);
+    BOOST_CHECK_THROW( profiler->set_trace_capacity(16), std::logic_error );
+    nested_scopes(acc, 0);
+    std::thread([&]() { nested_scopes(acc, 1); }).join();
+    profiler->set_tracing(false);
+
+    // 1 + 2 + 4 scopes in main thread, 1 + 2 scopes in other thread
+    std::map<unsigned int, unsigned int> depth;
+    unsigned int nevent = 0;
+    for (auto const& thread : utility::trace::events()) {
+        for (utility::trace::event const& ev : thread) {
+            BOOST_CHECK( ev.begin <= ev.end );
+            ++depth[ev.depth];
+            ++nevent;
+        }
+    }
+    BOOST_CHECK_EQUAL( nevent, 10u );
+    BOOST_CHECK_EQUAL( depth[0], 2u );
+    BOOST_CHECK_EQUAL( depth[1], 4u );
+    BOOST_CHECK_EQUAL( depth[2], 4u );
+    BOOST_CHECK_EQUAL( count(*acc[2]), 10u );
+
+    profiler->write_trace("test_unit_utility_profiler.json");
+    std::ifstream trace("test_unit_utility_profiler.json");
+    std::string line;
+    unsigned int nline = 0;
+    while (std::getline(trace, line)) {
+        if (line.find("\"ph\":\"X\"") != std::string::npos) {
+            ++nline;
+        }
+    }
+    BOOST_CHECK_EQUAL( nline, 10u );
+
+    profiler->write_flame_graph("test_unit_utility_profiler.folded");
+    std::ifstream folded("test_unit_utility_profiler.folded");
+    std::vector<std::string> stacks;
+    while (std::getline(folded, line)) {
+        stacks.push_back(line.substr(0, line.rfind(' ')));
+    }
+    std::vector<std::string> expected = {
+        "middle", "middle;inner", "outer", "outer;middle", "outer;middle;inner"
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS( stacks.begin(), stacks.end(), expected.begin(), expected.end() );
+
+    // ring buffer keeps most recent events
+    profiler->clear_trace();
+    profiler->set_trace_capacity(3);
+    profiler->set_tracing(true);
+    nested_scopes(acc, 0);
+    profiler->set_tracing(false);
+    nevent = 0;
+    for (auto const& thread : utility::trace::events()) {
+        nevent += thread.size();
+    }
+    BOOST_CHECK_EQUAL( nevent, 3u );
+}
+
+//
+// test counting of hardware events, if available
+//
+
+BOOST_AUTO_TEST_CASE( test_hardware_counters )
+{
+    auto profiler = std::make_shared<utility::profiler>();
+    auto acc = std::make_shared<timer_map::accumulator_type>();
+    profiler->on_profile(acc, "loop");
+
+    BOOST_CHECK( !profiler->hardware_counters() );
+    profiler->set_hardware_counters(true);
+    bool available = profiler->hardware_counters();
+    BOOST_TEST_MESSAGE("hardware counters available: " << std::boolalpha << available);
+
+    volatile double sum = 0;
+    for (unsigned int i = 0; i < 10; ++i) {
+        utility::profiler::scoped_timer_type timer(*acc);
+        for (unsigned int j = 0; j < 100000; ++j) {
+            sum = sum + j;
+        }
+    }
+    profiler->set_hardware_counters(false);
+    BOOST_CHECK( !profiler->hardware_counters() );
+
+    utility::profiler::counts_type counts = profiler->counts(acc);
+    if (available) {
+        BOOST_CHECK_GT( counts.instructions, 1e6 );
+        BOOST_CHECK_GT( counts.ipc(), 0 );
+    }
+    else {
+        BOOST_CHECK_EQUAL( counts.instructions, 0 );
+    }
+    BOOST_CHECK_EQUAL( count(*acc), 10u );
+
+    // profile() resets counts
+    profiler->profile();
+    BOOST_CHECK_EQUAL( profiler->counts(acc).instructions, 0 );
+
+    // events of the pool threads are counted in the scope of the calling thread
+    utility::thread_pool pool(4);
+    profiler->set_hardware_counters(true);
+    for (unsigned int i = 0; i < 10; ++i) {
+        utility::profiler::scoped_timer_type timer(*acc);
+        pool.parallel_for(0, 4, [&](unsigned int thread, std::size_t, std::size_t) {
+            if (thread > 0) {
+                volatile double sum = 0;
+                for (unsigned int j = 0; j < 100000; ++j) {
+                    sum = sum + j;
+                }
+            }
+        });
+    }
+    profiler->set_hardware_counters(false);
+    if (available) {
+        BOOST_CHECK_GT( profiler->counts(acc).instructions, 1e6 );
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE task_queue
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <halmd/utility/task_queue.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+
+/**
+ * test that tasks are executed in the order of submission
+ */
+BOOST_AUTO_TEST_CASE( order )
+{
+    for (unsigned int capacity : {1, 2, 16}) {
+        BOOST_TEST_MESSAGE("capacity: " << capacity);
+        std::vector<unsigned int> result;
+        {
+            utility::task_queue queue(capacity);
+            BOOST_CHECK_EQUAL( queue.capacity(), capacity );
+            for (unsigned int i = 0; i < 100; ++i) {
+                queue.submit([&, i]() { result.push_back(i); });
+            }
+            queue.wait();
+            BOOST_CHECK_EQUAL( result.size(), 100u );
+            for (unsigned int i = 0; i < 100; ++i) {
+                queue.submit([&, i]() { result.push_back(100 + i); });
+            }
+            // destructor completes pending tasks
+        }
+        BOOST_REQUIRE_EQUAL( result.size(), 200u );
+        for (unsigned int i = 0; i < result.size(); ++i) {
+            BOOST_CHECK_EQUAL( result[i], i );
+        }
+    }
+}
+
+/**
+ * test that the number of pending tasks is bounded by the capacity
+ */
+BOOST_AUTO_TEST_CASE( capacity )
+{
+    unsigned int const capacity = 3;
+    utility::task_queue queue(capacity);
+    std::atomic<unsigned int> submitted(0);
+    std::atomic<unsigned int> completed(0);
+    std::atomic<bool> overflow(false);
+    for (unsigned int i = 0; i < 20; ++i) {
+        queue.submit([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            // the running task counts as pending
+            if (submitted - completed > capacity) {
+                overflow = true;
+            }
+            ++completed;
+        });
+        ++submitted;
+    }
+    queue.wait();
+    BOOST_CHECK_EQUAL( completed, 20u );
+    BOOST_CHECK( !overflow );
+
+    BOOST_CHECK_THROW( utility::task_queue(0), std::invalid_argument );
+}
+
+/**
+ * test that an exception of a task is rethrown in the submitting thread
+ */
+BOOST_AUTO_TEST_CASE( exception )
+{
+    utility::task_queue queue(4);
+    std::atomic<unsigned int> count(0);
+    queue.submit([&]() { ++count; });
+    queue.submit([&]() { throw std::runtime_error("task failed"); });
+    BOOST_CHECK_THROW( queue.wait(), std::runtime_error );
+    BOOST_CHECK_EQUAL( count, 1u );
+
+    // the queue remains usable
+    queue.submit([&]() { ++count; });
+    queue.wait();
+    BOOST_CHECK_EQUAL( count, 2u );
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright © 2026 The HALMD developers
+ *
+ * This file is part of HALMD.
+ *
+ * HALMD is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE thread_pool
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <halmd/utility/thread_pool.hpp>
+#include <test/tools/ctest.hpp>
+
+using namespace halmd;
+
+/**
+ * test that parallel_for visits each index exactly once
+ */
+BOOST_AUTO_TEST_CASE( parallel_for )
+{
+    for (unsigned int nthread : {1, 2, 3, 8}) {
+        BOOST_TEST_MESSAGE("number of threads: " << nthread);
+        utility::thread_pool pool(nthread);
+        BOOST_CHECK_EQUAL( pool.size(), nthread );
+
+        for (std::size_t size : {0, 1, 7, 1000, 12345}) {
+            std::vector<unsigned int> count(size, 0);
+            std::vector<unsigned int> owner(size, -1U);
+            pool.parallel_for(0, size, [&](unsigned int thread, std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; ++i) {
+                    ++count[i];
+                    owner[i] = thread;
+                }
+            });
+            BOOST_CHECK_EQUAL( std::accumulate(count.begin(), count.end(), 0u), size );
+            BOOST_CHECK( std::all_of(count.begin(), count.end(), [](unsigned int c) { return c == 1; }) );
+
+            // blocks are contiguous and ordered by thread index
+            BOOST_CHECK( std::is_sorted(owner.begin(), owner.end()) );
+        }
+    }
+}
+
+/**
+ * test that each thread runs the task once, including nested invocations
+ */
+BOOST_AUTO_TEST_CASE( run )
+{
+    utility::thread_pool pool(4);
+    for (unsigned int n = 0; n < 100; ++n) {
+        std::atomic<unsigned int> outer(0);
+        std::atomic<unsigned int> inner(0);
+        pool.run([&](unsigned int) {
+            ++outer;
+            // nested tasks are processed serially by the calling thread
+            pool.run([&](unsigned int) { ++inner; });
+        });
+        BOOST_CHECK_EQUAL( outer, 4u );
+        BOOST_CHECK_EQUAL( inner, 16u );
+    }
+
+    pool.resize(6);
+    BOOST_CHECK_EQUAL( pool.size(), 6u );
+    std::atomic<unsigned int> count(0);
+    pool.run([&](unsigned int) { ++count; });
+    BOOST_CHECK_EQUAL( count, 6u );
+
+    pool.resize(0);
+    BOOST_CHECK( pool.size() >= 1 );
+}
+
+/**
+ * test that exceptions are propagated to the calling thread
+ */
+BOOST_AUTO_TEST_CASE( exception )
+{
+    utility::thread_pool pool(3);
+    BOOST_CHECK_THROW(
+        pool.run([](unsigned int thread) {
+            if (thread == 2) {
+                throw std::runtime_error("failure in worker thread");
+            }
+        })
+      , std::runtime_error
+    );
+    // the pool is still usable
+    std::atomic<unsigned int> count(0);
+    pool.run([&](unsigned int) { ++count; });
+    BOOST_CHECK_EQUAL( count, 3u );
+}